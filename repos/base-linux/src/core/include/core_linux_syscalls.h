@@ -48,6 +48,37 @@ inline int lx_unlink(const char *fname)
 }
 
 
+/* flags of 'memfd_create' and file seals, defined here to not depend on glibc */
+enum {
+	LX_MFD_CLOEXEC       = 0x1,
+	LX_MFD_ALLOW_SEALING = 0x2,
+	LX_MFD_HUGETLB       = 0x4,
+
+	LX_F_ADD_SEALS   = 1033,
+	LX_F_SEAL_SEAL   = 0x1,
+	LX_F_SEAL_SHRINK = 0x2,
+	LX_F_SEAL_GROW   = 0x4,
+};
+
+
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+	return (int)lx_syscall(SYS_memfd_create, name, flags);
+}
+
+
+inline int lx_add_seals(int fd, unsigned seals)
+{
+	return (int)lx_syscall(SYS_fcntl, fd, LX_F_ADD_SEALS, seals);
+}
+
+
+inline int lx_fallocate(int fd, unsigned long length)
+{
+	return (int)lx_syscall(SYS_fallocate, fd, 0, 0UL, length);
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
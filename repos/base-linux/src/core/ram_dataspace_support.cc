@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2006-2017 Genode Labs GmbH
+ * Copyright (C) 2006-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -14,6 +14,9 @@
 /* glibc includes */
 #include <fcntl.h>
 
+/* Genode includes */
+#include <util/arg_string.h>
+
 /* local includes */
 #include <ram_dataspace_factory.h>
 #include <resource_path.h>
@@ -30,17 +33,95 @@ using namespace Core;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
-void Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
+
+/**
+ * List of Unix environment variables, initialized by the startup code
+ */
+extern char **lx_environ;
+
+
+/**
+ * Return minimum size of dataspaces backed by explicit huge pages
+ *
+ * Huge pages are opt-in by setting the 'GENODE_HUGETLB_MIN_SIZE' environment
+ * variable of core, e.g., to '4M'. The huge pages must be reserved at the
+ * host beforehand via '/proc/sys/vm/nr_hugepages'. A value of zero disables
+ * the use of huge pages.
+ */
+static size_t hugetlb_min_size()
+{
+	for (char **curr = lx_environ; curr && *curr; curr++) {
+
+		Arg arg = Arg_string::find_arg(*curr, "GENODE_HUGETLB_MIN_SIZE");
+		if (arg.valid())
+			return arg.ulong_value(0);
+	}
+
+	return 0;
+}
+
+
+/**
+ * Create anonymous memory file backed by huge pages
+ *
+ * Mappings of such a file must be aligned to the huge-page size. Hence,
+ * only dataspaces of a multiple of the huge-page size are eligible.
+ * Since huge pages are not overcommitted, the pages are allocated up front.
+ * Should the host lack reserved huge pages, the allocation fails here
+ * instead of raising a SIGBUS at the first access by the component.
+ *
+ * \return  file descriptor, or a negative value if huge pages are unavailable
+ */
+static int create_hugetlb_file(char const *name, size_t size)
+{
+	static size_t const min_size = hugetlb_min_size();
+
+	enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+	if (!min_size || size < min_size || (size & (HUGE_PAGE_SIZE - 1)))
+		return -1;
+
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC | LX_MFD_HUGETLB
+	                                   | LX_MFD_ALLOW_SEALING);
+	if (fd < 0)
+		return fd;
+
+	if (lx_ftruncate(fd, size) < 0 || lx_fallocate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Create anonymous memory file of the given size
+ */
+static int create_memfd(char const *name, size_t size)
+{
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING);
+	if (fd < 0)
+		return fd;
+
+	if (lx_ftruncate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Create file in the resource path, used if 'memfd_create' is not supported
+ */
+static int create_unlinked_file(size_t size)
 {
-	Linux_dataspace::Filename const fname(resource_path(), "/ds-", ram_ds_cnt++);
+	Linux_dataspace::Filename const fname(resource_path(), "/ds-", ram_ds_cnt);
 
 	/* create file using a unique file name in the resource path */
 	lx_unlink(fname.string());
 	int const fd = lx_open(fname.string(), O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds.size());
-
-	/* remember file descriptor in dataspace component object */
-	ds.fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -49,6 +130,37 @@ void Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname.string());
+
+	return fd;
+}
+
+
+void Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
+{
+	/* the name appears in '/proc/<pid>/maps' of the components */
+	String<16> const name("ds-", ram_ds_cnt);
+
+	int fd = create_hugetlb_file(name.string(), ds.size());
+
+	if (fd < 0)
+		fd = create_memfd(name.string(), ds.size());
+
+	if (fd < 0) {
+		fd = create_unlinked_file(ds.size());
+	} else {
+
+		/*
+		 * Seal the size of the file. Otherwise, a component that obtained the
+		 * file descriptor could truncate the file and thereby provoke a
+		 * SIGBUS in all other components that access the dataspace.
+		 */
+		lx_add_seals(fd, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL);
+	}
+
+	ram_ds_cnt++;
+
+	/* remember file descriptor in dataspace component object */
+	ds.fd(fd);
 }
 
 
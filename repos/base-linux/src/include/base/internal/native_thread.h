@@ -108,6 +108,65 @@ class Genode::Native_thread
 
 		} epoll { };
 
+		/**
+		 * Socket pair used by the thread to receive RPC replies
+		 *
+		 * The channel is created at the first RPC call of the thread and
+		 * reused by all subsequent calls. Each server called keeps the
+		 * remote end of the channel and may send messages to it at any
+		 * time. Therefore, each call carries a new token, which the server
+		 * echoes in its reply. Messages with another token are dropped.
+		 */
+		class Reply_channel
+		{
+			private:
+
+				Lx_sd _local  { -1 };
+				Lx_sd _remote { -1 };
+
+				unsigned long _token = 0;
+
+				/*
+				 * Noncopyable
+				 */
+				Reply_channel(Reply_channel const &);
+				Reply_channel &operator = (Reply_channel const &);
+
+			public:
+
+				constexpr Reply_channel() { }
+
+				~Reply_channel()
+				{
+					if (_local.valid())  lx_close(_local.value);
+					if (_remote.valid()) lx_close(_remote.value);
+
+					_local = _remote = Lx_sd::invalid();
+				}
+
+				/**
+				 * Create socket pair if not done yet
+				 */
+				void construct_once()
+				{
+					if (_local.valid())
+						return;
+
+					Lx_socketpair const sockets { };
+					_local  = sockets.local;
+					_remote = sockets.remote;
+				}
+
+				Lx_sd local()  const { return _local; }
+				Lx_sd remote() const { return _remote; }
+
+				/**
+				 * Return token for the next call
+				 */
+				unsigned long next_token() { return ++_token; }
+
+		} reply_channel { };
+
 		Native_thread() { }
 };
 
@@ -70,17 +70,33 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		                      addr_t local_addr,
 		                      size_t size);
 
+		/**
+		 * Local mapping of a dataspace
+		 */
+		struct Mapping
+		{
+			addr_t addr;  /* local address of the requested offset */
+			size_t lead;  /* bytes mapped in front of 'addr' */
+			size_t size;  /* size of the entire mapping */
+		};
+
 		/**
 		 * Map dataspace into local address space
+		 *
+		 * A dataspace backed by huge pages is mapped in units of huge
+		 * pages. If the local address is given, the address, 'offset', and
+		 * 'size' must be aligned to the huge-page size.
+		 *
+		 * 	hrow Region_conflict
 		 */
-		void *_map_local(Dataspace_capability ds,
-		                 size_t               size,
-		                 addr_t               offset,
-		                 bool                 use_local_addr,
-		                 addr_t               local_addr,
-		                 bool                 executable,
-		                 bool                 overmap,
-		                 bool                 writeable);
+		Mapping _map_local(Dataspace_capability ds,
+		                   size_t               size,
+		                   addr_t               offset,
+		                   bool                 use_local_addr,
+		                   addr_t               local_addr,
+		                   bool                 executable,
+		                   bool                 overmap,
+		                   bool                 writeable);
 
 		/**
 		 * Determine size of dataspace
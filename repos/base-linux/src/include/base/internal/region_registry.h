@@ -32,6 +32,13 @@ class Genode::Region
 		Dataspace_capability _ds     {   };
 		size_t               _size   { 0 };
 
+		/*
+		 * Mapping that contains the region, which is larger than the
+		 * region if the dataspace is backed by huge pages
+		 */
+		size_t               _lead     { 0 };  /* mapped bytes before '_start' */
+		size_t               _map_size { 0 };
+
 		/**
 		 * Return offset of first byte after the region
 		 */
@@ -42,13 +49,22 @@ class Genode::Region
 		Region() { }
 
 		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size)
-		: _start(start), _offset(offset), _ds(ds), _size(size) { }
+		: _start(start), _offset(offset), _ds(ds), _size(size), _map_size(size) { }
+
+		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size,
+		       size_t lead, size_t map_size)
+		:
+			_start(start), _offset(offset), _ds(ds), _size(size),
+			_lead(lead), _map_size(map_size)
+		{ }
 
 		bool                 used()      const { return _size > 0; }
 		addr_t               start()     const { return _start; }
 		off_t                offset()    const { return _offset; }
 		size_t               size()      const { return _size; }
 		Dataspace_capability dataspace() const { return _ds; }
+		addr_t               map_start() const { return _start - _lead; }
+		size_t               map_size()  const { return _map_size; }
 
 		bool intersects(Region const &r) const
 		{
@@ -34,6 +34,12 @@ struct Genode::Rpc_destination
 	 */
 	bool foreign = true;
 
+	/*
+	 * Token of the call to be answered via a reply capability, which
+	 * allows the caller to tell the reply apart from stale or forged ones
+	 */
+	unsigned long reply_token = 0;
+
 	Rpc_destination(Lx_sd socket) : socket(socket) { }
 
 	bool valid() const { return socket.valid(); }
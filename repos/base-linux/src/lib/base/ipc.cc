@@ -55,6 +55,8 @@ namespace {
  *   long  exception code
  *   ...call results...
  *
+ * Both messages carry the token of the call in their 'Protocol_header'.
+ *
  * First data word of message, used to transfer the exception code (when the
  * server replies). This data word is never fetched from memory but
  * transferred via the first short-IPC register. The 'protocol_word' is needed
@@ -71,6 +73,9 @@ struct Protocol_header
 	/* badges of the transferred capability arguments */
 	unsigned long badges[Msgbuf_base::MAX_CAPS_PER_MSG];
 
+	/* token of the call, echoed by the reply */
+	unsigned long reply_token;
+
 	enum { INVALID_BADGE = ~1UL };
 
 	void *msg_start() { return &protocol_word; }
@@ -254,13 +259,15 @@ static void extract_sds_from_message(unsigned start_index,
 /**
  * Send reply to client
  */
-static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_code,
+static inline void lx_reply(Rpc_destination reply_dst, Rpc_exception_code exception_code,
                             Genode::Msgbuf_base &snd_msgbuf)
 {
+	Lx_sd const reply_socket = reply_dst.socket;
 
 	Protocol_header &header = snd_msgbuf.header<Protocol_header>();
 
 	header.protocol_word = exception_code.value;
+	header.reply_token   = reply_dst.reply_token;
 
 	Message msg(header.msg_start(), sizeof(Protocol_header) + snd_msgbuf.data_size());
 
@@ -283,6 +290,31 @@ static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_cod
  ** IPC client **
  ****************/
 
+/*
+ * Reply channel of the main thread, which is the only thread without a
+ * 'Thread' object
+ *
+ * The channel is constant-initialized, which makes it usable before the
+ * static constructors are executed.
+ */
+static Native_thread::Reply_channel main_reply_channel;
+
+
+/**
+ * Return reply channel of the calling thread
+ */
+static Native_thread::Reply_channel &my_reply_channel()
+{
+	Thread * const myself_ptr = Thread::myself();
+
+	Native_thread::Reply_channel &channel = myself_ptr
+	                                      ? myself_ptr->native_thread().reply_channel
+	                                      : main_reply_channel;
+	channel.construct_once();
+	return channel;
+}
+
+
 Rpc_exception_code Genode::ipc_call(Native_capability dst,
                                     Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
                                     size_t)
@@ -292,30 +324,21 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 		sleep_forever();
 	}
 
+	Native_thread::Reply_channel &reply_channel = my_reply_channel();
+
+	unsigned long const token = reply_channel.next_token();
+
 	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
 	snd_header.protocol_word = 0;
+	snd_header.reply_token   = token;
 
 	Message snd_msg(snd_header.msg_start(),
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel : Lx_socketpair
-	{
-		~Reply_channel()
-		{
-			if (local.value  != -1) lx_close(local.value);
-			if (remote.value != -1) lx_close(remote.value);
-		}
-	} reply_channel;
-
 	/* assemble message */
 
 	/* marshal reply capability */
-	snd_msg.marshal_socket(reply_channel.remote);
+	snd_msg.marshal_socket(reply_channel.remote());
 
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
@@ -331,32 +354,44 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 
 	/* receive reply */
 	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
-	rcv_header.protocol_word = 0;
 
-	Message rcv_msg(rcv_header.msg_start(),
-	                sizeof(Protocol_header) + rcv_msgbuf.capacity());
-	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+	for (;;) {
 
-	rcv_msgbuf.reset();
+		rcv_header.protocol_word = 0;
+		rcv_header.reply_token   = 0;
 
-	for (;;) {
-		int const recv_ret = lx_recvmsg(reply_channel.local, rcv_msg.msg(), 0);
+		Message rcv_msg(rcv_header.msg_start(),
+		                sizeof(Protocol_header) + rcv_msgbuf.capacity());
+		rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+		rcv_msgbuf.reset();
+
+		int const recv_ret = lx_recvmsg(reply_channel.local(), rcv_msg.msg(), 0);
 
 		/* system call got interrupted by a signal */
 		if (recv_ret == -LX_EINTR)
 			continue;
 
-		if (recv_ret >= 0)
-			break;
+		if (recv_ret < 0) {
+			error(lx_getpid(), ":", lx_gettid(),
+			      " ipc_call failed to receive result (", recv_ret, ")");
+			sleep_forever();
+		}
 
-		error(lx_getpid(), ":", lx_gettid(),
-		      " ipc_call failed to receive result (", recv_ret, ")");
-		sleep_forever();
-	}
+		/* drop message not sent in reply to this call */
+		if ((size_t)recv_ret < sizeof(Protocol_header)
+		 || rcv_header.reply_token != token) {
+
+			for (unsigned i = 0; i < rcv_msg.num_sockets(); i++)
+				lx_close(rcv_msg.socket_at_index(i).value);
 
-	extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
+			continue;
+		}
 
-	return Rpc_exception_code((int)rcv_header.protocol_word);
+		extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
+
+		return Rpc_exception_code((int)rcv_header.protocol_word);
+	}
 }
 
 
@@ -367,9 +402,9 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 void Genode::ipc_reply(Native_capability caller, Rpc_exception_code exc,
                        Msgbuf_base &snd_msg)
 {
-	Lx_sd const reply_socket = Capability_space::ipc_cap_data(caller).dst.socket;
+	Rpc_destination const reply_dst = Capability_space::ipc_cap_data(caller).dst;
 
-	try { lx_reply(reply_socket, exc, snd_msg); } catch (Ipc_error) { }
+	try { lx_reply(reply_dst, exc, snd_msg); } catch (Ipc_error) { }
 }
 
 
@@ -380,7 +415,7 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 {
 	/* when first called, there was no request yet */
 	if (last_caller.valid() && exc.value != Rpc_exception_code::INVALID_OBJECT)
-		lx_reply(Capability_space::ipc_cap_data(last_caller).dst.socket, exc, reply_msg);
+		lx_reply(Capability_space::ipc_cap_data(last_caller).dst, exc, reply_msg);
 
 	/*
 	 * Block infinitely if called from the main thread. This may happen if the
@@ -414,13 +449,14 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 			continue;
 		}
 
-		Lx_sd const reply_socket = msg.socket_at_index(0);
+		Rpc_destination reply_dst(msg.socket_at_index(0));
+		reply_dst.reply_token = header.reply_token;
 
 		/* start at offset 1 to skip the reply channel */
 		extract_sds_from_message(1, msg, header, request_msg);
 
-		return Rpc_request(Capability_space::import(Rpc_destination(reply_socket),
-		                                            Rpc_obj_key()), selected_sd.value);
+		return Rpc_request(Capability_space::import(reply_dst, Rpc_obj_key()),
+		                   selected_sd.value);
 	}
 }
 
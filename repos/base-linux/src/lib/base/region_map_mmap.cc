@@ -39,6 +39,7 @@
 #include <stdlib.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #pragma GCC diagnostic pop  /* restore -Wconversion warnings */
 
 /* Genode includes */
@@ -120,14 +121,41 @@ addr_t Region_map_mmap::_reserve_local(bool           use_local_addr,
 }
 
 
-void *Region_map_mmap::_map_local(Dataspace_capability ds,
-                                  Genode::size_t       size,
-                                  addr_t               offset,
-                                  bool                 use_local_addr,
-                                  addr_t               local_addr,
-                                  bool                 executable,
-                                  bool                 overmap,
-                                  bool                 writeable)
+/**
+ * Return size of the pages backing the file
+ *
+ * A file backed by huge pages, e.g., a RAM dataspace created by core with
+ * 'GENODE_HUGETLB_MIN_SIZE' set, can be mapped and unmapped only in units
+ * of huge pages.
+ */
+static size_t page_size_of_file(int fd)
+{
+#ifdef __NR_fstat64
+	struct stat64 statbuf { };
+	long const ret = lx_syscall(SYS_fstat64, fd, &statbuf);
+#else
+	struct stat statbuf { };
+	long const ret = lx_syscall(SYS_fstat, fd, &statbuf);
+#endif /* __NR_fstat64 */
+
+	size_t const page_size = 1UL << 12;
+
+	if (ret < 0 || (size_t)statbuf.st_blksize <= page_size)
+		return page_size;
+
+	return (size_t)statbuf.st_blksize;
+}
+
+
+Region_map_mmap::Mapping
+Region_map_mmap::_map_local(Dataspace_capability ds,
+                            Genode::size_t       size,
+                            addr_t               offset,
+                            bool                 use_local_addr,
+                            addr_t               local_addr,
+                            bool                 executable,
+                            bool                 overmap,
+                            bool                 writeable)
 {
 	writeable = _dataspace_writeable(ds) && writeable;
 
@@ -136,8 +164,30 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 	int  const  prot      = PROT_READ
 	                      | (writeable  ? PROT_WRITE : 0)
 	                      | (executable ? PROT_EXEC  : 0);
+
+	/*
+	 * Map a dataspace backed by huge pages in units of huge pages. If the
+	 * address is chosen by the kernel, the mapping covers the huge pages
+	 * that contain the requested range. A given address cannot be rounded
+	 * without affecting neighboring regions, so the request is rejected
+	 * before touching the address space.
+	 */
+	size_t const page_mask = page_size_of_file(fd) - 1;
+
+	size_t const lead     = offset & page_mask;
+	size_t const map_size = (lead + size + page_mask) & ~page_mask;
+
+	if (use_local_addr && (lead || map_size != size || (local_addr & page_mask))) {
+		lx_close(fd);
+		error("_map_local: dataspace backed by huge pages cannot be attached "
+		      "at unaligned address ", Hex(local_addr), ", offset ", Hex(offset),
+		      ", or size ", Hex(size));
+		throw Region_conflict();
+	}
+
 	void * const addr_in  = use_local_addr ? (void*)local_addr : 0;
-	void * const addr_out = lx_mmap(addr_in, size, prot, flags, fd, offset);
+	void * const addr_out = lx_mmap(addr_in, map_size, prot, flags, fd,
+	                                (off_t)(offset - lead));
 
 	/*
 	 * We can close the file after calling mmap. The Linux kernel will still
@@ -149,7 +199,7 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 
 	/* attach at local address failed - unmap incorrect mapping */
 	if (use_local_addr && addr_in != addr_out)
-		lx_munmap((void *)addr_out, size);
+		lx_munmap((void *)addr_out, map_size);
 
 	if ((use_local_addr && addr_in != addr_out)
 	 || (((long)addr_out < 0) && ((long)addr_out > -4095))) {
@@ -159,7 +209,7 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 		throw Region_map::Region_conflict();
 	}
 
-	return addr_out;
+	return { .addr = (addr_t)addr_out + lead, .lead = lead, .size = map_size };
 }
 
 
@@ -265,8 +315,16 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		 * and map it. We have to enforce the mapping via the 'overmap'
 		 * argument as the region was reserved by a PROT_NONE mapping.
 		 */
-		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable, true, writeable);
+		if (_is_attached()) {
+			try {
+				_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr,
+				           executable, true, writeable);
+			}
+			catch (Region_conflict) {
+				_rmap.remove_region(local_addr);
+				throw;
+			}
+		}
 
 		return (void *)local_addr;
 
@@ -330,12 +388,13 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			 * Boring, a plain dataspace is attached to a root RM session.
 			 * Note, we do not overmap.
 			 */
-			void *addr = _map_local(ds, region_size, offset, use_local_addr,
-			                        local_addr, executable, false, writeable);
+			Mapping const mapping = _map_local(ds, region_size, offset, use_local_addr,
+			                                   local_addr, executable, false, writeable);
 
-			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
+			_add_to_rmap(Region(mapping.addr, offset, ds, region_size,
+			                    mapping.lead, mapping.size));
 
-			return addr;
+			return mapping.addr;
 		}
 	}
 }
@@ -392,7 +451,7 @@ void Region_map_mmap::detach(Region_map::Local_addr local_addr)
 		 * sub RM session. In both cases, we simply mark the local address
 		 * range as free.
 		 */
-		lx_munmap(local_addr, region.size());
+		lx_munmap((void *)region.map_start(), region.map_size());
 	}
 
 	/*
@@ -553,6 +553,8 @@ Thread::~Thread()
 
 	_native_thread = nullptr;
 
+	_notify_destruct_observers();
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
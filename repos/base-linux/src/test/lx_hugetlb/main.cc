@@ -0,0 +1,97 @@
+/*
+ * \brief  Test for attaching sub ranges of huge-page backed dataspaces
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	Env &_env;
+
+	enum { DS_SIZE = 4*1024*1024, PAGE_SIZE = 4096 };
+
+	Ram_dataspace_capability _ds = _env.ram().alloc(DS_SIZE);
+
+	static unsigned _pattern(addr_t offset) { return (unsigned)(offset ^ 0x5a5a5a5a); }
+
+	void _fill()
+	{
+		unsigned * const words = _env.rm().attach(_ds);
+		for (addr_t i = 0; i < DS_SIZE/sizeof(unsigned); i++)
+			words[i] = _pattern(i*sizeof(unsigned));
+		_env.rm().detach(words);
+	}
+
+	/**
+	 * Attach sub range of dataspace and validate its content
+	 *
+	 * After the detach, a small dataspace is attached at the former
+	 * location to check that the whole mapping was removed.
+	 */
+	void _test_sub_range(off_t offset, size_t size)
+	{
+		log("attach offset=", Hex(offset), " size=", Hex(size));
+
+		unsigned * const words = _env.rm().attach(_ds, size, offset);
+
+		if ((addr_t)words & (PAGE_SIZE - 1)) {
+			error("attachment at unaligned address ", words);
+			throw Exception();
+		}
+
+		for (addr_t i = 0; i < size/sizeof(unsigned); i++) {
+			if (words[i] == _pattern(offset + i*sizeof(unsigned)))
+				continue;
+
+			error("unexpected content at offset ", Hex(offset + i*sizeof(unsigned)));
+			throw Exception();
+		}
+
+		/* the attachment must be writeable up to its last word */
+		words[size/sizeof(unsigned) - 1] = _pattern(offset + size - sizeof(unsigned));
+
+		_env.rm().detach(words);
+
+		Ram_dataspace_capability probe_ds = _env.ram().alloc(PAGE_SIZE);
+		try {
+			_env.rm().detach(_env.rm().attach_at(probe_ds, (addr_t)words));
+		} catch (Region_map::Region_conflict) {
+			error("mapping at ", words, " not removed by detach");
+			throw;
+		}
+		_env.ram().free(probe_ds);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_fill();
+
+		_test_sub_range(0,                     DS_SIZE);
+		_test_sub_range(PAGE_SIZE,             2*PAGE_SIZE);
+		_test_sub_range(DS_SIZE/2 + PAGE_SIZE, PAGE_SIZE);
+		_test_sub_range(DS_SIZE/2 - PAGE_SIZE, 2*PAGE_SIZE);
+		_test_sub_range(DS_SIZE/2,             DS_SIZE/2);
+
+		_env.ram().free(_ds);
+
+		log("--- test-lx_hugetlb finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-lx_hugetlb
+SRC_CC = main.cc
+LIBS   = base
@@ -117,6 +117,11 @@ class Genode::Heap : public Allocator
 		 */
 		Alloc_result _unsynchronized_alloc(size_t size);
 
+		/**
+		 * Unsynchronized implementation of 'free'
+		 */
+		void _unsynchronized_free(void *addr);
+
 	public:
 
 		enum { UNLIMITED = ~0 };
@@ -157,6 +162,24 @@ class Genode::Heap : public Allocator
 		}
 
 
+		/**
+		 * Allocate up to 'count' blocks of 'size' bytes each
+		 *
+		 * In contrast to calling 'try_alloc' repeatedly, the heap's mutex
+		 * is acquired only once for all blocks.
+		 *
+		 * \param blocks  array to be filled with the allocated blocks
+		 * \return        number of allocated blocks, which is lower than
+		 *                'count' if the heap ran out of memory or quota
+		 */
+		unsigned try_alloc_batch(size_t size, void **blocks, unsigned count);
+
+		/**
+		 * Free 'count' blocks at once
+		 */
+		void free_batch(void * const *blocks, unsigned count);
+
+
 		/*************************
 		 ** Allocator interface **
 		 *************************/
@@ -20,6 +20,7 @@
 #include <base/trace/logger.h>
 #include <cpu/consts.h>
 #include <util/string.h>
+#include <util/interface.h>
 #include <cpu_session/cpu_session.h>  /* for 'Thread_capability' type */
 
 namespace Genode {
@@ -53,6 +54,28 @@ class Genode::Thread
 		struct Stack_info { addr_t base; addr_t top;
 		                    addr_t libc_tls_pointer_offset; };
 
+		/**
+		 * Interface for getting notified about the destruction of threads
+		 *
+		 * A registered observer must stay valid for the remaining lifetime
+		 * of the component.
+		 */
+		class Destruct_observer : Interface
+		{
+			private:
+
+				friend class Thread;
+
+				Destruct_observer *_next = nullptr;
+
+			public:
+
+				/**
+				 * Called by the destructor of 'thread'
+				 */
+				virtual void thread_destructed(Thread const &thread) = 0;
+		};
+
 	private:
 
 		/**
@@ -161,6 +184,11 @@ class Genode::Thread
 
 		void _init_cpu_session_and_trace_control();
 
+		/**
+		 * Notify all destruct observers about the destruction of the thread
+		 */
+		void _notify_destruct_observers() const;
+
 	public:
 
 		/**
@@ -352,6 +380,11 @@ class Genode::Thread
 		 */
 		static size_t stack_area_virtual_size();
 
+		/**
+		 * Register observer to be notified at the destruction of any thread
+		 */
+		static void register_destruct_observer(Destruct_observer &);
+
 		/**
 		 * Return 'Thread' object corresponding to the calling thread
 		 *
@@ -0,0 +1,277 @@
+/*
+ * \brief  Per-thread cache of small blocks in front of a heap
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__THREAD_LOCAL_HEAP_H_
+#define _INCLUDE__BASE__THREAD_LOCAL_HEAP_H_
+
+#include <base/heap.h>
+#include <base/registry.h>
+#include <base/thread.h>
+#include <util/construct_at.h>
+
+namespace Genode { class Thread_local_heap; }
+
+
+/**
+ * Allocator that caches small blocks of a 'Heap' per thread
+ *
+ * Each thread that uses the allocator gets a cache of free blocks for a
+ * number of power-of-two size classes. Allocations and deallocations served
+ * by the cache of the calling thread do not acquire the heap's mutex. An
+ * empty cache is refilled and a full cache is flushed in batches of blocks,
+ * each taking the heap's mutex only once.
+ *
+ * All blocks, including those held in caches, are allocated at the heap.
+ * Hence, the quota accounting of the heap at its 'Ram_allocator' remains
+ * unaffected by the caching. Blocks cached by a thread are returned to the
+ * heap when the thread calls 'flush', when the thread is destructed, or when
+ * the 'Thread_local_heap' is destructed. The destruction of a thread also
+ * frees its slot for the use by another thread.
+ *
+ * The allocator relies on the size argument of 'free' to determine the size
+ * class of a block. Blocks freed with a size of zero are passed to the heap
+ * directly.
+ */
+class Genode::Thread_local_heap : public Allocator
+{
+	public:
+
+		enum {
+			MIN_SIZE_LOG2    = 4,
+			MAX_SIZE_LOG2    = 11,
+			NUM_SIZE_CLASSES = MAX_SIZE_LOG2 - MIN_SIZE_LOG2 + 1,
+			BATCH            = 16,
+			MAX_THREADS      = 64,
+		};
+
+	private:
+
+		struct Size_class
+		{
+			unsigned  count { 0 };
+			void     *blocks[2*BATCH] { };
+		};
+
+		struct Cache
+		{
+			Size_class size_classes[NUM_SIZE_CLASSES] { };
+		};
+
+		/*
+		 * A slot is assigned to a thread at its first use of the allocator
+		 * and freed at the destruction of the thread, both with
+		 * '_slots_mutex' acquired. A thread looks up its own cache without
+		 * synchronization. This is safe because the 'owner' of a slot
+		 * equals the calling thread only while the slot is assigned to it.
+		 */
+		struct Slot
+		{
+			Thread * volatile owner { nullptr };
+			Cache           *cache { nullptr };
+		};
+
+		Heap  &_heap;
+		Mutex  _slots_mutex { };
+		Slot   _slots[MAX_THREADS] { };
+
+		/**
+		 * Registry of all instances, used for releasing the caches of
+		 * destructed threads
+		 *
+		 * At its first use, the function registers a destruct observer at
+		 * 'Thread', which calls '_release_caches'.
+		 */
+		static Registry<Thread_local_heap> &_registry();
+
+		Registry<Thread_local_heap>::Element _registry_elem { _registry(), *this };
+
+		static size_t _class_size(unsigned size_class) {
+			return 1UL << (size_class + MIN_SIZE_LOG2); }
+
+		static unsigned _size_class(size_t size)
+		{
+			unsigned size_class = 0;
+			while (_class_size(size_class) < size)
+				size_class++;
+			return size_class;
+		}
+
+		static bool _cached_size(size_t size) {
+			return size && size <= (1UL << MAX_SIZE_LOG2); }
+
+		/**
+		 * Return cache of the calling thread, or nullptr if none is available
+		 */
+		Cache *_cache()
+		{
+			Thread * const myself = Thread::myself();
+			if (!myself)
+				return nullptr;
+
+			unsigned const first = (unsigned)(((addr_t)myself >> 4) % MAX_THREADS);
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Slot &slot = _slots[(first + i) % MAX_THREADS];
+				if (slot.owner == myself)
+					return slot.cache;
+			}
+
+			/* first use by the calling thread, assign a free slot */
+			Mutex::Guard guard(_slots_mutex);
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Slot &slot = _slots[(first + i) % MAX_THREADS];
+				if (slot.owner)
+					continue;
+
+				return _heap.try_alloc(sizeof(Cache)).convert<Cache *>(
+					[&] (void *ptr) {
+						slot.cache = construct_at<Cache>(ptr);
+						slot.owner = myself;
+						return slot.cache; },
+					[&] (Alloc_error) { return nullptr; });
+			}
+
+			/* all slots are in use, serve the thread by the heap directly */
+			return nullptr;
+		}
+
+		void _flush(Cache &cache)
+		{
+			for (Size_class &size_class : cache.size_classes) {
+				_heap.free_batch(size_class.blocks, size_class.count);
+				size_class.count = 0;
+			}
+		}
+
+		/**
+		 * Return cache of the slot to the heap and free the slot
+		 *
+		 * Must be called with '_slots_mutex' acquired.
+		 */
+		void _release(Slot &slot)
+		{
+			_flush(*slot.cache);
+			_heap.free(slot.cache, sizeof(Cache));
+			slot.cache = nullptr;
+			slot.owner = nullptr;
+		}
+
+		void _release(Thread const &thread)
+		{
+			Mutex::Guard guard(_slots_mutex);
+
+			for (Slot &slot : _slots)
+				if (slot.owner == &thread)
+					_release(slot);
+		}
+
+		/**
+		 * Return the caches of 'thread' to the heaps and free its slots
+		 */
+		static void _release_caches(Thread const &thread);
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_local_heap(Thread_local_heap const &);
+		Thread_local_heap &operator = (Thread_local_heap const &);
+
+	public:
+
+		Thread_local_heap(Heap &heap) : _heap(heap) { }
+
+		/**
+		 * Destructor
+		 *
+		 * The caches of all threads are returned to the heap. At this point,
+		 * no thread must use the allocator anymore.
+		 */
+		~Thread_local_heap()
+		{
+			Mutex::Guard guard(_slots_mutex);
+
+			for (Slot &slot : _slots)
+				if (slot.owner)
+					_release(slot);
+		}
+
+		/**
+		 * Return the blocks cached for the calling thread to the heap
+		 */
+		void flush()
+		{
+			Cache * const cache = _cache();
+			if (cache)
+				_flush(*cache);
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		Alloc_result try_alloc(size_t size) override
+		{
+			if (!_cached_size(size))
+				return _heap.try_alloc(size);
+
+			unsigned const class_idx = _size_class(size);
+
+			/*
+			 * Even without a cache of the calling thread, the block must
+			 * have the size of its class. It may end up in the cache of
+			 * another thread, which frees it.
+			 */
+			Cache * const cache = _cache();
+			if (!cache)
+				return _heap.try_alloc(_class_size(class_idx));
+
+			Size_class &size_class = cache->size_classes[class_idx];
+
+			if (!size_class.count) {
+				size_class.count = _heap.try_alloc_batch(_class_size(class_idx),
+				                                         size_class.blocks, BATCH);
+				/* let the heap report the reason of the failed allocation */
+				if (!size_class.count)
+					return _heap.try_alloc(_class_size(class_idx));
+			}
+			return size_class.blocks[--size_class.count];
+		}
+
+		void free(void *addr, size_t size) override
+		{
+			Cache * const cache = _cached_size(size) ? _cache() : nullptr;
+			if (!cache) {
+				_heap.free(addr, size);
+				return;
+			}
+
+			Size_class &size_class = cache->size_classes[_size_class(size)];
+
+			/* flush the older half of the cached blocks if the cache is full */
+			if (size_class.count == 2*BATCH) {
+				_heap.free_batch(size_class.blocks, BATCH);
+				memcpy(size_class.blocks, &size_class.blocks[BATCH],
+				       BATCH*sizeof(void *));
+				size_class.count = BATCH;
+			}
+			size_class.blocks[size_class.count++] = addr;
+		}
+
+		size_t consumed()            const override { return _heap.consumed(); }
+		size_t overhead(size_t size) const override { return _heap.overhead(size); }
+		bool   need_size_for_free()  const override { return true; }
+};
+
+#endif /* _INCLUDE__BASE__THREAD_LOCAL_HEAP_H_ */
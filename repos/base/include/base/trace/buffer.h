@@ -85,10 +85,16 @@
  * to use half of the buffer. Care must be taken, however, to eliminate a race
  * between the producer wrapping and the consumer switching to the foreground
  * buffer.
+ *
+ * In addition, the producer maintains a sequence number that counts the bytes
+ * committed to the buffer. By comparing the sequence number with the value
+ * observed when it last drained the buffer, a consumer can determine the fill
+ * level without walking the entries. It can thereby skip idle buffers and
+ * drain each buffer in bulk before it becomes half full.
  */
 
 /*
- * Copyright (C) 2013-2022 Genode Labs GmbH
+ * Copyright (C) 2013-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -337,6 +343,7 @@ class Genode::Trace::Partitioned_buffer
 		unsigned           volatile _wrapped;
 		int                volatile _state;
 		int                volatile _consumer_lock;
+		size_t             volatile _committed_bytes;  /* wraps around */
 
 		size_t         _secondary_offset;
 		Simple_buffer  _primary[0];
@@ -401,6 +408,24 @@ class Genode::Trace::Partitioned_buffer
 		unsigned           wrapped()      const { return _wrapped; }
 		unsigned long long lost_entries() const { return _lost_entries; }
 
+		/**
+		 * Return sequence number counting the bytes committed so far
+		 *
+		 * The number includes the per-entry meta data and wraps around.
+		 */
+		size_t committed_bytes() const { return _committed_bytes; }
+
+		/**
+		 * Return number of bytes available for entries in both partitions
+		 */
+		size_t capacity() const
+		{
+			if (!_secondary_offset)
+				return 0;
+
+			return _primary->_size + _secondary()->_size;
+		}
+
 		Entry first()       const { return _consumer().first(); }
 		bool  initialized() const { return _secondary_offset > 0 && _consumer().initialized(); }
 
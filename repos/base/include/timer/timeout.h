@@ -10,7 +10,7 @@
  */
 
 /*
- * Copyright (C) 2016-2017 Genode Labs GmbH
+ * Copyright (C) 2016-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -85,8 +85,7 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : private Noncopyable
 {
 	friend class Timeout_scheduler;
 
@@ -102,6 +101,15 @@ class Genode::Timeout : private Noncopyable,
 		bool                   _in_discard_blockade { false };
 		Blockade               _discard_blockade    { };
 
+		/*
+		 * Links within the pairing heap of the scheduler. The '_heap_prev'
+		 * pointer refers to the parent if the timeout is the first child,
+		 * or to the previous sibling otherwise.
+		 */
+		Timeout               *_heap_child          { nullptr };
+		Timeout               *_heap_next           { nullptr };
+		Timeout               *_heap_prev           { nullptr };
+
 		Timeout(Timeout const &);
 
 		Timeout &operator = (Timeout const &);
@@ -130,6 +138,11 @@ class Genode::Timeout : private Noncopyable,
 
 /**
  * Multiplexes one time source amongst different timeouts
+ *
+ * The scheduled timeouts are kept in a pairing heap ordered by deadline.
+ * Scheduling a timeout takes constant time, whereas discarding a timeout
+ * or removing the timeout with the earliest deadline takes logarithmic
+ * amortized time.
  */
 class Genode::Timeout_scheduler : private Noncopyable,
                                   public  Timeout_handler
@@ -145,13 +158,19 @@ class Genode::Timeout_scheduler : private Noncopyable,
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
+		Timeout            *_timeouts           { nullptr };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
+		static Timeout *_meld(Timeout *, Timeout *);
+
+		static Timeout *_merge_pairs(Timeout *);
+
+		void _insert_into_timeouts(Timeout &timeout);
+
+		void _remove_from_timeouts(Timeout &timeout);
 
 		void _set_time_source_timeout();
 
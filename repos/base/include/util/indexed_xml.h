@@ -0,0 +1,469 @@
+/*
+ * \brief  XML parser that indexes the node structure in one pass
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__INDEXED_XML_H_
+#define _INCLUDE__UTIL__INDEXED_XML_H_
+
+#include <base/allocator.h>
+#include <util/xml_node.h>
+
+namespace Genode { class Indexed_xml; }
+
+
+/**
+ * Index of the nodes and attributes of an XML document
+ *
+ * In contrast to 'Xml_node', which searches the end tag of a node each time
+ * the node is constructed, 'Indexed_xml' tokenizes the document only once at
+ * construction time and records the structure in tables allocated from the
+ * supplied allocator. Accessing sub nodes and attributes of an indexed node
+ * does not involve any further scanning of the document, which makes the
+ * traversal of large or deeply nested documents linear.
+ *
+ * The index refers to the character buffer of the document, which must
+ * remain valid during the lifetime of the 'Indexed_xml' object.
+ *
+ * Unlike 'Xml_node', which validates each node lazily, the index requires
+ * the whole document to be well formed. A mismatch of any start and end tag
+ * is reported as 'Invalid_syntax' at construction time.
+ */
+class Genode::Indexed_xml
+{
+	public:
+
+		typedef Xml_node::Invalid_syntax Invalid_syntax;
+		typedef Xml_node::Type           Type;
+
+		class Node;
+
+	private:
+
+		typedef Xml_node::Token   Token;
+		typedef Xml_node::Tag     Tag;
+		typedef Xml_node::Comment Comment;
+
+		enum : unsigned { NONE = ~0U };
+
+		struct Entry
+		{
+			char const *start;         /* '<' of the start tag */
+			char const *content;       /* first character after the start tag */
+			char const *end;           /* '<' of the end tag */
+			char const *next;          /* first character after the node */
+			char const *name;
+			size_t      name_len;
+			unsigned    parent;
+			unsigned    first_sub;
+			unsigned    last_sub;
+			unsigned    next_sibling;
+			unsigned    num_sub_nodes;
+			unsigned    first_attr;
+			unsigned    num_attrs;
+			bool        empty;
+		};
+
+		struct Attr
+		{
+			char const *name;
+			size_t      name_len;
+		};
+
+		/**
+		 * Array of plain-old-data elements that grows on demand
+		 */
+		template <typename T>
+		class Table
+		{
+			private:
+
+				Allocator &_alloc;
+				T         *_elem     { nullptr };
+				unsigned   _capacity { 0 };
+				unsigned   _count    { 0 };
+
+				/*
+				 * Noncopyable
+				 */
+				Table(Table const &);
+				Table &operator = (Table const &);
+
+			public:
+
+				Table(Allocator &alloc) : _alloc(alloc) { }
+
+				~Table()
+				{
+					if (_elem)
+						_alloc.free(_elem, _capacity*sizeof(T));
+				}
+
+				/**
+				 * Append element and return its index
+				 *
+				 * \throw Out_of_ram
+				 * \throw Out_of_caps
+				 */
+				unsigned append(T const &elem)
+				{
+					if (_count == _capacity) {
+						unsigned const capacity = max(16U, 2*_capacity);
+						T *new_elem = (T *)_alloc.alloc(capacity*sizeof(T));
+						if (_elem) {
+							memcpy(new_elem, _elem, _count*sizeof(T));
+							_alloc.free(_elem, _capacity*sizeof(T));
+						}
+						_elem     = new_elem;
+						_capacity = capacity;
+					}
+					_elem[_count] = elem;
+					return _count++;
+				}
+
+				T       &operator [] (unsigned i)       { return _elem[i]; }
+				T const &operator [] (unsigned i) const { return _elem[i]; }
+
+				unsigned count() const { return _count; }
+		};
+
+		char const  *_addr;
+		size_t const _max_len;
+		Table<Entry> _nodes;
+		Table<Attr>  _attrs;
+
+		Token _token_at(char const *at) const {
+			return Token(at, _max_len - (at - _addr)); }
+
+		/**
+		 * Record node of the given start tag as last sub node of 'parent'
+		 */
+		unsigned _add_node(Tag const &tag, unsigned parent)
+		{
+			unsigned const first_attr = _attrs.count();
+
+			for (Token t = tag.name().next(); Xml_attribute::_valid(t); ) {
+				Xml_attribute const attr(t);
+				Token const name = attr._tokens.name;
+				_attrs.append(Attr { name.start(), name.len() });
+				t = attr._next_token();
+			}
+
+			char const *content = tag.next_token().start();
+
+			Entry entry { };
+			entry.start         = tag.token().start();
+			entry.content       = content;
+			entry.end           = content;
+			entry.next          = content;
+			entry.name          = tag.name().start();
+			entry.name_len      = tag.name().len();
+			entry.parent        = parent;
+			entry.first_sub     = NONE;
+			entry.last_sub      = NONE;
+			entry.next_sibling  = NONE;
+			entry.num_sub_nodes = 0;
+			entry.first_attr    = first_attr;
+			entry.num_attrs     = _attrs.count() - first_attr;
+			entry.empty         = (tag.type() == Tag::EMPTY);
+
+			unsigned const idx = _nodes.append(entry);
+
+			if (parent != NONE) {
+				Entry &p = _nodes[parent];
+				if (p.last_sub == NONE)
+					p.first_sub = idx;
+				else
+					_nodes[p.last_sub].next_sibling = idx;
+				p.last_sub = idx;
+				p.num_sub_nodes++;
+			}
+			return idx;
+		}
+
+		/**
+		 * Tokenize the document and build the node and attribute tables
+		 *
+		 * \throw Invalid_syntax
+		 */
+		void _scan()
+		{
+			Tag const root(Xml_node::skip_non_tag_characters(_token_at(_addr)));
+			if (!root.node())
+				throw Invalid_syntax();
+
+			unsigned curr = _add_node(root, NONE);
+			if (root.type() == Tag::EMPTY)
+				return;
+
+			Token t = root.next_token();
+			while (curr != NONE) {
+
+				if (t.type() == Token::END)
+					throw Invalid_syntax();
+
+				/* eat XML comment */
+				Comment const comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				/* skip all tokens that are no tags */
+				Tag const tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				t = tag.next_token();
+
+				if (tag.type() == Tag::END) {
+					Entry &e = _nodes[curr];
+					if (e.name_len != tag.name().len()
+					 || strcmp(e.name, tag.name().start(), e.name_len))
+						throw Invalid_syntax();
+
+					e.end  = tag.token().start();
+					e.next = t.start();
+					curr   = e.parent;
+					continue;
+				}
+
+				unsigned const idx = _add_node(tag, curr);
+				if (tag.type() == Tag::START)
+					curr = idx;
+			}
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Indexed_xml(Indexed_xml const &);
+		Indexed_xml &operator = (Indexed_xml const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc    allocator used for the node and attribute tables
+		 * \param addr     start of XML document
+		 * \param max_len  length of XML document in characters
+		 *
+		 * \throw Invalid_syntax
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Indexed_xml(Allocator &alloc, char const *addr, size_t max_len = ~0UL)
+		:
+			_addr(addr), _max_len(max_len), _nodes(alloc), _attrs(alloc)
+		{
+			_scan();
+		}
+
+		/**
+		 * Return top-level node of the document
+		 */
+		inline Node root() const;
+
+		/**
+		 * Return number of nodes of the document
+		 */
+		unsigned num_nodes() const { return _nodes.count(); }
+};
+
+
+/**
+ * Node of an indexed XML document
+ *
+ * The accessors correspond to those of 'Xml_node'.
+ */
+class Genode::Indexed_xml::Node
+{
+	private:
+
+		friend class Indexed_xml;
+
+		Indexed_xml const &_xml;
+		unsigned    const  _idx;
+
+		Node(Indexed_xml const &xml, unsigned idx) : _xml(xml), _idx(idx) { }
+
+		Entry const &_entry() const { return _xml._nodes[_idx]; }
+
+		bool _has_type(unsigned idx, char const *type) const
+		{
+			Entry const &e = _xml._nodes[idx];
+			return strlen(type) == e.name_len && !strcmp(type, e.name, e.name_len);
+		}
+
+		unsigned _first_sub_node(char const *type) const
+		{
+			unsigned idx = _entry().first_sub;
+			for (; idx != NONE; idx = _xml._nodes[idx].next_sibling)
+				if (!type || _has_type(idx, type))
+					break;
+			return idx;
+		}
+
+		template <typename FN>
+		void _with_attribute(char const *type, FN const &fn) const
+		{
+			Entry const &e = _entry();
+			for (unsigned i = e.first_attr; i < e.first_attr + e.num_attrs; i++) {
+				Attr const &a = _xml._attrs[i];
+				if (strlen(type) != a.name_len || strcmp(type, a.name, a.name_len))
+					continue;
+
+				fn(Xml_attribute(_xml._token_at(a.name)));
+				return;
+			}
+		}
+
+	public:
+
+		Type type() const {
+			return Type(Cstring(_entry().name, _entry().name_len)); }
+
+		bool has_type(char const *type) const { return _has_type(_idx, type); }
+
+		/**
+		 * Return size of node including start and end tags in bytes
+		 */
+		size_t size() const { return _entry().next - _entry().start; }
+
+		/**
+		 * Return size of node content
+		 */
+		size_t content_size() const { return _entry().end - _entry().content; }
+
+		/**
+		 * Call functor 'fn' with the node data '(char const *, size_t)'
+		 */
+		template <typename FN>
+		void with_raw_node(FN const &fn) const { fn(_entry().start, size()); }
+
+		/**
+		 * Call functor 'fn' with content '(char const *, size_t) as argument'
+		 *
+		 * If the node has no content, the functor 'fn' is not called.
+		 */
+		template <typename FN>
+		void with_raw_content(FN const &fn) const
+		{
+			if (!_entry().empty)
+				fn(_entry().content, content_size());
+		}
+
+		/**
+		 * Return 'Xml_node' for the node
+		 *
+		 * This is meant for passing the node to interfaces that expect an
+		 * 'Xml_node'. Note that the construction of the 'Xml_node' scans the
+		 * node content.
+		 */
+		Xml_node xml_node() const
+		{
+			return Xml_node(_entry().start,
+			                _xml._max_len - (_entry().start - _xml._addr));
+		}
+
+		size_t num_sub_nodes() const { return _entry().num_sub_nodes; }
+
+		bool has_sub_node(char const *type) const {
+			return _first_sub_node(type) != NONE; }
+
+		/**
+		 * Apply functor 'fn' to first sub node of specified type
+		 *
+		 * If no matching sub node exists, the functor is not called.
+		 */
+		template <typename FN>
+		void with_optional_sub_node(char const *type, FN const &fn) const
+		{
+			unsigned const idx = _first_sub_node(type);
+			if (idx != NONE)
+				fn(Node(_xml, idx));
+		}
+
+		/**
+		 * Apply functor 'fn' to first sub node of specified type
+		 *
+		 * If no matching sub node exists, the functor 'fn_nexists' is called.
+		 */
+		template <typename FN, typename FN_NEXISTS>
+		void with_sub_node(char const *type, FN const &fn, FN_NEXISTS const &fn_nexists) const
+		{
+			unsigned const idx = _first_sub_node(type);
+			if (idx != NONE)
+				fn(Node(_xml, idx));
+			else
+				fn_nexists();
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node of specified type
+		 */
+		template <typename FN>
+		void for_each_sub_node(char const *type, FN const &fn) const
+		{
+			for (unsigned idx = _entry().first_sub; idx != NONE;
+			     idx = _xml._nodes[idx].next_sibling)
+
+				if (!type || _has_type(idx, type))
+					fn(Node(_xml, idx));
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node
+		 */
+		template <typename FN>
+		void for_each_sub_node(FN const &fn) const { for_each_sub_node(nullptr, fn); }
+
+		/**
+		 * Read attribute value from XML node
+		 *
+		 * \param type           attribute name
+		 * \param default_value  value returned if no attribute with the
+		 *                       name 'type' is present.
+		 * \return               attribute value or specified default value
+		 */
+		template <typename T>
+		T attribute_value(char const *type, T const default_value) const
+		{
+			T result = default_value;
+			_with_attribute(type, [&] (Xml_attribute const &attr) {
+				attr.value(result); });
+			return result;
+		}
+
+		/**
+		 * Return true if attribute of specified type exists
+		 */
+		bool has_attribute(char const *type) const
+		{
+			if (type == nullptr)
+				return _entry().num_attrs > 0;
+
+			bool result = false;
+			_with_attribute(type, [&] (Xml_attribute const &) { result = true; });
+			return result;
+		}
+
+		void print(Output &output) const {
+			output.out_string(_entry().start, size()); }
+};
+
+
+Genode::Indexed_xml::Node Genode::Indexed_xml::root() const { return Node(*this, 0); }
+
+#endif /* _INCLUDE__UTIL__INDEXED_XML_H_ */
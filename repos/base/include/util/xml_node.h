@@ -20,6 +20,7 @@
 #include <base/exception.h>
 
 namespace Genode {
+	class Indexed_xml;
 	class Xml_attribute;
 	class Xml_node;
 	class Xml_unquoted;
@@ -69,6 +70,7 @@ class Genode::Xml_attribute
 		} _tokens;
 
 		friend class Xml_node;
+		friend class Indexed_xml;
 
 		/*
 		 * Even though 'Tag' is part of 'Xml_node', the friendship
@@ -216,6 +218,7 @@ class Genode::Xml_node
 		class Tag;
 
 		friend class Xml_unquoted;
+		friend class Indexed_xml;
 
 	public:
 
@@ -15,6 +15,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/heap.h>
+#include <base/thread_local_heap.h>
 
 using namespace Genode;
 
@@ -250,11 +251,50 @@ Allocator::Alloc_result Heap::try_alloc(size_t size)
 }
 
 
+unsigned Heap::try_alloc_batch(size_t size, void **blocks, unsigned count)
+{
+	if (size == 0)
+		error("attempt to allocate zero-size block from heap");
+
+	/* serialize access of heap functions */
+	Mutex::Guard guard(_mutex);
+
+	unsigned i = 0;
+	for (; i < count && size + _quota_used <= _quota_limit; i++) {
+
+		bool ok = false;
+		_unsynchronized_alloc(size).with_result(
+			[&] (void *ptr)  { blocks[i] = ptr; ok = true; },
+			[&] (Alloc_error) { });
+
+		if (!ok)
+			break;
+	}
+	return i;
+}
+
+
+void Heap::free_batch(void * const *blocks, unsigned count)
+{
+	/* serialize access of heap functions */
+	Mutex::Guard guard(_mutex);
+
+	for (unsigned i = 0; i < count; i++)
+		_unsynchronized_free(blocks[i]);
+}
+
+
 void Heap::free(void *addr, size_t)
 {
 	/* serialize access of heap functions */
 	Mutex::Guard guard(_mutex);
 
+	_unsynchronized_free(addr);
+}
+
+
+void Heap::_unsynchronized_free(void *addr)
+{
 	using Size_at_error = Allocator_avl::Size_at_error;
 
 	Allocator_avl::Size_at_result size_at_result = _alloc->size_at(addr);
@@ -342,3 +382,31 @@ Heap::~Heap()
 	 */
 	_alloc.destruct();
 }
+
+
+/***********************
+ ** Thread_local_heap **
+ ***********************/
+
+Registry<Thread_local_heap> &Thread_local_heap::_registry()
+{
+	struct Observer : Thread::Destruct_observer
+	{
+		Observer() { Thread::register_destruct_observer(*this); }
+
+		void thread_destructed(Thread const &thread) override {
+			_release_caches(thread); }
+	};
+
+	static Registry<Thread_local_heap> registry { };
+	static Observer                    observer { };
+
+	return registry;
+}
+
+
+void Thread_local_heap::_release_caches(Thread const &thread)
+{
+	_registry().for_each([&] (Thread_local_heap &heap) {
+		heap._release(thread); });
+}
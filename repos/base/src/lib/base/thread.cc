@@ -249,6 +249,7 @@ Thread::~Thread()
 	_deinit_platform_thread();
 	_free_stack(_stack);
 
+	_notify_destruct_observers();
 	cxx_free_tls(this);
 
 	/*
@@ -0,0 +1,57 @@
+/*
+ * \brief  Notification about the destruction of threads
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/mutex.h>
+#include <base/thread.h>
+
+using namespace Genode;
+
+
+namespace {
+
+	struct Destruct_observers
+	{
+		Mutex mutex { };
+
+		Thread::Destruct_observer *first = nullptr;
+	};
+
+	Destruct_observers &destruct_observers()
+	{
+		static Destruct_observers observers { };
+		return observers;
+	}
+}
+
+
+void Thread::register_destruct_observer(Destruct_observer &observer)
+{
+	Destruct_observers &observers = destruct_observers();
+
+	Mutex::Guard guard(observers.mutex);
+
+	observer._next  = observers.first;
+	observers.first = &observer;
+}
+
+
+void Thread::_notify_destruct_observers() const
+{
+	Destruct_observers &observers = destruct_observers();
+
+	Mutex::Guard guard(observers.mutex);
+
+	for (Destruct_observer *o = observers.first; o; o = o->_next)
+		o->thread_destructed(*this);
+}
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2022 Genode Labs GmbH
+ * Copyright (C) 2022-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -43,6 +43,7 @@ void Trace::Partitioned_buffer::init(size_t size)
 	_consumer_lock = SPINLOCK_UNLOCKED;
 	_lost_entries = 0;
 	_wrapped = 0;
+	_committed_bytes = 0;
 }
 
 
@@ -109,5 +110,11 @@ char *Trace::Partitioned_buffer::reserve(size_t len)
 }
 
 
-void Trace::Partitioned_buffer::commit(size_t len) {
-	_producer()._commit(len, [&] () { _switch_producer(); }); }
+void Trace::Partitioned_buffer::commit(size_t len)
+{
+	_producer()._commit(len, [&] () { _switch_producer(); });
+
+	/* empty entries are omitted by '_commit' */
+	if (len)
+		_committed_bytes = _committed_bytes + sizeof(Simple_buffer::_Entry) + len;
+}
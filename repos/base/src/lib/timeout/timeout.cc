@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2016-2017 Genode Labs GmbH
+ * Copyright (C) 2016-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -89,14 +89,14 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 		 * list and these would interfere with the filtering if we would do
 		 * it all in the same loop.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
+		while (Timeout *timeout = _timeouts) {
 
 			timeout->_mutex.acquire();
 			if (timeout->_deadline.value > _current_time.value) {
 				timeout->_mutex.release();
 				break;
 			}
-			_timeouts.remove(timeout);
+			_remove_from_timeouts(*timeout);
 			pending_timeouts.insert(&timeout->_pending_timeouts_le);
 		}
 		/*
@@ -153,9 +153,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timeouts heap */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_insert_into_timeouts(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -223,7 +223,7 @@ Timeout_scheduler::~Timeout_scheduler()
 	_destructor_called = true;
 
 	/* discard all scheduled timeouts */
-	while (Timeout *timeout = _timeouts.first()) {
+	while (Timeout *timeout = _timeouts) {
 		Mutex::Guard const timeout_guard { timeout->_mutex };
 		_discard_timeout_unsynchronized(*timeout);
 	}
@@ -243,9 +243,8 @@ void Timeout_scheduler::_enable()
 void Timeout_scheduler::_set_time_source_timeout()
 {
 	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
-			~(uint64_t)0);
+		_timeouts ? _timeouts->_deadline.value - _current_time.value
+		          : ~(uint64_t)0);
 }
 
 
@@ -297,7 +296,7 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 
 	/* prevent inserting a timeout twice */
 	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
+		_remove_from_timeouts(timeout);
 	}
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
@@ -307,42 +306,109 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/* set up timeout object and insert into timeouts heap */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_insert_into_timeouts(timeout);
 
 	/*
 	 * If the new timeout is the first to trigger, we have to  update the
 	 * time-source timeout.
 	 */
-	if (_timeouts.first() == &timeout) {
+	if (_timeouts == &timeout) {
 		_set_time_source_timeout(deadline_us - curr_time_us);
 	}
 }
 
 
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
+Timeout *Timeout_scheduler::_meld(Timeout *t1, Timeout *t2)
 {
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
+	if (!t1) return t2;
+	if (!t2) return t1;
+
+	/* the timeout with the later deadline becomes the first child */
+	if (t2->_deadline.value < t1->_deadline.value) {
+		Timeout *const tmp { t1 };
+		t1 = t2;
+		t2 = tmp;
+	}
+
+	t2->_heap_prev = t1;
+	t2->_heap_next = t1->_heap_child;
+	if (t1->_heap_child) {
+		t1->_heap_child->_heap_prev = t2;
+	}
+	t1->_heap_child = t2;
+	return t1;
+}
+
+
+Timeout *Timeout_scheduler::_merge_pairs(Timeout *first)
+{
+	/*
+	 * Meld the siblings pairwise from left to right and chain the results
+	 * in reverse order via their '_heap_next' pointers.
+	 */
+	Timeout *pairs { nullptr };
+	while (first) {
+
+		Timeout *t1 { first };
+		Timeout *t2 { first->_heap_next };
+		first = t2 ? t2->_heap_next : nullptr;
+
+		t1->_heap_next = t1->_heap_prev = nullptr;
+		if (t2) {
+			t2->_heap_next = t2->_heap_prev = nullptr;
+		}
+		Timeout &pair { *_meld(t1, t2) };
+		pair._heap_next = pairs;
+		pairs = &pair;
+	}
+	/* meld the results from right to left into one heap */
+	Timeout *root { nullptr };
+	while (pairs) {
+
+		Timeout *next { pairs->_heap_next };
+		pairs->_heap_next = nullptr;
+		root = _meld(root, pairs);
+		pairs = next;
+	}
+	return root;
+}
+
+
+void Timeout_scheduler::_insert_into_timeouts(Timeout &timeout)
+{
+	timeout._heap_child = timeout._heap_next = timeout._heap_prev = nullptr;
+	_timeouts = _meld(_timeouts, &timeout);
+}
+
+
+void Timeout_scheduler::_remove_from_timeouts(Timeout &timeout)
+{
+	if (_timeouts == &timeout) {
+		_timeouts = _merge_pairs(timeout._heap_child);
+		timeout._heap_child = nullptr;
 		return;
 	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
+	/* ignore timeouts that are not part of the heap */
+	if (!timeout._heap_prev) {
 		return;
 	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
+	/* cut the sub heap of the timeout from its parent or previous sibling */
+	if (timeout._heap_prev->_heap_child == &timeout) {
+		timeout._heap_prev->_heap_child = timeout._heap_next;
+	} else {
+		timeout._heap_prev->_heap_next = timeout._heap_next;
+	}
+	if (timeout._heap_next) {
+		timeout._heap_next->_heap_prev = timeout._heap_prev;
+	}
+	Timeout *const children { _merge_pairs(timeout._heap_child) };
+
+	timeout._heap_child = timeout._heap_next = timeout._heap_prev = nullptr;
+	_timeouts = _meld(_timeouts, children);
 }
 
 
@@ -393,7 +459,7 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	_remove_from_timeouts(timeout);
 	timeout._handler = nullptr;
 }
 
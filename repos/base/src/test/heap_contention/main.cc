@@ -0,0 +1,151 @@
+/*
+ * \brief  Benchmark of concurrent heap allocations
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A number of threads, each pinned to another CPU if possible, allocate and
+ * free small blocks concurrently, first at a 'Heap' and then at a
+ * 'Thread_local_heap' in front of the same heap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread_local_heap.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Worker : Thread
+{
+	enum { STACK_SIZE = 16*1024, LIVE_BLOCKS = 64 };
+
+	Allocator      &_alloc;
+	unsigned const  _rounds;
+	Blockade        _done { };
+
+	void entry() override
+	{
+		struct Block { void *ptr; size_t size; } blocks[LIVE_BLOCKS] { };
+
+		/* simple linear-congruential generator for the block sizes */
+		unsigned seed = (unsigned)(addr_t)this;
+
+		for (unsigned i = 0; i < _rounds; i++) {
+
+			Block &block = blocks[i % LIVE_BLOCKS];
+			if (block.ptr)
+				_alloc.free(block.ptr, block.size);
+
+			seed = seed*1103515245 + 12345;
+			block.size = 8 + (seed >> 16) % 512;
+			block.ptr  = _alloc.alloc(block.size);
+
+			/* touch the block */
+			*(char *)block.ptr = 0;
+		}
+
+		for (Block &block : blocks)
+			if (block.ptr)
+				_alloc.free(block.ptr, block.size);
+
+		_done.wakeup();
+	}
+
+	Worker(Env &env, Allocator &alloc, unsigned rounds, Location location)
+	:
+		Thread(env, Name("worker"), STACK_SIZE, location, Weight(), env.cpu()),
+		_alloc(alloc), _rounds(rounds)
+	{ }
+
+	void wait_for_completion() { _done.block(); }
+};
+
+
+struct Main
+{
+	enum { MAX_THREADS = 64 };
+
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Timer::Connection       _timer  { _env };
+	Heap                    _heap   { _env.ram(), _env.rm() };
+
+	unsigned const _max_threads {
+		min(_config.xml().attribute_value("threads", 4U), (unsigned)MAX_THREADS) };
+
+	unsigned const _rounds {
+		_config.xml().attribute_value("rounds", 200000U) };
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	/**
+	 * Return duration of running 'num_threads' workers on 'alloc' in us
+	 */
+	uint64_t _measure(Allocator &alloc, unsigned num_threads)
+	{
+		Affinity::Space const cpus = _env.cpu().affinity_space();
+
+		Constructible<Worker> workers[MAX_THREADS];
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i].construct(_env, alloc, _rounds, cpus.location_of_index(i));
+
+		uint64_t const start_us = _now_us();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->start();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->wait_for_completion();
+
+		uint64_t const duration_us = _now_us() - start_us;
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i]->join();
+			workers[i].destruct();
+		}
+		return duration_us;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- heap-contention benchmark started ---");
+
+		for (unsigned threads = 1; threads <= _max_threads; threads *= 2) {
+
+			size_t const consumed_before = _heap.consumed();
+
+			uint64_t const heap_us = _measure(_heap, threads);
+
+			uint64_t cached_us = 0;
+			{
+				Thread_local_heap cached_heap { _heap };
+				cached_us = _measure(cached_heap, threads);
+			}
+
+			if (_heap.consumed() != consumed_before)
+				error("heap consumption changed from ", consumed_before,
+				      " to ", _heap.consumed(), " bytes");
+
+			log(threads, " thread(s), ", _rounds, " rounds each: "
+			    "Heap: ", heap_us/1000, " ms, "
+			    "Thread_local_heap: ", cached_us/1000, " ms");
+		}
+
+		log("--- heap-contention benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-heap_contention
+SRC_CC = main.cc
+LIBS   = base
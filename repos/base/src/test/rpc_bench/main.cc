@@ -0,0 +1,176 @@
+/*
+ * \brief  Benchmark of the RPC round-trip rate
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A number of client threads call an RPC object served by a dedicated
+ * entrypoint. Each client issues a fixed number of calls. The benchmark
+ * reports the number of completed calls per second, first for one client,
+ * then for an increasing number of concurrent clients.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Interface;
+	struct Component;
+	struct Client;
+	struct Worker;
+	struct Main;
+}
+
+
+struct Test::Interface : Genode::Interface
+{
+	GENODE_RPC(Rpc_add, unsigned, add, unsigned, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_add);
+};
+
+
+struct Test::Component : Rpc_object<Test::Interface, Test::Component>
+{
+	unsigned add(unsigned a, unsigned b) { return a + b; }
+};
+
+
+struct Test::Client : Rpc_client<Test::Interface>
+{
+	Client(Capability<Test::Interface> cap) : Rpc_client<Test::Interface>(cap) { }
+
+	unsigned add(unsigned a, unsigned b) { return call<Rpc_add>(a, b); }
+};
+
+
+struct Test::Worker : Thread
+{
+	enum { STACK_SIZE = 16*1024 };
+
+	Client         _client;
+	unsigned const _calls;
+	Blockade       _done { };
+	bool           _ok   { true };
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _calls; i++)
+			if (_client.add(i, 1) != i + 1)
+				_ok = false;
+
+		_done.wakeup();
+	}
+
+	Worker(Env &env, Capability<Test::Interface> cap, unsigned calls,
+	       Location location)
+	:
+		Thread(env, Name("client"), STACK_SIZE, location, Weight(), env.cpu()),
+		_client(cap), _calls(calls)
+	{ }
+
+	bool wait_for_completion() { _done.block(); return _ok; }
+};
+
+
+struct Test::Main
+{
+	enum { MAX_THREADS = 16, EP_STACK_SIZE = 16*1024 };
+
+	Env                    &_env;
+	Attached_rom_dataspace  _config { _env, "config" };
+	Timer::Connection       _timer  { _env };
+
+	unsigned const _max_threads {
+		min(_config.xml().attribute_value("threads", 4U), (unsigned)MAX_THREADS) };
+
+	unsigned const _calls {
+		_config.xml().attribute_value("calls", 100000U) };
+
+	Rpc_entrypoint _ep { &_env.pd(), EP_STACK_SIZE, "rpc_bench_ep",
+	                     Affinity::Location() };
+
+	Component _component { };
+
+	Capability<Test::Interface> _cap { _ep.manage(&_component) };
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	/**
+	 * Return calls per second achieved by 'num_threads' clients
+	 */
+	uint64_t _measure(unsigned num_threads)
+	{
+		Affinity::Space const cpus = _env.cpu().affinity_space();
+
+		Constructible<Worker> workers[MAX_THREADS];
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i].construct(_env, _cap, _calls, cpus.location_of_index(i));
+
+		uint64_t const start_us = _now_us();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->start();
+
+		bool ok = true;
+		for (unsigned i = 0; i < num_threads; i++)
+			ok &= workers[i]->wait_for_completion();
+
+		uint64_t const duration_us = max(_now_us() - start_us, (uint64_t)1);
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i]->join();
+			workers[i].destruct();
+		}
+
+		if (!ok) {
+			error("unexpected RPC result");
+			_env.parent().exit(-1);
+		}
+
+		return (uint64_t)num_threads*_calls*1000*1000 / duration_us;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC benchmark started ---");
+
+		/* calls issued by the entrypoint thread of the component */
+		{
+			Client client(_cap);
+
+			uint64_t const start_us = _now_us();
+			for (unsigned i = 0; i < _calls; i++)
+				client.add(i, 1);
+			uint64_t const duration_us = max(_now_us() - start_us, (uint64_t)1);
+
+			log("entrypoint thread: ",
+			    (uint64_t)_calls*1000*1000 / duration_us, " calls/s");
+		}
+
+		for (unsigned threads = 1; threads <= _max_threads; threads *= 2)
+			log(threads, " client thread(s): ", _measure(threads), " calls/s");
+
+		_ep.dissolve(&_component);
+
+		log("--- RPC benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,168 @@
+/*
+ * \brief  Benchmark of scheduling, discarding, and triggering timeouts
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The timeouts are managed by a 'Timeout_scheduler' driven by a virtual
+ * time source. So the benchmark measures the costs of the timeout framework
+ * only, independent from the timer driver. The wall-clock time of each
+ * phase is measured via a timer session.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Virtual_time_source;
+	struct Counter;
+	struct Main;
+}
+
+
+/**
+ * Time source that advances only on request
+ */
+struct Test::Virtual_time_source : Time_source
+{
+	uint64_t         now_us  { 0 };
+	Timeout_handler *handler { nullptr };
+
+	Duration curr_time() override { return Duration(Microseconds(now_us)); }
+
+	Microseconds max_timeout() const override { return Microseconds(~0ULL); }
+
+	void set_timeout(Microseconds, Timeout_handler &h) override { handler = &h; }
+
+	/**
+	 * Advance time and let the scheduler trigger the pending timeouts
+	 */
+	void advance(uint64_t us)
+	{
+		now_us += us;
+		if (handler)
+			handler->handle_timeout(curr_time());
+	}
+};
+
+
+struct Test::Counter : Timeout_handler
+{
+	unsigned long count { 0 };
+
+	void handle_timeout(Duration) override { count++; }
+};
+
+
+struct Test::Main
+{
+	Env                    &_env;
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Attached_rom_dataspace  _config { _env, "config" };
+	Timer::Connection       _timer  { _env };
+
+	unsigned const _max_timeouts {
+		_config.xml().attribute_value("timeouts", 100000U) };
+
+	uint64_t _random_state { 1 };
+
+	uint64_t _random()
+	{
+		/* xorshift */
+		_random_state ^= _random_state << 13;
+		_random_state ^= _random_state >> 7;
+		_random_state ^= _random_state << 17;
+		return _random_state;
+	}
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	struct Result
+	{
+		uint64_t schedule_ns, reschedule_ns, discard_ns, trigger_ns;
+	};
+
+	template <typename FN>
+	uint64_t _ns_per_timeout(unsigned n, FN const &fn)
+	{
+		uint64_t const start_us = _now_us();
+		fn();
+		return (_now_us() - start_us)*1000 / n;
+	}
+
+	Result _measure(unsigned n)
+	{
+		Virtual_time_source time_source { };
+		Timeout_scheduler   scheduler   { time_source, Microseconds(1) };
+		Counter             counter     { };
+
+		Timeout **timeouts = (Timeout **)_heap.alloc(n*sizeof(Timeout *));
+		for (unsigned i = 0; i < n; i++)
+			timeouts[i] = new (_heap) Timeout(scheduler);
+
+		enum { SPAN_US = 1000*1000 };
+
+		auto schedule_all = [&] () {
+			for (unsigned i = 0; i < n; i++)
+				timeouts[i]->schedule_one_shot(Microseconds(1 + _random() % SPAN_US),
+				                               counter); };
+
+		Result result { };
+
+		result.schedule_ns = _ns_per_timeout(n, schedule_all);
+
+		/* move each timeout to a new deadline as done by protocol timers */
+		result.reschedule_ns = _ns_per_timeout(n, schedule_all);
+
+		result.discard_ns = _ns_per_timeout(n, [&] () {
+			for (unsigned i = 0; i < n; i++)
+				timeouts[i]->discard(); });
+
+		schedule_all();
+
+		result.trigger_ns = _ns_per_timeout(n, [&] () {
+			while (counter.count < n)
+				time_source.advance(SPAN_US/1000); });
+
+		for (unsigned i = 0; i < n; i++)
+			destroy(_heap, timeouts[i]);
+
+		_heap.free(timeouts, n*sizeof(Timeout *));
+
+		return result;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- timeout benchmark started ---");
+
+		for (unsigned n = 1000; n <= _max_timeouts; n *= 10) {
+
+			Result const r = _measure(n);
+
+			log(n, " timeouts: schedule ", r.schedule_ns, " ns, "
+			    "reschedule ", r.reschedule_ns, " ns, "
+			    "discard ", r.discard_ns, " ns, "
+			    "trigger ", r.trigger_ns, " ns per timeout");
+		}
+
+		log("--- timeout benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,174 @@
+/*
+ * \brief  Benchmark comparing 'Xml_node' with 'Indexed_xml'
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <util/indexed_xml.h>
+#include <util/xml_generator.h>
+
+using namespace Genode;
+
+
+struct Walk_result
+{
+	unsigned long nodes;
+	unsigned long value_sum;
+};
+
+
+/**
+ * Visit all nodes of a document and read one attribute per node
+ *
+ * The function is used for both 'Xml_node' and 'Indexed_xml::Node'.
+ */
+template <typename NODE>
+static void walk(NODE const &node, Walk_result &result)
+{
+	result.nodes++;
+	result.value_sum += node.attribute_value("value", 0UL);
+
+	node.for_each_sub_node([&] (NODE const &sub_node) {
+		walk(sub_node, result); });
+}
+
+
+/**
+ * Generate configuration with 'width' domains, each having 'rules' sub nodes
+ */
+static void generate_wide(Xml_generator &xml, unsigned width, unsigned rules)
+{
+	for (unsigned i = 0; i < width; i++) {
+		xml.node("domain", [&] () {
+			xml.attribute("name",  i);
+			xml.attribute("value", i);
+			for (unsigned j = 0; j < rules; j++) {
+				xml.node("ip", [&] () {
+					xml.attribute("dst",    "10.0.0.0/24");
+					xml.attribute("domain", "uplink");
+					xml.attribute("value",  j);
+				});
+			}
+		});
+	}
+}
+
+
+/**
+ * Generate chain of 'depth' nested nodes with some leaf nodes at each level
+ */
+static void generate_deep(Xml_generator &xml, unsigned depth)
+{
+	if (!depth)
+		return;
+
+	xml.node("dir", [&] () {
+		xml.attribute("value", depth);
+		xml.node("file", [&] () { xml.attribute("value", 1); });
+		generate_deep(xml, depth - 1);
+		xml.node("file", [&] () { xml.attribute("value", 2); });
+	});
+}
+
+
+struct Main
+{
+	enum { BUF_SIZE = 8*1024*1024, ROUNDS = 4 };
+
+	Env                    &_env;
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Timer::Connection       _timer  { _env };
+	Attached_ram_dataspace  _buf_ds { _env.ram(), _env.rm(), BUF_SIZE };
+
+	char *_buf() { return _buf_ds.local_addr<char>(); }
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	template <typename FN>
+	void _generate(FN const &fn)
+	{
+		Xml_generator xml(_buf(), BUF_SIZE, "config", [&] () { fn(xml); });
+	}
+
+	/**
+	 * Measure the traversal of the generated document
+	 *
+	 * \return false if both traversals yield different results
+	 */
+	bool _measure(char const *name)
+	{
+		size_t const size = strlen(_buf());
+
+		Walk_result plain   { 0, 0 };
+		Walk_result indexed { 0, 0 };
+
+		uint64_t const plain_start_us = _now_us();
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			plain = { 0, 0 };
+			walk(Xml_node(_buf(), size), plain);
+		}
+		uint64_t const plain_us = (_now_us() - plain_start_us) / ROUNDS;
+
+		/* the index is built anew in each round to account for its costs */
+		uint64_t const indexed_start_us = _now_us();
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			indexed = { 0, 0 };
+			Indexed_xml const xml(_heap, _buf(), size);
+			walk(xml.root(), indexed);
+		}
+		uint64_t const indexed_us = (_now_us() - indexed_start_us) / ROUNDS;
+
+		if (plain.nodes != indexed.nodes || plain.value_sum != indexed.value_sum) {
+			error(name, ": results differ, Xml_node: ", plain.nodes, " nodes, "
+			      "sum ", plain.value_sum, ", Indexed_xml: ", indexed.nodes,
+			      " nodes, sum ", indexed.value_sum);
+			return false;
+		}
+
+		log(name, ": ", size, " bytes, ", plain.nodes, " nodes, "
+		    "Xml_node: ", plain_us, " us, Indexed_xml: ", indexed_us, " us");
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML-node benchmark ---");
+
+		bool ok = true;
+
+		for (unsigned width = 64; width <= 4096; width *= 8) {
+			_generate([&] (Xml_generator &xml) { generate_wide(xml, width, 4); });
+			ok &= _measure(String<32>("wide ", width).string());
+		}
+
+		for (unsigned depth = 16; depth <= 256; depth *= 4) {
+			_generate([&] (Xml_generator &xml) { generate_deep(xml, depth); });
+			ok &= _measure(String<32>("deep ", depth).string());
+		}
+
+		if (!ok) {
+			error("--- XML-node benchmark failed ---");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- XML-node benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -14,6 +14,10 @@
 #ifndef _AES_CBC_4K_H_
 #define _AES_CBC_4K_H_
 
+/* Genode includes */
+#include <base/exception.h>
+#include <base/stdint.h>
+
 namespace Aes_cbc_4k {
 
 	struct Key   { char values[32];   };
@@ -26,6 +30,53 @@ namespace Aes_cbc_4k {
 
 	void encrypt(Key const &, Block_number, Plaintext  const &, Ciphertext &);
 	void decrypt(Key const &, Block_number, Ciphertext const &, Plaintext  &);
+
+	class Context;
 }
 
+
+/**
+ * Key material prepared for processing many blocks with the same key
+ *
+ * The round keys for the data and for the calculation of the initialization
+ * vectors are derived once at construction time instead of for each block.
+ * On CPUs that support the AES-NI instructions, those are used. If the CPU
+ * and the kernel support the 256-bit VAES instructions, the decryption
+ * processes two blocks per instruction.
+ */
+class Aes_cbc_4k::Context
+{
+	private:
+
+		alignas(16) char _key_material[768] { };
+
+		bool const _aes_ni;
+		bool const _vaes;
+
+		/*
+		 * Noncopyable
+		 */
+		Context(Context const &);
+		Context &operator = (Context const &);
+
+	public:
+
+		struct Key_setup_failed : Genode::Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Key_setup_failed
+		 */
+		Context(Key const &);
+
+		/**
+		 * Destructor, wipes the key material
+		 */
+		~Context();
+
+		void encrypt(Block_number, Plaintext  const &, Ciphertext &) const;
+		void decrypt(Block_number, Ciphertext const &, Plaintext  &) const;
+};
+
 #endif /* _AES_CBC_4K_H_ */
@@ -19,6 +19,7 @@
 #include <base/exception.h>
 #include <base/stdint.h>
 
+namespace Vfs { struct Env; }
 
 namespace Cbe_crypto {
 
@@ -30,7 +31,7 @@ namespace Cbe_crypto {
 
 	struct Interface;
 
-	Interface &get_interface();
+	Interface &get_interface(Vfs::Env &);
 
 	enum { BLOCK_SIZE = 4096u };
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2022 Genode Labs GmbH
+ * Copyright (C) 2022-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -70,11 +70,48 @@ Session_policy Trace_recorder::Monitor::_session_policy(Trace::Subject_info cons
 }
 
 
+void Trace_recorder::Monitor::_schedule_drain(uint64_t timeout_us)
+{
+	if (!_max_period_us)
+		return;
+
+	_timer.trigger_once(min(max(timeout_us, _min_period_us), _max_period_us));
+}
+
+
 void Trace_recorder::Monitor::_handle_timeout()
 {
+	/* ignore timeout that was pending when tracing got stopped */
+	if (!_trace_directory.constructed())
+		return;
+
+	uint64_t const now_us     = _timer.elapsed_us();
+	uint64_t const elapsed_us = max(now_us - _last_drain_us, (uint64_t)1);
+
+	_last_drain_us = now_us;
+
+	uint64_t timeout_us = _max_period_us;
+
+	/*
+	 * Drain only the buffers that received new entries, and wake up again
+	 * before the busiest buffer becomes half full at its current fill rate.
+	 * Thereby, idle subjects cost nothing while bursts do not cause the
+	 * producers to overwrite unprocessed entries.
+	 */
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
+
+		size_t const pending = buf.pending_bytes();
+		if (!pending)
+			return;
+
+		uint64_t const half_full_us = (uint64_t)(buf.capacity()/2)*elapsed_us/pending;
+
+		timeout_us = min(timeout_us, half_full_us);
+
 		buf.process_events(*_trace_directory);
 	});
+
+	_schedule_drain(timeout_us);
 }
 
 
@@ -160,13 +197,21 @@ void Trace_recorder::Monitor::start(Xml_node config)
 	else
 		period_ms = config.attribute_value("period_ms", period_ms);
 
-	_timer.trigger_periodic(period_ms * 1000);
+	unsigned const min_period_ms =
+		min(config.attribute_value("min_period_ms", (unsigned)DEFAULT_MIN_PERIOD_MS),
+		    period_ms);
+
+	_max_period_us = period_ms     * 1000ULL;
+	_min_period_us = min_period_ms * 1000ULL;
+	_last_drain_us = _timer.elapsed_us();
+
+	_schedule_drain(_max_period_us);
 }
 
 
 void Trace_recorder::Monitor::stop()
 {
-	_timer.trigger_periodic(0);
+	_max_period_us = 0;
 
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
 		try {
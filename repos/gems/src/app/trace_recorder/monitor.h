@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2022 Genode Labs GmbH
+ * Copyright (C) 2022-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -39,6 +39,7 @@ class Trace_recorder::Monitor
 {
 	private:
 		enum { DEFAULT_BUFFER_SIZE      = 64 * 1024 };
+		enum { DEFAULT_MIN_PERIOD_MS    = 10 };
 		enum { TRACE_SESSION_RAM        = 1024 * 1024 };
 		enum { TRACE_SESSION_ARG_BUFFER = 128 * 1024 };
 
@@ -97,6 +98,9 @@ class Trace_recorder::Monitor
 
 				void process_events(Trace_directory &);
 
+				size_t pending_bytes() const { return _buffer.pending_bytes(); }
+				size_t capacity()      const { return _buffer.capacity(); }
+
 				Registry<Writer_base>   &writers()            { return _writers; }
 
 				Subject_info      const &info()         const { return _info;   }
@@ -110,6 +114,11 @@ class Trace_recorder::Monitor
 		Backends                       _backends         { };
 		Constructible<Trace_directory> _trace_directory  { };
 
+		/* bounds of the adaptive drain period */
+		uint64_t                       _max_period_us    { 0 };
+		uint64_t                       _min_period_us    { 0 };
+		uint64_t                       _last_drain_us    { 0 };
+
 		Rtc::Connection                _rtc              { _env };
 		Timer::Connection              _timer            { _env };
 		Trace::Connection              _trace            { _env,
@@ -130,6 +139,7 @@ class Trace_recorder::Monitor
 		/* methods */
 		Session_policy _session_policy(Trace::Subject_info const &info, Xml_node config);
 		void           _handle_timeout();
+		void           _schedule_drain(uint64_t);
 
 	public:
 
@@ -19,6 +19,10 @@
 #include <openssl/aes.h>
 #include <openssl/sha.h>
 
+#if defined(__x86_64__)
+#include <aes_ni.h>
+#endif
+
 namespace Aes_cbc
 {
 	/* an enum by the OpenSSL library about the size of IV would be nice ! */
@@ -81,23 +85,13 @@ static void inline cleanup_crypto_data(T &t, S &s)
  * "Encrypted salt-sector initialization vector" (ESSIV) algorithm
  * by Clemens Fruhwirth (July 18, 2005) published in
  * "New Methods in Hard Disk Encryption" paper.
+ *
+ * \param key_for_iv  AES key derived from the hash of the data key
  */
-static bool calculate_iv(Aes_cbc_4k::Key          const &key,
+static void calculate_iv(AES_KEY                  const &key_for_iv,
                          Aes_cbc_4k::Block_number const &block,
                          Aes_cbc::Iv                    &cipher_iv)
 {
-	Aes_cbc::Hash hash_of_key;
-	if (!hash_key(key, hash_of_key))
-		return false;
-
-	AES_KEY key_for_iv;
-	if (AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
-	                        &key_for_iv)) {
-		/* clean up crypto relevant data which stays otherwise on stack */
-		cleanup_crypto_data(hash_of_key);
-		return false;
-	}
-
 	Aes_cbc::Sn const plain  { block };
 	Aes_cbc::Iv       ivec   { };       /* zero IV */
 
@@ -106,61 +100,213 @@ static bool calculate_iv(Aes_cbc_4k::Key          const &key,
 
 	AES_cbc_encrypt(plain.values, cipher_iv.values, sizeof(plain.values),
 	                &key_for_iv, ivec.values, AES_ENCRYPT);
+}
 
-	cleanup_crypto_data(hash_of_key, key_for_iv);
 
-	return true;
+namespace {
+
+	struct Openssl_key_material
+	{
+		AES_KEY encrypt;
+		AES_KEY decrypt;
+		AES_KEY iv;
+	};
+
+#if defined(__x86_64__)
+	struct Aes_ni_key_material
+	{
+		Aes_ni::Round_keys encrypt;
+		Aes_ni::Round_keys decrypt;
+		Aes_ni::Round_keys iv;
+	};
+#endif
+
+	template <typename T>
+	T &key_material(char *storage) { return *reinterpret_cast<T *>(storage); }
+
+	template <typename T>
+	T const &key_material(char const *storage) {
+		return *reinterpret_cast<T const *>(storage); }
 }
 
-void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
-                         Plaintext const &plain, Ciphertext &cipher)
+
+static bool aes_ni_available()
+{
+#if defined(__x86_64__)
+	static bool const available = Aes_ni::available();
+	return available;
+#else
+	return false;
+#endif
+}
+
+
+static bool vaes_available()
+{
+#if defined(__x86_64__)
+	static bool const available = Aes_ni::vaes_available();
+	return available;
+#else
+	return false;
+#endif
+}
+
+
+Aes_cbc_4k::Context::Context(Key const &key)
+:
+	_aes_ni(aes_ni_available()), _vaes(_aes_ni && vaes_available())
+{
+	static_assert(sizeof(key.values) == 32, "Key size mismatch");
+	static_assert(sizeof(Openssl_key_material) <= sizeof(_key_material),
+	              "key material exceeds context");
+
+	/* derive the key used for calculating the IV (ESSIV) */
+	Aes_cbc::Hash hash_of_key;
+	if (!hash_key(key, hash_of_key)) {
+		Genode::error("hashing key for iv calculation");
+		cleanup_crypto_data(hash_of_key);
+		throw Key_setup_failed();
+	}
+
+#if defined(__x86_64__)
+	static_assert(sizeof(Aes_ni_key_material) <= sizeof(_key_material),
+	              "key material exceeds context");
+	static_assert(sizeof(hash_of_key.values) == Aes_ni::KEY_SIZE,
+	              "-hash- size vs -key- size mismatch");
+
+	if (_aes_ni) {
+		auto &keys = key_material<Aes_ni_key_material>(_key_material);
+
+		Aes_ni::expand_encrypt_key(key.values, keys.encrypt);
+		Aes_ni::derive_decrypt_key(keys.encrypt, keys.decrypt);
+		Aes_ni::expand_encrypt_key(hash_of_key.values, keys.iv);
+
+		cleanup_crypto_data(hash_of_key);
+		return;
+	}
+#endif
+
+	auto &keys = key_material<Openssl_key_material>(_key_material);
+
+	unsigned char const * const key_values =
+		reinterpret_cast<unsigned char const *>(key.values);
+
+	char const *failed = nullptr;
+
+	if (AES_set_encrypt_key(key_values, sizeof(key.values) * 8, &keys.encrypt))
+		failed = "setting encrypt key";
+
+	else if (AES_set_decrypt_key(key_values, sizeof(key.values) * 8, &keys.decrypt))
+		failed = "setting decrypt key";
+
+	else if (AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
+	                             &keys.iv))
+		failed = "setting key for iv calculation";
+
+	cleanup_crypto_data(hash_of_key);
+
+	/* the destructor is not called, so wipe the key material here */
+	if (failed) {
+		Genode::error(failed);
+		cleanup_crypto_data(_key_material);
+		throw Key_setup_failed();
+	}
+}
+
+
+Aes_cbc_4k::Context::~Context()
+{
+	cleanup_crypto_data(_key_material);
+}
+
+
+void Aes_cbc_4k::Context::encrypt(Block_number const block_number,
+                                  Plaintext const &plain, Ciphertext &cipher) const
 {
 	static_assert(sizeof(plain.values)  == 4096, "Plain text size mismatch");
 	static_assert(sizeof(cipher.values) == 4096, "Cipher size mismatch");
-	static_assert(sizeof(key.values)    ==   32, "Key size mismatch");
 
-	AES_KEY aes_key;
-	if (AES_set_encrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting encrypt key");
+#if defined(__x86_64__)
+	if (_aes_ni) {
+		auto const &keys = key_material<Aes_ni_key_material>(_key_material);
+
+		Aes_cbc::Sn const sn { block_number };
+		Aes_ni::V2di const iv = Aes_ni::encrypt_block(keys.iv, Aes_ni::load(sn.values));
+
+		Aes_ni::cbc_encrypt(keys.encrypt, iv, plain.values, cipher.values,
+		                    sizeof(cipher.values) / Aes_ni::BLOCK_SIZE);
 		return;
 	}
+#endif
+
+	auto const &keys = key_material<Openssl_key_material>(_key_material);
 
 	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
-	}
+	calculate_iv(keys.iv, block_number, iv);
 
 	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(plain.values),
 	                reinterpret_cast<unsigned char *>(cipher.values),
-	                sizeof(cipher.values), &aes_key, iv.values, AES_ENCRYPT);
+	                sizeof(cipher.values), &keys.encrypt, iv.values, AES_ENCRYPT);
 
 	/* clean up crypto relevant data which stays otherwise on stack */
-	cleanup_crypto_data(aes_key, iv);
+	cleanup_crypto_data(iv);
 }
 
-void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
-                         Ciphertext const &cipher, Plaintext &plain)
+
+void Aes_cbc_4k::Context::decrypt(Block_number const block_number,
+                                  Ciphertext const &cipher, Plaintext &plain) const
 {
-	AES_KEY aes_key;
-	if (AES_set_decrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting decrypt key");
+#if defined(__x86_64__)
+	static_assert((sizeof(cipher.values) / Aes_ni::BLOCK_SIZE) % Aes_ni::INTERLEAVE == 0,
+	              "number of blocks not a multiple of the interleave factor");
+	static_assert((sizeof(cipher.values) / Aes_ni::BLOCK_SIZE) % (2*Aes_ni::VAES_INTERLEAVE) == 0,
+	              "number of blocks not a multiple of the VAES interleave factor");
+
+	if (_aes_ni) {
+		auto const &keys = key_material<Aes_ni_key_material>(_key_material);
+
+		Aes_cbc::Sn const sn { block_number };
+		Aes_ni::V2di const iv = Aes_ni::encrypt_block(keys.iv, Aes_ni::load(sn.values));
+
+		if (_vaes)
+			Aes_ni::cbc_decrypt_vaes(keys.decrypt, iv, cipher.values, plain.values,
+			                         sizeof(plain.values) / Aes_ni::BLOCK_SIZE);
+		else
+			Aes_ni::cbc_decrypt(keys.decrypt, iv, cipher.values, plain.values,
+			                    sizeof(plain.values) / Aes_ni::BLOCK_SIZE);
 		return;
 	}
+#endif
+
+	auto const &keys = key_material<Openssl_key_material>(_key_material);
 
 	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
-	}
+	calculate_iv(keys.iv, block_number, iv);
 
 	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(cipher.values),
 	                reinterpret_cast<unsigned char *>(plain.values),
-	                sizeof(plain.values), &aes_key, iv.values, AES_DECRYPT);
+	                sizeof(plain.values), &keys.decrypt, iv.values, AES_DECRYPT);
 
-	cleanup_crypto_data(aes_key, iv);
+	cleanup_crypto_data(iv);
+}
+
+
+/*
+ * The functions keep their original behaviour of merely logging a failed
+ * key setup, which is done by the context.
+ */
+
+void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
+                         Plaintext const &plain, Ciphertext &cipher)
+{
+	try { Context(key).encrypt(block_number, plain, cipher); }
+	catch (Context::Key_setup_failed) { }
+}
+
+
+void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
+                         Ciphertext const &cipher, Plaintext &plain)
+{
+	try { Context(key).decrypt(block_number, cipher, plain); }
+	catch (Context::Key_setup_failed) { }
 }
@@ -0,0 +1,291 @@
+/*
+ * \brief  AES-256-CBC based on the AES-NI instructions of x86_64 CPUs
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The instructions are issued via compiler built-ins, which avoids the
+ * dependency of the intrinsics headers from the C library. Only the
+ * functions of this file are compiled for the "aes" target, so the
+ * remaining code of the library stays executable on CPUs without AES-NI.
+ * The same holds for the VAES variant of the CBC decryption, which is
+ * compiled for the "avx2,vaes" target.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _AES_NI_H_
+#define _AES_NI_H_
+
+/* compiler includes */
+#include <cpuid.h>
+
+#define AES_NI_TARGET __attribute__((target("aes")))
+#define VAES_TARGET   __attribute__((target("avx2,vaes")))
+
+namespace Aes_ni {
+
+	typedef long long V2di  __attribute__((vector_size(16)));
+	typedef int       V4si  __attribute__((vector_size(16)));
+	typedef long long V4di  __attribute__((vector_size(32)));
+	typedef char      V32qi __attribute__((vector_size(32)));
+
+	enum { ROUNDS = 14, BLOCK_SIZE = 16, KEY_SIZE = 32 };
+
+	/*
+	 * Number of blocks decrypted in an interleaved way to hide the latency
+	 * of the AES instructions
+	 */
+	enum { INTERLEAVE = 8 };
+
+	struct Round_keys { V2di values[ROUNDS + 1]; };
+
+	static inline bool available()
+	{
+		unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
+
+		return (ecx & bit_AES) != 0;
+	}
+
+	/**
+	 * Return true if the 256-bit AES instructions are usable
+	 *
+	 * Besides the CPU support, the kernel must have enabled the AVX
+	 * register state via XSAVE, which implies that it preserves the state
+	 * across context switches.
+	 */
+	static inline bool vaes_available()
+	{
+		unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
+
+		if (!(ecx & bit_AES) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+			return false;
+
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+		if ((xcr0_lo & 0x6) != 0x6)
+			return false;
+
+		if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			return false;
+
+		return (ebx & bit_AVX2) && (ecx & bit_VAES);
+	}
+
+	static inline V2di load(void const *ptr)
+	{
+		V2di v;
+		__builtin_memcpy(&v, ptr, sizeof(v));
+		return v;
+	}
+
+	static inline void store(void *ptr, V2di v)
+	{
+		__builtin_memcpy(ptr, &v, sizeof(v));
+	}
+
+	/**
+	 * Return 'v' XORed with its 32-bit words shifted by one, two, and three
+	 * words towards the most significant word
+	 */
+	static inline V2di xor_shifted(V2di v)
+	{
+		V4si const zero { 0, 0, 0, 0 };
+
+		V4si w = (V4si)v;
+		w ^= __builtin_shuffle(w, zero, V4si { 4, 0, 1, 2 });
+		w ^= __builtin_shuffle(w, zero, V4si { 4, 4, 0, 1 });
+		return (V2di)w;
+	}
+
+	/*
+	 * Key expansion of AES-256 as described in Intel's AES-NI white paper
+	 */
+
+	template <int RCON>
+	AES_NI_TARGET static inline V2di next_even_key(V2di even, V2di odd)
+	{
+		V4si const assist = (V4si)__builtin_ia32_aeskeygenassist128(odd, RCON);
+		return xor_shifted(even) ^ (V2di)__builtin_shuffle(assist, V4si { 3, 3, 3, 3 });
+	}
+
+	AES_NI_TARGET static inline V2di next_odd_key(V2di even, V2di odd)
+	{
+		V4si const assist = (V4si)__builtin_ia32_aeskeygenassist128(even, 0);
+		return xor_shifted(odd) ^ (V2di)__builtin_shuffle(assist, V4si { 2, 2, 2, 2 });
+	}
+
+	AES_NI_TARGET static inline void expand_encrypt_key(void const *key,
+	                                                    Round_keys &keys)
+	{
+		V2di * const k = keys.values;
+
+		k[0]  = load(key);
+		k[1]  = load((char const *)key + BLOCK_SIZE);
+		k[2]  = next_even_key<0x01>(k[0],  k[1]);  k[3]  = next_odd_key(k[2],  k[1]);
+		k[4]  = next_even_key<0x02>(k[2],  k[3]);  k[5]  = next_odd_key(k[4],  k[3]);
+		k[6]  = next_even_key<0x04>(k[4],  k[5]);  k[7]  = next_odd_key(k[6],  k[5]);
+		k[8]  = next_even_key<0x08>(k[6],  k[7]);  k[9]  = next_odd_key(k[8],  k[7]);
+		k[10] = next_even_key<0x10>(k[8],  k[9]);  k[11] = next_odd_key(k[10], k[9]);
+		k[12] = next_even_key<0x20>(k[10], k[11]); k[13] = next_odd_key(k[12], k[11]);
+		k[14] = next_even_key<0x40>(k[12], k[13]);
+	}
+
+	/**
+	 * Derive round keys of the equivalent inverse cipher
+	 */
+	AES_NI_TARGET static inline void derive_decrypt_key(Round_keys const &enc,
+	                                                    Round_keys       &dec)
+	{
+		dec.values[0]      = enc.values[ROUNDS];
+		dec.values[ROUNDS] = enc.values[0];
+
+		for (unsigned i = 1; i < ROUNDS; i++)
+			dec.values[i] = __builtin_ia32_aesimc128(enc.values[ROUNDS - i]);
+	}
+
+	AES_NI_TARGET static inline V2di encrypt_block(Round_keys const &keys, V2di v)
+	{
+		v ^= keys.values[0];
+
+		#pragma GCC unroll 14
+		for (unsigned i = 1; i < ROUNDS; i++)
+			v = __builtin_ia32_aesenc128(v, keys.values[i]);
+
+		return __builtin_ia32_aesenclast128(v, keys.values[ROUNDS]);
+	}
+
+	/**
+	 * Encrypt 'num_blocks' blocks in CBC mode
+	 *
+	 * Each block depends on the previous one, which renders the encryption
+	 * inherently sequential.
+	 */
+	AES_NI_TARGET static inline void cbc_encrypt(Round_keys const &keys, V2di iv,
+	                                             char const *src, char *dst,
+	                                             unsigned num_blocks)
+	{
+		for (unsigned i = 0; i < num_blocks; i++) {
+			iv = encrypt_block(keys, load(src + i*BLOCK_SIZE) ^ iv);
+			store(dst + i*BLOCK_SIZE, iv);
+		}
+	}
+
+	/**
+	 * Decrypt 'num_blocks' blocks in CBC mode
+	 *
+	 * In contrast to the encryption, the decryption of each block depends
+	 * only on ciphertext. So 'INTERLEAVE' blocks are processed at once.
+	 * 'num_blocks' must be a multiple of 'INTERLEAVE'.
+	 */
+	AES_NI_TARGET static inline void cbc_decrypt(Round_keys const &keys, V2di iv,
+	                                             char const *src, char *dst,
+	                                             unsigned num_blocks)
+	{
+		for (unsigned i = 0; i < num_blocks; i += INTERLEAVE) {
+
+			V2di cipher[INTERLEAVE], v[INTERLEAVE];
+
+			#pragma GCC unroll 8
+			for (unsigned j = 0; j < INTERLEAVE; j++) {
+				cipher[j] = load(src + (i + j)*BLOCK_SIZE);
+				v[j]      = cipher[j] ^ keys.values[0];
+			}
+
+			for (unsigned r = 1; r < ROUNDS; r++)
+				#pragma GCC unroll 8
+				for (unsigned j = 0; j < INTERLEAVE; j++)
+					v[j] = __builtin_ia32_aesdec128(v[j], keys.values[r]);
+
+			#pragma GCC unroll 8
+			for (unsigned j = 0; j < INTERLEAVE; j++) {
+				v[j] = __builtin_ia32_aesdeclast128(v[j], keys.values[ROUNDS]);
+				store(dst + (i + j)*BLOCK_SIZE, v[j] ^ (j ? cipher[j - 1] : iv));
+			}
+
+			iv = cipher[INTERLEAVE - 1];
+		}
+	}
+
+	/*
+	 * Number of 256-bit vectors, each holding two blocks, decrypted in an
+	 * interleaved way by the VAES variant
+	 */
+	enum { VAES_INTERLEAVE = 8 };
+
+	VAES_TARGET static inline V4di load_2(void const *ptr)
+	{
+		V4di v;
+		__builtin_memcpy(&v, ptr, sizeof(v));
+		return v;
+	}
+
+	VAES_TARGET static inline void store_2(void *ptr, V4di v)
+	{
+		__builtin_memcpy(ptr, &v, sizeof(v));
+	}
+
+	/**
+	 * Decrypt 'num_blocks' blocks in CBC mode using the VAES instructions
+	 *
+	 * Each instruction processes two blocks. 'num_blocks' must be a multiple
+	 * of 2*'VAES_INTERLEAVE'.
+	 */
+	VAES_TARGET static inline void cbc_decrypt_vaes(Round_keys const &keys, V2di iv,
+	                                                char const *src, char *dst,
+	                                                unsigned num_blocks)
+	{
+		enum { N = VAES_INTERLEAVE };
+
+		/* selects the upper block of the first and the lower of the second */
+		V4di const prev_mask { 2, 3, 4, 5 };
+
+		V4di round_keys[ROUNDS + 1];
+		for (unsigned r = 0; r <= ROUNDS; r++)
+			round_keys[r] = V4di { keys.values[r][0], keys.values[r][1],
+			                       keys.values[r][0], keys.values[r][1] };
+
+		/* ciphertext preceding the current blocks in the upper half */
+		V4di carry { 0, 0, iv[0], iv[1] };
+
+		for (unsigned i = 0; i < num_blocks; i += 2*N) {
+
+			V4di cipher[N], v[N];
+
+			#pragma GCC unroll 8
+			for (unsigned j = 0; j < N; j++) {
+				cipher[j] = load_2(src + (i + 2*j)*BLOCK_SIZE);
+				v[j]      = cipher[j] ^ round_keys[0];
+			}
+
+			for (unsigned r = 1; r < ROUNDS; r++)
+				#pragma GCC unroll 8
+				for (unsigned j = 0; j < N; j++)
+					v[j] = (V4di)__builtin_ia32_vaesdec_v32qi((V32qi)v[j],
+					                                          (V32qi)round_keys[r]);
+
+			#pragma GCC unroll 8
+			for (unsigned j = 0; j < N; j++) {
+				v[j] = (V4di)__builtin_ia32_vaesdeclast_v32qi((V32qi)v[j],
+				                                              (V32qi)round_keys[ROUNDS]);
+
+				V4di const prev = __builtin_shuffle(j ? cipher[j - 1] : carry,
+				                                    cipher[j], prev_mask);
+
+				store_2(dst + (i + 2*j)*BLOCK_SIZE, v[j] ^ prev);
+			}
+
+			carry = cipher[N - 1];
+		}
+	}
+}
+
+#endif /* _AES_NI_H_ */
@@ -13,7 +13,12 @@
  */
 
 #include <base/log.h>
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
+#include <vfs/env.h>
 
 #include <aes_cbc_4k/aes_cbc_4k.h>
 
@@ -30,20 +35,33 @@ struct Crypto : Cbe_crypto::Interface
 	struct Key_value_size_mismatch : Genode::Exception { };
 
 	struct {
-		uint32_t        id   { };
-		Aes_cbc_4k::Key key  { };
-		bool            used { false };
+		uint32_t                           id      { };
+		Constructible<Aes_cbc_4k::Context> context { };
+		bool                               used    { false };
 	} keys [Slots::NUM_SLOTS];
 
+	struct Job
+	{
+		enum State { QUEUED, IN_PROGRESS, COMPLETE };
+
+		State                      state   { QUEUED };
+		Cbe::Request               request { };
+		Aes_cbc_4k::Context const *context { nullptr };
+
+		Cbe::Block_data data   { };  /* input of the worker */
+		Cbe::Block_data result { };  /* output of the worker */
+	};
+
+	/*
+	 * The rings are shared with the workers and must be accessed with
+	 * '_mutex' held only.
+	 */
 	struct {
 		struct crypt_ring {
 			unsigned head { 0 };
 			unsigned tail { 0 };
 
-			struct {
-				Cbe::Request    request { };
-				Cbe::Block_data data    { };
-			} queue [4];
+			Job queue [4];
 
 			unsigned max() const {
 				return sizeof(queue) / sizeof(queue[0]); }
@@ -57,16 +75,20 @@ struct Crypto : Cbe_crypto::Interface
 				if (!acceptable())
 					return false;
 
+				queue[head].state = Job::QUEUED;
 				fn(queue[head]);
 				head = (head + 1) % max();
 
 				return true;
 			}
 
+			/*
+			 * Jobs are completed in the order of their submission
+			 */
 			template <typename FUNC>
 			bool apply_crypt(FUNC const &fn)
 			{
-				if (head == tail)
+				if (head == tail || queue[tail].state != Job::COMPLETE)
 					return false;
 
 				if (!fn(queue[tail]))
@@ -75,6 +97,13 @@ struct Crypto : Cbe_crypto::Interface
 				tail = (tail + 1) % max();
 				return true;
 			}
+
+			template <typename FUNC>
+			void for_each_job(FUNC const &fn)
+			{
+				for (unsigned i = tail; i != head; i = (i + 1) % max())
+					fn(queue[i]);
+			}
 		};
 
 		struct crypt_ring encrypt;
@@ -91,8 +120,139 @@ struct Crypto : Cbe_crypto::Interface
 
 		template <typename FUNC>
 		bool apply_decrypt(FUNC const &fn) { return decrypt.apply_crypt(fn); }
+
+		template <typename FUNC>
+		void for_each_job(FUNC const &fn)
+		{
+			encrypt.for_each_job(fn);
+			decrypt.for_each_job(fn);
+		}
+
+		/**
+		 * Return next queued job and mark it as in progress
+		 */
+		Job *take_queued()
+		{
+			Job *result = nullptr;
+			for_each_job([&] (Job &job) {
+				if (!result && job.state == Job::QUEUED)
+					result = &job; });
+
+			if (result)
+				result->state = Job::IN_PROGRESS;
+
+			return result;
+		}
 	} jobs { };
 
+	struct Worker : Thread
+	{
+		Crypto &_crypto;
+
+		Worker(Genode::Env &env, Crypto &crypto, Affinity::Location location)
+		:
+			Thread(env, "crypto_worker", 8*4096, location, Weight(), env.cpu()),
+			_crypto(crypto)
+		{
+			start();
+		}
+
+		void entry() override { _crypto._work(); }
+	};
+
+	/* enough workers to process all jobs of both rings in parallel */
+	enum { MAX_WORKERS = 6 };
+
+	Vfs::Env &_vfs_env;
+
+	Mutex     _mutex     { };
+	Semaphore _available { };
+
+	/* entrypoint waits for the completion of jobs */
+	bool      _waiting    { false };
+	Semaphore _completion { };
+
+	void _handle_completion() { _vfs_env.user().wakeup_vfs_user(); }
+
+	Io_signal_handler<Crypto> _completion_handler {
+		_vfs_env.env().ep(), *this, &Crypto::_handle_completion };
+
+	static void _crypt(Job &job)
+	{
+		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Ciphertext), "size mismatch");
+		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Plaintext), "size mismatch");
+
+		Aes_cbc_4k::Block_number const block_number { job.request.block_number() };
+
+		if (job.request.operation() == Cbe::Request::Operation::WRITE) {
+
+			Aes_cbc_4k::Plaintext const &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext const *>(&job.data);
+			Aes_cbc_4k::Ciphertext      &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext *>(&job.result);
+
+			job.context->encrypt(block_number, plaintext, ciphertext);
+		} else {
+
+			Aes_cbc_4k::Ciphertext const &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext const *>(&job.data);
+			Aes_cbc_4k::Plaintext        &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext *>(&job.result);
+
+			job.context->decrypt(block_number, ciphertext, plaintext);
+		}
+	}
+
+	void _work()
+	{
+		for (;;) {
+
+			_available.down();
+
+			Job *job = nullptr;
+			{
+				Mutex::Guard guard(_mutex);
+				job = jobs.take_queued();
+			}
+
+			if (!job)
+				continue;
+
+			_crypt(*job);
+
+			{
+				Mutex::Guard guard(_mutex);
+				job->state = Job::COMPLETE;
+
+				if (_waiting) {
+					_waiting = false;
+					_completion.up();
+				}
+			}
+
+			_completion_handler.local_submit();
+		}
+	}
+
+	/**
+	 * Block until no worker uses the context of the given key anymore
+	 */
+	void _wait_for_jobs_of_key(uint32_t const id)
+	{
+		for (;;) {
+			{
+				Mutex::Guard guard(_mutex);
+
+				bool in_use = false;
+				jobs.for_each_job([&] (Job const &job) {
+					if (job.state != Job::COMPLETE && job.request.key_id() == id)
+						in_use = true; });
+
+				if (!in_use)
+					return;
+
+				_waiting = true;
+			}
+			_completion.down();
+		}
+	}
+
 	template <typename FUNC>
 	bool apply_to_unused_key(FUNC const &fn)
 	{
@@ -116,7 +276,24 @@ struct Crypto : Cbe_crypto::Interface
 		return false;
 	}
 
-	Crypto() { }
+	Crypto(Vfs::Env &vfs_env) : _vfs_env(vfs_env)
+	{
+		Genode::Env &env = _vfs_env.env();
+
+		/*
+		 * Distribute the workers over the CPUs, sparing the CPU of the
+		 * entrypoint if there are others
+		 */
+		Affinity::Space const space = env.cpu().affinity_space();
+
+		unsigned const first = space.total() > 1 ? 1 : 0;
+		unsigned const num   = min(max(space.total() - first, 1U),
+		                           (unsigned)MAX_WORKERS);
+
+		for (unsigned i = 0; i < num; i++)
+			new (_vfs_env.alloc())
+				Worker(env, *this, space.location_of_index(first + i));
+	}
 
 	/***************
 	 ** interface **
@@ -132,13 +309,31 @@ struct Crypto : Cbe_crypto::Interface
 	             size_t             value_len) override
 	{
 		return apply_to_unused_key([&](auto &key_slot) {
-			if (value_len != sizeof(key_slot.key))
+			Aes_cbc_4k::Key key { };
+
+			if (value_len != sizeof(key.values))
+				return false;
+
+			/* derive the round keys once instead of for each block */
+			Genode::memcpy(key.values, value, sizeof(key.values));
+			bool const key_set_up = [&] () {
+				try {
+					key_slot.context.construct(key);
+					return true;
+				}
+				catch (Aes_cbc_4k::Context::Key_setup_failed) {
+					return false; }
+			} ();
+			Genode::memset(key.values, 0, sizeof(key.values));
+
+			if (!key_set_up)
 				return false;
 
-			if (!_slots.store(id))
+			if (!_slots.store(id)) {
+				key_slot.context.destruct();
 				return false;
+			}
 
-			Genode::memcpy(key_slot.key.values, value, sizeof(key_slot.key));
 			key_slot.id   = id;
 			key_slot.used = true;
 
@@ -149,7 +344,11 @@ struct Crypto : Cbe_crypto::Interface
 	bool remove_key(uint32_t const id) override
 	{
 		return apply_key (id, [&] (auto &meta) {
-			Genode::memset(meta.key.values, 0, sizeof(meta.key.values));
+
+			_wait_for_jobs_of_key(id);
+
+			/* the destructor wipes the key material */
+			meta.context.destruct();
 
 			meta.used = false;
 
@@ -167,33 +366,24 @@ struct Crypto : Cbe_crypto::Interface
 			throw Buffer_size_mismatch();
 		}
 
-		if (!jobs.encrypt.acceptable())
-			return false;
-
-		return apply_key (key_id, [&] (auto &meta) {
+		bool const queued = apply_key (key_id, [&] (auto &meta) {
+			Mutex::Guard guard(_mutex);
 			return jobs.queue_encrypt([&] (auto &job) {
 				job.request = Cbe::Request(Cbe::Request::Operation::WRITE,
 				                           false, block_number, 0, 1, key_id, 0);
-
-				uint64_t block_id = job.request.block_number();
-
-				Aes_cbc_4k::Block_number     block_number { block_id };
-				Aes_cbc_4k::Plaintext const &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext const *>(src.start);
-				Aes_cbc_4k::Ciphertext      &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext *>(&job.data);
-
-				/* paranoia */
-				static_assert(sizeof(plaintext) == sizeof(job.data), "size mismatch");
-
-				Aes_cbc_4k::encrypt(meta.key, block_number, plaintext, ciphertext);
+				job.context = &*meta.context;
+				Genode::memcpy(&job.data, src.start, sizeof(job.data));
 			});
 		});
+
+		if (queued)
+			_available.up();
+
+		return queued;
 	}
 
 	Complete_request encryption_request_complete(Byte_range_ptr const &dst) override
 	{
-		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Ciphertext), "size mismatch");
-		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Plaintext), "size mismatch");
-
 		if (dst.num_bytes != sizeof (Cbe::Block_data)) {
 			error("buffer has wrong size");
 			throw Buffer_size_mismatch();
@@ -201,8 +391,10 @@ struct Crypto : Cbe_crypto::Interface
 
 		uint64_t block_id = 0;
 
+		Mutex::Guard guard(_mutex);
+
 		bool const valid = jobs.apply_encrypt([&](auto const &job) {
-			Genode::memcpy(dst.start, &job.data, sizeof(job.data));
+			Genode::memcpy(dst.start, &job.result, sizeof(job.result));
 
 			block_id = job.request.block_number();
 
@@ -222,24 +414,24 @@ struct Crypto : Cbe_crypto::Interface
 			throw Buffer_size_mismatch();
 		}
 
-		if (!jobs.decrypt.acceptable())
-			return false;
-
-		/* use apply_key to make sure key_id is actually known */
-		return apply_key (key_id, [&] (auto &) {
+		bool const queued = apply_key (key_id, [&] (auto &meta) {
+			Mutex::Guard guard(_mutex);
 			return jobs.queue_decrypt([&] (auto &job) {
 				job.request = Cbe::Request(Cbe::Request::Operation::READ,
 				                           false, block_number, 0, 1, key_id, 0);
+				job.context = &*meta.context;
 				Genode::memcpy(&job.data, src.start, sizeof(job.data));
 			});
 		});
+
+		if (queued)
+			_available.up();
+
+		return queued;
 	}
 
 	Complete_request decryption_request_complete(Byte_range_ptr const &dst) override
 	{
-		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Ciphertext), "size mismatch");
-		static_assert(sizeof(Cbe::Block_data) == sizeof(Aes_cbc_4k::Plaintext), "size mismatch");
-
 		if (dst.num_bytes != sizeof (Cbe::Block_data)) {
 			error("buffer has wrong size");
 			throw Buffer_size_mismatch();
@@ -247,23 +439,14 @@ struct Crypto : Cbe_crypto::Interface
 
 		uint64_t block_id = 0;
 
-		bool const valid = jobs.apply_decrypt([&](auto const &job) {
-			bool ok = apply_key (job.request.key_id(), [&] (auto &meta) {
-				block_id = job.request.block_number();
-
-				Aes_cbc_4k::Block_number      block_number { block_id };
-				Aes_cbc_4k::Ciphertext const &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext const *>(&job.data);
-				Aes_cbc_4k::Plaintext        &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext *>(dst.start);
+		Mutex::Guard guard(_mutex);
 
-				/* paranoia */
-				static_assert(sizeof(ciphertext) == sizeof(job.data), "size mismatch");
-
-				Aes_cbc_4k::decrypt(meta.key, block_number, ciphertext, plaintext);
+		bool const valid = jobs.apply_decrypt([&](auto const &job) {
+			Genode::memcpy(dst.start, &job.result, sizeof(job.result));
 
-				return true;
-			});
+			block_id = job.request.block_number();
 
-			return ok;
+			return true;
 		});
 
 		return Complete_request { .valid = valid,
@@ -274,8 +457,8 @@ struct Crypto : Cbe_crypto::Interface
 } /* anonymous namespace */
 
 
-Cbe_crypto::Interface &Cbe_crypto::get_interface()
+Cbe_crypto::Interface &Cbe_crypto::get_interface(Vfs::Env &vfs_env)
 {
-	static Crypto inst;
+	static Crypto inst(vfs_env);
 	return inst;
 }
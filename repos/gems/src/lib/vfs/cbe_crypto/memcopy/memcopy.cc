@@ -131,7 +131,7 @@ struct Crypto : Cbe_crypto::Interface
 } /* anonymous namespace */
 
 
-Cbe_crypto::Interface &Cbe_crypto::get_interface()
+Cbe_crypto::Interface &Cbe_crypto::get_interface(Vfs::Env &)
 {
 	static Crypto inst;
 	return inst;
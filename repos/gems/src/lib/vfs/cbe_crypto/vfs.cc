@@ -82,8 +82,10 @@ class Vfs_cbe_crypto::Encrypt_file_system : public Vfs::Single_file_system
 				try {
 					Cbe_crypto::Interface::Complete_request const cr =
 						_crypto.encryption_request_complete(dst);
+
+					/* the job is still processed by a worker */
 					if (!cr.valid) {
-						return READ_ERR_INVALID;
+						return READ_QUEUED;
 					}
 
 					_state = State::NONE;
@@ -216,8 +218,12 @@ class Vfs_cbe_crypto::Decrypt_file_system : public Vfs::Single_file_system
 				try {
 					Cbe_crypto::Interface::Complete_request const cr =
 						_crypto.decryption_request_complete(dst);
-					if (cr.valid) {
+
+					/* the job is still processed by a worker */
+					if (!cr.valid) {
+						return READ_QUEUED;
 					}
+
 					_state = State::NONE;
 
 					out_count = dst.num_bytes;
@@ -1142,7 +1148,7 @@ class Vfs_cbe_crypto::File_system : private Local_factory,
 
 		File_system(Vfs::Env &vfs_env, Genode::Xml_node node)
 		:
-			Local_factory        { vfs_env, Cbe_crypto::get_interface() },
+			Local_factory        { vfs_env, Cbe_crypto::get_interface(vfs_env) },
 			Vfs::Dir_file_system { vfs_env, Xml_node(_config(node).string()),
 			                       *this }
 		{ }
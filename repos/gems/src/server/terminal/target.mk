@@ -1,3 +1,3 @@
 TARGET  = terminal
 SRC_CC  = main.cc
-LIBS    = base vfs
+LIBS    = base vfs blit
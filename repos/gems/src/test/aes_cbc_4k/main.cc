@@ -138,6 +138,34 @@ struct Test::Main
 			log("rounds=", test_rounds, ", cycles=", t_end - t_start,
 			    " cycles/rounds=", (t_end - t_start)/test_rounds);
 
+		/* the per-key context must yield the same results */
+		Aes_cbc_4k::Context const context(key);
+
+		block_number.value = config.xml().attribute_value("block_number", 0U);
+
+		context.encrypt(block_number, plaintext, _ciphertext);
+		if (memcmp(_ciphertext.values, cryptextern.values, sizeof(_ciphertext.values))) {
+			error("ciphertext by context differs from external ciphertext");
+			return;
+		}
+
+		t_start = Trace::timestamp();
+		for (unsigned i = 0; i < test_rounds; i++) {
+			context.encrypt(block_number, plaintext, _ciphertext);
+			context.decrypt(block_number, _ciphertext, _decrypted_plaintext);
+
+			if (memcmp(plaintext.values, _decrypted_plaintext.values, sizeof(plaintext))) {
+				error("plaintext differs from ciphertext decrypted by context");
+				return;
+			}
+			block_number.value ++;
+		}
+		t_end = Trace::timestamp();
+
+		if (test_rounds)
+			log("context: rounds=", test_rounds, ", cycles=", t_end - t_start,
+			    " cycles/rounds=", (t_end - t_start)/test_rounds);
+
 		log("Test succeeded");
 	}
 };
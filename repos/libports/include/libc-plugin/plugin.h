@@ -26,6 +26,7 @@
 #include <sys/poll.h>   /* for 'struct pollfd' */
 
 namespace Genode { class Env; }
+namespace Vfs    { struct Read_ready_response_handler; }
 
 namespace Libc {
 
@@ -75,6 +76,7 @@ namespace Libc {
 			virtual bool supports_symlink(const char *oldpath, const char *newpath);
 			virtual bool supports_unlink(const char *path);
 			virtual bool supports_mmap();
+			virtual bool supports_kevent();
 
 			/*
 			 * Should be overwritten for plugins that require the Genode environment
@@ -121,6 +123,25 @@ namespace Libc {
 			virtual File_descriptor *open(const char *pathname, int flags);
 			virtual int pipe(File_descriptor *pipefd[2]);
 			virtual bool poll(File_descriptor&, struct pollfd &pfd);
+
+			/**
+			 * Return true if file descriptor is ready for reading
+			 *
+			 * If the file descriptor is not ready, 'handler' is called once
+			 * it may have become ready. Used by 'kevent' and called in the
+			 * context of a monitor function only.
+			 */
+			virtual bool read_ready(File_descriptor *,
+			                        Vfs::Read_ready_response_handler &handler);
+
+			/**
+			 * Return true if file descriptor is ready for writing
+			 *
+			 * In contrast to 'read_ready', a plugin is not required to call
+			 * 'handler' once the file descriptor becomes writeable.
+			 */
+			virtual bool write_ready(File_descriptor *,
+			                         Vfs::Read_ready_response_handler &handler);
 			virtual ssize_t read(File_descriptor *, void *buf, ::size_t count);
 			virtual ssize_t readlink(const char *path, char *buf, ::size_t bufsiz);
 			virtual ssize_t recv(File_descriptor *, void *buf, ::size_t len, int flags);
@@ -7,7 +7,7 @@ REP_INC_DIR += src/lib/lwip/include
 
 LD_OPT  += --version-script=$(VFS_DIR)/symbol.map
 
-LIBS += lwip format
+LIBS += lwip format net
 
 vpath %.cc $(VFS_DIR)
 
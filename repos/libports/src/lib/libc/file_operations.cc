@@ -264,6 +264,8 @@ __SYS_(int, close, (int libc_fd),
 	if (!fd)
 		return Errno(EBADF);
 
+	kqueue_close_fd(libc_fd);
+
 	if (!fd->plugin || fd->plugin->close(fd) != 0)
 		file_descriptor_allocator()->free(fd);
 
@@ -19,6 +19,7 @@
 #include <base/heap.h>
 #include <util/xml_node.h>
 #include <vfs/types.h>  /* for 'MAX_PATH_LEN' */
+#include <vfs/vfs_handle.h>
 
 /* libc includes */
 #include <setjmp.h>     /* for 'jmp_buf' type */
@@ -74,6 +75,16 @@ namespace Libc {
 	 */
 	void init_select(Select &, Signal &, Monitor &);
 
+	/**
+	 * Kqueue support
+	 */
+	void init_kqueue(Monitor &, Signal &, Vfs::Read_ready_response_handler &);
+
+	/**
+	 * Remove kevent filters of a file descriptor, called on close
+	 */
+	void kqueue_close_fd(int libc_fd);
+
 	/**
 	 * Support for querying available RAM quota in sysctl functions
 	 */
@@ -96,6 +107,11 @@ namespace Libc {
 	void init_malloc_cloned(Clone_connection &);
 	void reinit_malloc(Genode::Allocator &);
 
+	/**
+	 * Release malloc arena of the calling thread, called at thread exit
+	 */
+	void release_malloc_arena();
+
 	typedef String<Vfs::MAX_PATH_LEN> Rtc_path;
 
 	/**
@@ -192,6 +192,7 @@ class Libc::Vfs_plugin final : public Plugin
 		bool supports_symlink(const char *, const char *)      override { return true; }
 		bool supports_unlink(const char *)                     override { return true; }
 		bool supports_mmap()                                   override { return true; }
+		bool supports_kevent()                                 override { return true; }
 
 		bool supports_select(int nfds,
 		                     fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
@@ -219,6 +220,8 @@ class Libc::Vfs_plugin final : public Plugin
 		File_descriptor *open(const char *path, int flags) override;
 		int     pipe(File_descriptor *pipefdo[2]) override;
 		bool    poll(File_descriptor &fdo, struct pollfd &pfd) override;
+		bool    read_ready(File_descriptor *, Vfs::Read_ready_response_handler &) override;
+		bool    write_ready(File_descriptor *, Vfs::Read_ready_response_handler &) override;
 		ssize_t read(File_descriptor *, void *, ::size_t) override;
 		ssize_t readlink(const char *, char *, ::size_t) override;
 		int     rename(const char *, const char *) override;
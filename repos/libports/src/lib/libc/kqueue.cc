@@ -0,0 +1,537 @@
+/*
+ * \brief  kqueue() and kevent() implementation
+ * \author agent
+ * \date   2026-10-18
+ *
+ * In contrast to 'select', which rescans all file descriptors of all waiting
+ * callers on each I/O progress, the readiness of file descriptors registered
+ * at a kqueue is tracked per file descriptor. Each registered event filter is
+ * represented by a 'Knote'. Only knotes on the active queue of a kqueue are
+ * examined when collecting events. A knote that is not ready for reading
+ * leaves the active queue until the read-ready response of the VFS handle
+ * behind the file descriptor re-activates it.
+ *
+ * The VFS lacks a notification mechanism for write readiness. Hence, knotes
+ * of 'EVFILT_WRITE' filters stay on the active queue and are polled whenever
+ * the events of the kqueue are collected.
+ *
+ * All knote state is accessed by monitor functions only, which are executed
+ * serialized with the VFS read-ready responses by the kernel.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/fifo.h>
+#include <util/list.h>
+#include <vfs/vfs_handle.h>
+#include <libc/allocator.h>
+
+/* libc plugin interface */
+#include <libc-plugin/plugin.h>
+#include <libc-plugin/fd_alloc.h>
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <fcntl.h>
+
+/* libc-internal includes */
+#include <internal/init.h>
+#include <internal/errno.h>
+#include <internal/monitor.h>
+#include <internal/signal.h>
+
+namespace Libc {
+	struct Knote;
+	struct Kqueue;
+	struct Kqueue_plugin;
+	struct Fd_watcher;
+}
+
+using namespace Libc;
+
+namespace { using Fn = Libc::Monitor::Function_result; }
+
+
+static Monitor                          *_monitor_ptr;
+static Libc::Signal                     *_signal_ptr;
+static Vfs::Read_ready_response_handler *_response_handler_ptr;
+
+
+void Libc::init_kqueue(Monitor &monitor, Signal &signal,
+                       Vfs::Read_ready_response_handler &handler)
+{
+	_monitor_ptr          = &monitor;
+	_signal_ptr           = &signal;
+	_response_handler_ptr = &handler;
+}
+
+
+static Monitor &monitor()
+{
+	struct Missing_call_of_init_kqueue : Exception { };
+	if (!_monitor_ptr)
+		throw Missing_call_of_init_kqueue();
+
+	return *_monitor_ptr;
+}
+
+
+/**
+ * Event filter registered at a kqueue for a file descriptor
+ */
+struct Libc::Knote : Fifo<Knote>::Element
+{
+	Kqueue &kqueue;
+
+	struct kevent event;
+
+	bool enabled  = true;
+	bool reported = false;  /* edge detection of polled 'EV_CLEAR' filters */
+
+	List_element<Knote> fd_elem     { this };
+	List_element<Knote> kqueue_elem { this };
+
+	Knote(Kqueue &kqueue, struct kevent const &event)
+	: kqueue(kqueue), event(event) { }
+
+	int   fd()     const { return (int)event.ident; }
+	short filter() const { return event.filter; }
+};
+
+
+/**
+ * Read-ready response handler installed at the VFS handles of watched fds
+ *
+ * The watcher re-activates the knotes of the file descriptor and forwards the
+ * response to the kernel.
+ */
+struct Libc::Fd_watcher : Vfs::Read_ready_response_handler
+{
+	List<List_element<Knote>> knotes { };
+
+	template <typename FN>
+	void for_each_knote(FN const &fn)
+	{
+		List_element<Knote> *next = nullptr;
+		for (List_element<Knote> *e = knotes.first(); e; e = next) {
+			next = e->next();
+			fn(*e->object());
+		}
+	}
+
+	void read_ready_response() override;
+};
+
+
+static Fd_watcher _fd_watchers[MAX_NUM_FDS];
+
+
+static Fd_watcher *fd_watcher(int libc_fd)
+{
+	if (libc_fd < 0 || libc_fd >= MAX_NUM_FDS)
+		return nullptr;
+
+	return &_fd_watchers[libc_fd];
+}
+
+
+struct Libc::Kqueue : Plugin_context
+{
+	Genode::Allocator &_alloc;
+
+	List<List_element<Knote>> _knotes { };
+
+	Fifo<Knote> _active { };
+
+	Kqueue(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+	~Kqueue()
+	{
+		while (List_element<Knote> *e = _knotes.first())
+			_destroy(*e->object());
+	}
+
+	Knote *_lookup(int fd, short filter)
+	{
+		Knote *result = nullptr;
+		if (Fd_watcher *watcher = fd_watcher(fd))
+			watcher->for_each_knote([&] (Knote &knote) {
+				if (&knote.kqueue == this && knote.filter() == filter)
+					result = &knote; });
+		return result;
+	}
+
+	void _destroy(Knote &knote)
+	{
+		if (knote.enqueued())
+			_active.remove(knote);
+
+		_knotes.remove(&knote.kqueue_elem);
+		fd_watcher(knote.fd())->knotes.remove(&knote.fd_elem);
+
+		destroy(_alloc, &knote);
+	}
+
+	/**
+	 * Apply change to the registered filters
+	 *
+	 * \return  0 on success, or errno value
+	 */
+	int _apply(struct kevent const &change)
+	{
+		if (change.filter != EVFILT_READ && change.filter != EVFILT_WRITE)
+			return EINVAL;
+
+		int const fd = (int)change.ident;
+
+		File_descriptor *fdo = file_descriptor_allocator()->find_by_libc_fd(fd);
+		if (!fdo || !fd_watcher(fd))
+			return EBADF;
+
+		if (!fdo->plugin || !fdo->plugin->supports_kevent())
+			return EINVAL;
+
+		Knote *knote = _lookup(fd, change.filter);
+
+		if (change.flags & EV_DELETE) {
+			if (!knote)
+				return ENOENT;
+
+			_destroy(*knote);
+			return 0;
+		}
+
+		if (!knote) {
+			if (!(change.flags & EV_ADD))
+				return ENOENT;
+
+			knote = new (_alloc) Knote(*this, change);
+			_knotes.insert(&knote->kqueue_elem);
+			fd_watcher(fd)->knotes.insert(&knote->fd_elem);
+		}
+
+		if (change.flags & EV_ADD) {
+			knote->event.flags  = change.flags & ~(EV_ADD | EV_ENABLE | EV_DISABLE);
+			knote->event.fflags = change.fflags;
+			knote->event.udata  = change.udata;
+		}
+
+		if (change.flags & EV_DISABLE)
+			knote->enabled = false;
+
+		if (change.flags & (EV_ADD | EV_ENABLE))
+			knote->enabled = !(change.flags & EV_DISABLE);
+
+		if (!knote->enabled && knote->enqueued())
+			_active.remove(*knote);
+
+		/* examine new or re-enabled filter at the next collection */
+		knote->reported = false;
+		activate(*knote);
+
+		return 0;
+	}
+
+	bool _ready(Knote &knote)
+	{
+		File_descriptor *fdo =
+			file_descriptor_allocator()->find_by_libc_fd(knote.fd());
+
+		if (!fdo || !fdo->plugin)
+			return false;
+
+		Fd_watcher &watcher = *fd_watcher(knote.fd());
+
+		return (knote.filter() == EVFILT_READ)
+		     ? fdo->plugin->read_ready(fdo, watcher)
+		     : fdo->plugin->write_ready(fdo, watcher);
+	}
+
+	void activate(Knote &knote)
+	{
+		if (knote.enabled && !knote.enqueued())
+			_active.enqueue(knote);
+	}
+
+	/**
+	 * Apply changes and store error events in 'events'
+	 *
+	 * \param error  error of a change that could not be reported in
+	 *               'events'
+	 *
+	 * \return  number of stored events, or -1 if 'error' is set
+	 */
+	int apply(struct kevent const *changes, int nchanges,
+	          struct kevent *events, int nevents, int &error)
+	{
+		int n = 0;
+		for (int i = 0; i < nchanges; i++) {
+
+			struct kevent const &change = changes[i];
+
+			int const change_error = _apply(change);
+
+			if (!change_error && !(change.flags & EV_RECEIPT))
+				continue;
+
+			if (n == nevents) {
+				if (!change_error)
+					continue;
+
+				error = change_error;
+				return -1;
+			}
+
+			events[n]       = change;
+			events[n].flags = EV_ERROR;
+			events[n].data  = change_error;
+			n++;
+		}
+		return n;
+	}
+
+	/**
+	 * Store up to 'nevents' triggered events in 'events'
+	 *
+	 * \return  number of stored events
+	 */
+	int collect(struct kevent *events, int nevents)
+	{
+		int n = 0;
+
+		/* knotes to be examined again at the next collection */
+		Fifo<Knote> remain { };
+
+		while (n < nevents && !_active.empty()) {
+
+			Knote *knote_ptr = nullptr;
+			_active.dequeue([&] (Knote &knote) { knote_ptr = &knote; });
+			Knote &knote = *knote_ptr;
+
+			bool const polled = (knote.filter() == EVFILT_WRITE);
+			bool const ready  = _ready(knote);
+
+			/* wait for the read-ready response of the fd watcher */
+			if (!ready && !polled)
+				continue;
+
+			bool const clear = knote.event.flags & EV_CLEAR;
+
+			/* edge detection of polled filters */
+			if (!ready || (polled && clear && knote.reported)) {
+				knote.reported = ready;
+				remain.enqueue(knote);
+				continue;
+			}
+
+			/*
+			 * The VFS does not reveal the number of readable bytes or the
+			 * available write space. Report at least one.
+			 */
+			events[n]      = knote.event;
+			events[n].data = 1;
+			n++;
+
+			if (knote.event.flags & EV_ONESHOT) {
+				_destroy(knote);
+				continue;
+			}
+
+			if (knote.event.flags & EV_DISPATCH) {
+				knote.enabled = false;
+				continue;
+			}
+
+			knote.reported = true;
+
+			/* level-triggered filters stay active until not ready */
+			if (!clear || polled)
+				remain.enqueue(knote);
+		}
+
+		remain.dequeue_all([&] (Knote &knote) { _active.enqueue(knote); });
+
+		return n;
+	}
+};
+
+
+void Libc::Fd_watcher::read_ready_response()
+{
+	for_each_knote([&] (Knote &knote) {
+		knote.kqueue.activate(knote); });
+
+	if (_response_handler_ptr)
+		_response_handler_ptr->read_ready_response();
+}
+
+
+void Libc::kqueue_close_fd(int libc_fd)
+{
+	Fd_watcher *watcher = fd_watcher(libc_fd);
+	if (!watcher || !watcher->knotes.first())
+		return;
+
+	monitor().monitor([&] {
+		watcher->for_each_knote([&] (Knote &knote) {
+			knote.kqueue._destroy(knote); });
+		return Fn::COMPLETE;
+	});
+}
+
+
+struct Libc::Kqueue_plugin : Plugin
+{
+	Libc::Allocator _alloc { };
+
+	File_descriptor *kqueue()
+	{
+		Kqueue *kqueue = new (_alloc) Kqueue(_alloc);
+
+		File_descriptor *fd = file_descriptor_allocator()->alloc(this, kqueue);
+		if (!fd)
+			destroy(_alloc, kqueue);
+
+		return fd;
+	}
+
+	static Kqueue *kqueue(File_descriptor &fd)
+	{
+		return dynamic_cast<Kqueue *>(fd.context);
+	}
+
+	int close(File_descriptor *fd) override
+	{
+		Kqueue *kqueue = Kqueue_plugin::kqueue(*fd);
+
+		monitor().monitor([&] {
+			destroy(_alloc, kqueue);
+			return Fn::COMPLETE;
+		});
+
+		file_descriptor_allocator()->free(fd);
+		return 0;
+	}
+
+	int fcntl(File_descriptor *fd, int cmd, long arg) override
+	{
+		switch (cmd) {
+		case F_GETFD: return fd->cloexec ? FD_CLOEXEC : 0;
+		case F_SETFD: fd->cloexec = arg == FD_CLOEXEC;  return 0;
+		case F_GETFL: return fd->flags;
+		case F_SETFL: fd->flags = (int)arg; return 0;
+		default: break;
+		}
+		return Errno(EINVAL);
+	}
+};
+
+
+static Kqueue_plugin &kqueue_plugin()
+{
+	static Kqueue_plugin plugin;
+	return plugin;
+}
+
+
+extern "C" int __sys_kqueue(void)
+{
+	File_descriptor *fd = kqueue_plugin().kqueue();
+	if (!fd)
+		return Errno(EMFILE);
+
+	return fd->libc_fd;
+}
+
+
+extern "C" __attribute__((alias("__sys_kqueue")))
+int kqueue(void);
+
+
+extern "C" int __sys_kevent(int libc_fd,
+                            struct kevent const *changelist, int nchanges,
+                            struct kevent *eventlist, int nevents,
+                            struct timespec const *timeout)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (!fd || fd->plugin != &kqueue_plugin())
+		return Errno(EBADF);
+
+	if (nchanges < 0 || nevents < 0 || (nchanges && !changelist)
+	 || (nevents && !eventlist))
+		return Errno(EINVAL);
+
+	if (timeout && (timeout->tv_sec < 0 || timeout->tv_nsec < 0
+	             || timeout->tv_nsec >= 1000*1000*1000))
+		return Errno(EINVAL);
+
+	Kqueue &kqueue = *Kqueue_plugin::kqueue(*fd);
+
+	bool const polling = timeout && !timeout->tv_sec && !timeout->tv_nsec;
+
+	/* round up to the granularity of the monitor timeout */
+	Genode::uint64_t const timeout_ms = (timeout && !polling)
+		? (Genode::uint64_t)timeout->tv_sec*1000
+		  + ((Genode::uint64_t)timeout->tv_nsec + 999999)/1000000
+		: 0;
+
+	unsigned const orig_signal_count = _signal_ptr ? _signal_ptr->count() : 0;
+
+	auto signal_occurred = [&] {
+		return _signal_ptr && (_signal_ptr->count() != orig_signal_count); };
+
+	bool changes_applied = false;
+	int  result          = 0;
+	int  result_errno    = 0;
+
+	auto monitor_fn = [&] ()
+	{
+		if (!changes_applied) {
+			changes_applied = true;
+
+			result = kqueue.apply(changelist, nchanges, eventlist, nevents,
+			                      result_errno);
+
+			/* errors are reported without waiting for events */
+			if (result != 0 || nevents == 0)
+				return Fn::COMPLETE;
+		}
+
+		result = kqueue.collect(eventlist, nevents);
+
+		if (result || polling || signal_occurred())
+			return Fn::COMPLETE;
+
+		return Fn::INCOMPLETE;
+	};
+
+	Monitor::Result const monitor_result = monitor().monitor(monitor_fn, timeout_ms);
+
+	if (result_errno)
+		return Errno(result_errno);
+
+	if (monitor_result == Monitor::Result::TIMEOUT)
+		return 0;
+
+	if (result == 0 && signal_occurred())
+		return Errno(EINTR);
+
+	return result;
+}
+
+
+extern "C" __attribute__((alias("__sys_kevent")))
+int _kevent(int, struct kevent const *, int, struct kevent *, int,
+            struct timespec const *);
+
+
+extern "C" __attribute__((alias("__sys_kevent")))
+int kevent(int, struct kevent const *, int, struct kevent *, int,
+           struct timespec const *);
@@ -16,6 +16,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -74,6 +75,22 @@ class Libc::Slab_alloc : public Slab
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Small objects are allocated from per-thread arenas, each consisting of a
+ * set of slab allocators. An arena is used exclusively by its owning thread,
+ * which allocates and frees its blocks without taking a lock. Blocks freed
+ * by other threads are pushed onto a lock-free remote-free list of the
+ * owning arena, which is drained by the owner at its next allocation.
+ *
+ * When a pthread exits, its arena becomes orphaned. The slabs of an orphaned
+ * arena are destructed as soon as no block of the arena is in use anymore,
+ * either at the exit of the thread or at the free of the last block. An
+ * orphaned arena is adopted by the next thread that needs an arena.
+ *
+ * Arenas are allocated from the backing store. Hence, they are part of the
+ * heap content mirrored to a forked child. Since the threads of the parent
+ * do not exist in the child, all arenas are orphaned when the malloc state
+ * is imported from the parent.
  */
 class Libc::Malloc
 {
@@ -86,9 +103,19 @@ class Libc::Malloc
 			SLAB_START    = 5,  /* 32 bytes (log2) */
 			SLAB_STOP     = 11, /* 2048 bytes (log2) */
 			NUM_SLABS     = (SLAB_STOP - SLAB_START) + 1,
-			DEFAULT_ALIGN = 16
+			DEFAULT_ALIGN = 16,
+			MAX_ARENAS    = 32,
+			ARENA_SHIFT   = 16
 		};
 
+		/*
+		 * The offset of a slab allocation is lower than the largest slab
+		 * size. So the upper bits of the offset are free to store the index
+		 * of the block's arena. This keeps the metadata at 16 bytes.
+		 */
+		static_assert((1U << SLAB_STOP) < (1U << ARENA_SHIFT),
+		              "arena index overlaps offset of slab allocations");
+
 		struct Metadata
 		{
 			size_t size;
@@ -98,10 +125,119 @@ class Libc::Malloc
 			 * Allocation metadata
 			 *
 			 * \param size    allocation size
-			 * \param offset  offset of pointer from allocation
+			 * \param offset  offset of pointer from allocation, combined
+			 *                with the arena index for slab allocations
 			 */
 			Metadata(size_t size, size_t offset)
 			: size(size), offset(offset) { }
+
+			bool slab_allocated() const { return size <= (1U << SLAB_STOP); }
+
+			unsigned arena_index() const {
+				return slab_allocated() ? (unsigned)(offset >> ARENA_SHIFT) : 0; }
+
+			size_t alloc_offset() const {
+				return slab_allocated() ? offset & ((1U << ARENA_SHIFT) - 1) : offset; }
+		};
+
+		/**
+		 * Block freed by a thread other than the owner of its arena
+		 *
+		 * The list element is stored in place of the freed block's content.
+		 */
+		struct Remote_free { Remote_free *next; };
+
+		struct Arena
+		{
+			/* index stored in the metadata, 0 for the shared arena */
+			unsigned const index;
+
+			Allocator &backing_store;
+
+			/* owner thread, nullptr if the arena is orphaned */
+			Thread * volatile owner;
+
+			Remote_free * volatile remote_frees { nullptr };
+
+			/* not constructed while the arena is orphaned and unused */
+			Constructible<Slab_alloc> slabs[NUM_SLABS];
+
+			/*
+			 * Noncopyable
+			 */
+			Arena(Arena const &);
+			Arena &operator = (Arena const &);
+
+			/**
+			 * Construct slabs, called by the owner
+			 *
+			 * \throw Out_of_ram
+			 * \throw Out_of_caps
+			 * \throw Denied
+			 */
+			void construct_slabs()
+			{
+				for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
+					if (!slabs[i - SLAB_START].constructed())
+						slabs[i - SLAB_START].construct(1U << i, backing_store);
+			}
+
+			Arena(Allocator &backing_store, unsigned index, Thread *owner)
+			: index(index), backing_store(backing_store), owner(owner)
+			{
+				construct_slabs();
+			}
+
+			bool adopt(Thread *myself)
+			{
+				Thread *expected = nullptr;
+				return __atomic_compare_exchange_n(&owner, &expected, myself, false,
+				                                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+			}
+
+			void release() { __atomic_store_n(&owner, nullptr, __ATOMIC_RELEASE); }
+
+			/**
+			 * Return slab memory to the backing store if no block is in use,
+			 * called by the owner
+			 */
+			void reclaim_if_unused()
+			{
+				drain_remote_frees();
+
+				for (Constructible<Slab_alloc> &slab : slabs)
+					if (slab.constructed() && slab->any_used_elem())
+						return;
+
+				for (Constructible<Slab_alloc> &slab : slabs)
+					slab.destruct();
+			}
+
+			void remote_free(void *ptr)
+			{
+				Remote_free *elem = (Remote_free *)ptr;
+				elem->next = __atomic_load_n(&remote_frees, __ATOMIC_RELAXED);
+				while (!__atomic_compare_exchange_n(&remote_frees, &elem->next, elem,
+				                                    true, __ATOMIC_RELEASE,
+				                                    __ATOMIC_RELAXED));
+			}
+
+			/**
+			 * Free all blocks freed by other threads, called by the owner
+			 */
+			void drain_remote_frees()
+			{
+				if (!remote_frees)
+					return;
+
+				Remote_free *elem = __atomic_exchange_n(&remote_frees, nullptr,
+				                                        __ATOMIC_ACQUIRE);
+				while (elem) {
+					Remote_free * const next = elem->next;
+					Malloc::_free_local(*this, (void *)elem);
+					elem = next;
+				}
+			}
 		};
 
 		/**
@@ -124,11 +260,28 @@ class Libc::Malloc
 
 		Allocator &_backing_store; /* back-end allocator */
 
-		Constructible<Slab_alloc> _slabs[NUM_SLABS]; /* slab allocators */
+		/*
+		 * Arena used by threads that cannot obtain an arena of their own,
+		 * protected by '_mutex'
+		 */
+		Arena _shared_arena { _backing_store, 0, _shared_owner() };
+
+		Arena * volatile _arenas[MAX_ARENAS] { };
 
-		Mutex _mutex;
+		Mutex _mutex { };
+
+		/*
+		 * Noncopyable
+		 */
+		Malloc(Malloc const &);
+		Malloc &operator = (Malloc const &);
+
+		/**
+		 * Pseudo owner of the shared arena that never matches a thread
+		 */
+		static Thread *_shared_owner() { return (Thread *)~0UL; }
 
-		unsigned _slab_log2(size_t size) const
+		static unsigned _slab_log2(size_t size)
 		{
 			unsigned msb = Genode::log2(size);
 
@@ -143,14 +296,102 @@ class Libc::Malloc
 			return msb;
 		}
 
-	public:
+		/**
+		 * Free block at the slab of its arena
+		 *
+		 * Must be called by the owner of the arena.
+		 */
+		static void _free_local(Arena &arena, void *ptr)
+		{
+			Metadata *md = (Metadata *)ptr - 1;
+
+			void *alloc_addr = (void *)((addr_t)ptr - md->alloc_offset());
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+			arena.slabs[_slab_log2(md->size) - SLAB_START]->free(alloc_addr);
+		}
+
+		Arena &_arena_at(unsigned index)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
-				_slabs[i - SLAB_START].construct(1U << i, backing_store);
+			return index ? *_arenas[index - 1] : _shared_arena;
 		}
 
+		/**
+		 * Return arena owned by the calling thread, or nullptr
+		 */
+		Arena *_arena(Thread *myself)
+		{
+			if (!myself)
+				return nullptr;
+
+			for (unsigned i = 0; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arenas[i];
+				if (!arena)
+					break;
+
+				if (arena->owner == myself)
+					return arena;
+			}
+
+			/* adopt orphaned arena */
+			for (unsigned i = 0; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arenas[i];
+				if (!arena)
+					break;
+
+				if (arena->owner || !arena->adopt(myself))
+					continue;
+
+				try {
+					arena->construct_slabs();
+					return arena;
+				}
+				catch (...) {
+					arena->release();
+					return nullptr;
+				}
+			}
+
+			/* create new arena */
+			Mutex::Guard guard(_mutex);
+
+			for (unsigned i = 0; i < MAX_ARENAS; i++) {
+				if (_arenas[i])
+					continue;
+
+				Arena *arena = nullptr;
+				try { arena = new (_backing_store) Arena(_backing_store, i + 1, myself); }
+				catch (...) { return nullptr; }
+
+				__atomic_store_n(&_arenas[i], arena, __ATOMIC_RELEASE);
+				return arena;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Allocate block from the arena of the calling thread
+		 *
+		 * \param arena  arena the block was allocated from
+		 */
+		void *_slab_alloc(unsigned msb, Arena *&arena)
+		{
+			arena = _arena(Thread::myself());
+			if (arena) {
+				arena->drain_remote_frees();
+				return arena->slabs[msb - SLAB_START]->alloc();
+			}
+
+			Mutex::Guard guard(_mutex);
+
+			arena = &_shared_arena;
+			_shared_arena.drain_remote_frees();
+			return _shared_arena.slabs[msb - SLAB_START]->alloc();
+		}
+
+	public:
+
+		Malloc(Allocator &backing_store) : _backing_store(backing_store) { }
+
 		~Malloc() { warning(__func__, " unexpectedly called"); }
 
 		/**
@@ -159,20 +400,22 @@ class Libc::Malloc
 
 		void * alloc(size_t size, size_t align = DEFAULT_ALIGN)
 		{
-			Mutex::Guard guard(_mutex);
-
 			size_t   const real_size = size + _room(align);
 			unsigned const msb       = _slab_log2(real_size);
 
-			void *alloc_addr = nullptr;
+			void     *alloc_addr  = nullptr;
+			Arena    *arena       = nullptr;
+			unsigned  arena_index = 0;
 
 			/* use backing store if requested memory is larger than largest slab */
 			if (msb > SLAB_STOP)
 				_backing_store.try_alloc(real_size).with_result(
 					[&] (void *ptr) { alloc_addr = ptr; },
 					[&] (Allocator::Alloc_error) { });
-			else
-				alloc_addr = _slabs[msb - SLAB_START]->alloc();
+			else {
+				alloc_addr  = _slab_alloc(msb, arena);
+				arena_index = arena->index;
+			}
 
 			if (!alloc_addr) return nullptr;
 
@@ -182,7 +425,8 @@ class Libc::Malloc
 
 			size_t const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
 
-			*(aligned_addr - 1) = Metadata(real_size, offset);
+			*(aligned_addr - 1) = Metadata(real_size,
+			                               offset | ((size_t)arena_index << ARENA_SHIFT));
 
 			return aligned_addr;
 		}
@@ -212,21 +456,66 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
-			Mutex::Guard lock_guard(_mutex);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
-			size_t   const  real_size  = md->size;
-			unsigned const  msb        = _slab_log2(real_size);
+			if (!md->slab_allocated()) {
+				_backing_store.free((void *)((addr_t)ptr - md->offset), md->size);
+				return;
+			}
+
+			Arena  &arena  = _arena_at(md->arena_index());
+			Thread *myself = Thread::myself();
+
+			if (myself && arena.owner == myself) {
+				_free_local(arena, ptr);
+				return;
+			}
 
-			void *alloc_addr = (void *)((addr_t)ptr - md->offset);
+			/*
+			 * Free the block to an orphaned arena by temporarily adopting the
+			 * arena, which allows for reclaiming the arena's slabs once its
+			 * last block is freed.
+			 */
+			if (myself && !arena.owner && arena.adopt(myself)) {
+				_free_local(arena, ptr);
+				arena.reclaim_if_unused();
+				arena.release();
+				return;
+			}
+
+			arena.remote_free(ptr);
+		}
 
-			if (msb > SLAB_STOP) {
-				_backing_store.free(alloc_addr, real_size);
-			} else {
-				_slabs[msb - SLAB_START]->free(alloc_addr);
+		/**
+		 * Release arena of the calling thread for the adoption by another thread
+		 *
+		 * The slabs of the arena are reclaimed if none of its blocks is in
+		 * use anymore.
+		 */
+		void release_arena()
+		{
+			Thread * const myself = Thread::myself();
+			if (!myself)
+				return;
+
+			for (unsigned i = 0; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arenas[i];
+				if (arena && arena->owner == myself) {
+					arena->reclaim_if_unused();
+					arena->release();
+				}
 			}
 		}
+
+		/**
+		 * Orphan all arenas, used after importing the state of a forked parent
+		 */
+		void orphan_arenas()
+		{
+			for (unsigned i = 0; i < MAX_ARENAS; i++)
+				if (_arenas[i])
+					_arenas[i]->release();
+		}
 };
 
 
@@ -303,6 +592,16 @@ void Libc::init_malloc_cloned(Clone_connection &clone_connection)
 	clone_connection.object_content(constructible_malloc());
 
 	mallocator = constructible_malloc().operator->();
+
+	/* the threads owning the arenas exist in the parent only */
+	mallocator->orphan_arenas();
+}
+
+
+void Libc::release_malloc_arena()
+{
+	if (mallocator)
+		mallocator->release_arena();
 }
 
 
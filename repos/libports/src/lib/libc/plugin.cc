@@ -149,6 +149,12 @@ bool Plugin::supports_mmap()
 }
 
 
+bool Plugin::supports_kevent()
+{
+	return false;
+}
+
+
 /**
  * Generate dummy member function of Plugin class
  */
@@ -209,6 +215,8 @@ DUMMY(int, -1, munmap,       (void *, ::size_t));
 DUMMY(int, -1, msync,        (void *addr, ::size_t len, int flags));
 DUMMY(int, -1, pipe,         (File_descriptor*[2]));
 DUMMY(bool, 0, poll,         (File_descriptor &, struct pollfd &));
+DUMMY(bool, 0, read_ready,   (File_descriptor *, Vfs::Read_ready_response_handler &));
+DUMMY(bool, 0, write_ready,  (File_descriptor *, Vfs::Read_ready_response_handler &));
 DUMMY(ssize_t, -1, readlink, (const char *, char *, ::size_t));
 DUMMY(int, -1, rename,       (const char *, const char *));
 DUMMY(int, -1, rmdir,        (const char*));
@@ -712,6 +712,9 @@ extern "C" {
 			}
 		} while (at_least_one_destructor_called);
 
+		/* leave cached memory of the thread to the next thread */
+		Libc::release_malloc_arena();
+
 		pthread_self()->exit(value_ptr);
 	}
 
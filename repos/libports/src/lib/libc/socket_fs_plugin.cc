@@ -48,6 +48,7 @@
 namespace Libc {
 	extern char const *config_socket();
 	bool read_ready_from_kernel(File_descriptor *);
+	bool read_ready_from_kernel(File_descriptor *, Vfs::Read_ready_response_handler &);
 	bool write_ready_from_kernel(File_descriptor *);
 }
 
@@ -208,6 +209,14 @@ struct Libc::Socket_fs::Context : Plugin_context
 				return false;
 		}
 
+		bool _fd_read_ready(Fd type, Vfs::Read_ready_response_handler &handler)
+		{
+			if (_fd[type].file)
+				return Libc::read_ready_from_kernel(_fd[type].file, handler);
+			else
+				return false;
+		}
+
 	public:
 
 		Context(Proto proto, int handle_fd)
@@ -272,6 +281,25 @@ struct Libc::Socket_fs::Context : Plugin_context
 			return _fd_write_ready(Fd::DATA);
 		}
 
+		/*
+		 * Variants of 'read_ready' and 'write_ready' that direct the
+		 * read-ready responses of the underlying files to 'handler'
+		 */
+
+		bool read_ready(Vfs::Read_ready_response_handler &handler)
+		{
+			return _fd_read_ready((_state == ACCEPT_ONLY) ? Fd::ACCEPT : Fd::DATA,
+			                      handler);
+		}
+
+		bool write_ready(Vfs::Read_ready_response_handler &handler)
+		{
+			if (_state == CONNECTING)
+				return _fd_read_ready(Fd::CONNECT, handler);
+
+			return _fd_write_ready(Fd::DATA);
+		}
+
 		/*
 		 * Read the connect status from the connect file and return 0 if connected
 		 * or -1 with errno set to the error code.
@@ -340,7 +368,8 @@ struct Libc::Socket_fs::Local_functor : Sockaddr_functor
 
 struct Libc::Socket_fs::Plugin : Libc::Plugin
 {
-	bool supports_poll() override { return true; }
+	bool supports_poll()   override { return true; }
+	bool supports_kevent() override { return true; }
 	bool supports_select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
 
 	ssize_t read(File_descriptor *, void *, ::size_t) override;
@@ -348,6 +377,8 @@ struct Libc::Socket_fs::Plugin : Libc::Plugin
 	int fcntl(File_descriptor *, int, long) override;
 	int close(File_descriptor *) override;
 	bool poll(File_descriptor &fd, struct pollfd &pfd) override;
+	bool read_ready(File_descriptor *, Vfs::Read_ready_response_handler &) override;
+	bool write_ready(File_descriptor *, Vfs::Read_ready_response_handler &) override;
 	int select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
 	int ioctl(File_descriptor *, unsigned long, char *) override;
 };
@@ -1309,6 +1340,30 @@ bool Socket_fs::Plugin::poll(File_descriptor &fdo, struct pollfd &pfd)
 }
 
 
+bool Socket_fs::Plugin::read_ready(File_descriptor *fd,
+                                   Vfs::Read_ready_response_handler &handler)
+{
+	try {
+		Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+		return context && context->read_ready(handler);
+	} catch (Socket_fs::Context::Inaccessible) { }
+
+	return false;
+}
+
+
+bool Socket_fs::Plugin::write_ready(File_descriptor *fd,
+                                    Vfs::Read_ready_response_handler &handler)
+{
+	try {
+		Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+		return context && context->write_ready(handler);
+	} catch (Socket_fs::Context::Inaccessible) { }
+
+	return false;
+}
+
+
 bool Socket_fs::Plugin::supports_select(int nfds,
                                         fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
                                         struct timeval *timeout)
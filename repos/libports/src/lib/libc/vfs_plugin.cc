@@ -230,6 +230,23 @@ namespace Libc {
 
 		return handle->fs().write_ready(*handle);
 	}
+
+	/**
+	 * Variant of 'read_ready_from_kernel' that directs the read-ready response
+	 * of the handle to 'handler'
+	 *
+	 * The handler is expected to forward the response to the kernel.
+	 */
+	bool read_ready_from_kernel(File_descriptor *fd,
+	                            Vfs::Read_ready_response_handler &handler)
+	{
+		Vfs::Vfs_handle *handle = vfs_handle(fd);
+		if (!handle) return false;
+
+		handle->handler(&handler);
+
+		return read_ready_from_kernel(fd);
+	}
 }
 
 
@@ -2529,6 +2546,20 @@ bool Libc::Vfs_plugin::poll(File_descriptor &fd, struct pollfd &pfd)
 }
 
 
+bool Libc::Vfs_plugin::read_ready(File_descriptor *fd,
+                                  Vfs::Read_ready_response_handler &handler)
+{
+	return read_ready_from_kernel(fd, handler);
+}
+
+
+bool Libc::Vfs_plugin::write_ready(File_descriptor *fd,
+                                   Vfs::Read_ready_response_handler &)
+{
+	return write_ready_from_kernel(fd);
+}
+
+
 bool Libc::Vfs_plugin::supports_select(int nfds,
                                        fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
                                        struct timeval *timeout)
@@ -118,6 +118,9 @@ void lwip_platform_assert(char const* msg, char const *file, int line);
 void  genode_memcpy( void *dst, const void *src, size_t len);
 void *genode_memmove(void *dst, const void *src, size_t len);
 
+genode_uint16_t genode_chksum(const void *data, int len);
+genode_uint16_t genode_chksum_copy(void *dst, const void *src, genode_uint16_t len);
+
 void  genode_free(void *ptr);
 void *genode_malloc(unsigned long size);
 void *genode_calloc(unsigned long number, unsigned long size);
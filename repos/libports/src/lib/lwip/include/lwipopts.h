@@ -55,6 +55,11 @@ extern "C" {
 /* checksum calculation for outgoing packets can be disabled if the hardware supports it */
 #define LWIP_CHECKSUM_ON_COPY       1  /* calculate checksum during memcpy */
 
+/* use the word-wise implementation of Genode's net library */
+#define LWIP_CHKSUM                 genode_chksum
+#define LWIP_CHKSUM_COPY_ALGORITHM  0
+#define LWIP_CHKSUM_COPY(dst,src,len)   genode_chksum_copy(dst,src,len)
+
 /*********************
  ** Memory settings **
  *********************/
@@ -43,6 +43,8 @@ extern "C" {
 #include <lwip/init.h>
 #include <lwip/dhcp.h>
 #include <lwip/dns.h>
+#include <lwip/prot/ip4.h>
+#include <lwip/prot/udp.h>
 }
 
 	class Nic_netif;
@@ -50,6 +52,7 @@ extern "C" {
 	extern "C" {
 
 		static void nic_netif_pbuf_free(pbuf *p);
+		static void nic_netif_tx_pbuf_free(pbuf *p);
 		static err_t nic_netif_init(struct netif *netif);
 		static err_t nic_netif_linkoutput(struct netif *netif, struct pbuf *p);
 		static void  nic_netif_status_callback(struct netif *netif);
@@ -70,6 +73,42 @@ extern "C" {
 			p.custom_free_function = nic_netif_pbuf_free;
 		}
 	};
+
+	/**
+	 * Metadata for pbufs allocated within the Nic transmit buffer
+	 *
+	 * While submitted to the Nic server, the pbuf is referenced on behalf of
+	 * the server and linked into the list of packets in flight.
+	 */
+	struct Nic_netif_tx_pbuf
+	{
+		struct pbuf_custom p { };
+		Nic_netif &netif;
+		Nic::Packet_descriptor packet;
+
+		Nic_netif_tx_pbuf *next_in_flight = nullptr;
+		bool               in_flight      = false;
+
+		Nic_netif_tx_pbuf(Nic_netif &nic, Nic::Packet_descriptor &pkt)
+		: netif(nic), packet(pkt)
+		{
+			p.custom_free_function = nic_netif_tx_pbuf_free;
+		}
+
+		bool contains(Nic::Packet_descriptor const &pkt) const
+		{
+			return pkt.offset() >= packet.offset()
+			    && pkt.offset() <  packet.offset() + packet.size();
+		}
+
+		private:
+
+			/*
+			 * Noncopyable
+			 */
+			Nic_netif_tx_pbuf(Nic_netif_tx_pbuf const &);
+			Nic_netif_tx_pbuf &operator = (Nic_netif_tx_pbuf const &);
+	};
 }
 
 
@@ -97,6 +136,11 @@ class Lwip::Nic_netif
 
 		Genode::Tslab<Nic_netif_pbuf, 1024*sizeof(Nic_netif_pbuf)> _pbuf_alloc;
 
+		Genode::Tslab<Nic_netif_tx_pbuf, 128*sizeof(Nic_netif_tx_pbuf)> _tx_pbuf_alloc;
+
+		/* pbufs submitted to the Nic server without copying */
+		Nic_netif_tx_pbuf *_tx_in_flight = nullptr;
+
 		Nic::Packet_allocator _nic_tx_alloc;
 		Nic::Connection _nic;
 
@@ -112,6 +156,66 @@ class Lwip::Nic_netif
 
 		bool _dhcp { false };
 
+		/*
+		 * Space reserved in front of the payload of a transmit pbuf for
+		 * the headers prepended by the lower protocol layers
+		 */
+		enum { TX_HEADROOM = PBUF_TRANSPORT };
+
+		/**
+		 * Return transmit pbuf at the end of chain 'p' if submittable as is
+		 */
+		Nic_netif_tx_pbuf *_submittable_tx_pbuf(struct pbuf *p)
+		{
+			struct pbuf *last = p;
+			while (last->next)
+				last = last->next;
+
+			if (!(last->flags & PBUF_FLAG_IS_CUSTOM))
+				return nullptr;
+
+			if (((pbuf_custom *)last)->custom_free_function != nic_netif_tx_pbuf_free)
+				return nullptr;
+
+			Nic_netif_tx_pbuf &tx_pbuf = *reinterpret_cast<Nic_netif_tx_pbuf *>(last);
+			if (&tx_pbuf.netif != this || tx_pbuf.in_flight)
+				return nullptr;
+
+			/* the headers must fit into the headroom in front of the payload */
+			char const * const content = _nic.tx()->packet_content(tx_pbuf.packet);
+			char const * const payload = (char const *)last->payload;
+			size_t       const head    = p->tot_len - last->len;
+
+			if (payload < content + head
+			 || payload + last->len > content + tx_pbuf.packet.size())
+				return nullptr;
+
+			return &tx_pbuf;
+		}
+
+		/**
+		 * Release packet acknowledged by the Nic server
+		 */
+		void _release_acked_packet(Nic::Packet_descriptor const &packet)
+		{
+			Nic_netif_tx_pbuf **link = &_tx_in_flight;
+			for (; *link; link = &(*link)->next_in_flight)
+				if ((*link)->contains(packet))
+					break;
+
+			if (!*link) {
+				_nic.tx()->release_packet(packet);
+				return;
+			}
+
+			/* drop reference held on behalf of the Nic server */
+			Nic_netif_tx_pbuf &tx_pbuf = **link;
+			*link = tx_pbuf.next_in_flight;
+			tx_pbuf.next_in_flight = nullptr;
+			tx_pbuf.in_flight      = false;
+			pbuf_free(&tx_pbuf.p.pbuf);
+		}
+
 	public:
 
 		void free_pbuf(Nic_netif_pbuf &pbuf)
@@ -130,6 +234,48 @@ class Lwip::Nic_netif
 			destroy(_pbuf_alloc, &pbuf);
 		}
 
+		void free_tx_pbuf(Nic_netif_tx_pbuf &tx_pbuf)
+		{
+			_nic.tx()->release_packet(tx_pbuf.packet);
+			destroy(_tx_pbuf_alloc, &tx_pbuf);
+		}
+
+		/**
+		 * Allocate pbuf within the transmit buffer of the Nic session
+		 *
+		 * The payload is preceded by headroom for the protocol headers,
+		 * which enables 'linkoutput' to submit the frame without copying
+		 * the payload.
+		 *
+		 * \param length  payload size of a UDP datagram
+		 *
+		 * \return  pbuf, or nullptr if the datagram would not fit into a
+		 *          single IPv4 packet of MTU size or the transmit buffer is
+		 *          exhausted
+		 */
+		struct pbuf *alloc_tx_pbuf(u16_t length)
+		{
+			if (length + IP_HLEN + UDP_HLEN > _netif.mtu)
+				return nullptr;
+
+			auto &tx = *_nic.tx();
+
+			Nic::Packet_descriptor packet;
+			try { packet = tx.alloc_packet(TX_HEADROOM + length); }
+			catch (...) { return nullptr; }
+
+			Nic_netif_tx_pbuf *tx_pbuf = nullptr;
+			try { tx_pbuf = new (_tx_pbuf_alloc) Nic_netif_tx_pbuf(*this, packet); }
+			catch (...) {
+				tx.release_packet(packet);
+				return nullptr;
+			}
+
+			return pbuf_alloced_custom(PBUF_RAW, length, PBUF_REF, &tx_pbuf->p,
+			                           tx.packet_content(packet) + TX_HEADROOM,
+			                           length);
+		}
+
 
 		/*************************
 		 ** Nic signal handlers **
@@ -203,7 +349,7 @@ class Lwip::Nic_netif
 
 			/* flush acknowledgements */
 			while (tx.ack_avail()) {
-				tx.release_packet(tx.try_get_acked_packet());
+				_release_acked_packet(tx.try_get_acked_packet());
 				_tx_saturated = false;
 				progress = true;
 			}
@@ -278,7 +424,7 @@ class Lwip::Nic_netif
 		:
 			_ep(env.ep()),
 			_wakeup_scheduler(wakeup_scheduler),
-			_pbuf_alloc(alloc), _nic_tx_alloc(&alloc),
+			_pbuf_alloc(alloc), _tx_pbuf_alloc(alloc), _nic_tx_alloc(&alloc),
 			_nic(env, &_nic_tx_alloc,
 			     BUF_SIZE, BUF_SIZE,
 			     config.attribute_value("label", Genode::String<160>("lwip")).string()),
@@ -378,7 +524,7 @@ class Lwip::Nic_netif
 
 			/* flush acknowledgements */
 			while (tx.ack_avail()) {
-				tx.release_packet(tx.get_acked_packet());
+				_release_acked_packet(tx.get_acked_packet());
 				_tx_saturated = false;
 			}
 
@@ -388,6 +534,37 @@ class Lwip::Nic_netif
 				return ERR_WOULDBLOCK;
 			}
 
+			/*
+			 * If the payload resides in the transmit buffer already, only
+			 * the headers are copied in front of it. The pbuf is referenced
+			 * until the Nic server acknowledges the packet.
+			 */
+			if (Nic_netif_tx_pbuf *tx_pbuf = _submittable_tx_pbuf(p)) {
+
+				struct pbuf &last = tx_pbuf->p.pbuf;
+				char *dst = (char *)last.payload - (p->tot_len - last.len);
+
+				Genode::off_t const offset = tx_pbuf->packet.offset()
+					+ (Genode::off_t)(dst - tx.packet_content(tx_pbuf->packet));
+
+				Nic::Packet_descriptor const packet(offset, p->tot_len);
+
+				for (struct pbuf *q = p; q != &last; q = q->next) {
+					Genode::memcpy(dst, q->payload, q->len);
+					dst += q->len;
+				}
+
+				pbuf_ref(&last);
+				tx_pbuf->in_flight      = true;
+				tx_pbuf->next_in_flight = _tx_in_flight;
+				_tx_in_flight           = tx_pbuf;
+
+				tx.try_submit_packet(packet);
+				_wakeup_scheduler.schedule_nic_server_wakeup();
+				LINK_STATS_INC(link.xmit);
+				return ERR_OK;
+			}
+
 			Nic::Packet_descriptor packet;
 			try { packet = tx.alloc_packet(p->tot_len); }
 			catch (...) {
@@ -447,6 +624,16 @@ static void nic_netif_pbuf_free(pbuf *p)
 }
 
 
+/**
+ * Free a pbuf allocated within the Nic transmit buffer
+ */
+static void nic_netif_tx_pbuf_free(pbuf *p)
+{
+	Nic_netif_tx_pbuf *tx_pbuf = reinterpret_cast<Nic_netif_tx_pbuf*>(p);
+	tx_pbuf->netif.free_tx_pbuf(*tx_pbuf);
+}
+
+
 /**
  * Initialize the netif
  */
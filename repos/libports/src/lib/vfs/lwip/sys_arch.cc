@@ -16,6 +16,7 @@
 #include <timer_session/connection.h>
 #include <util/reconstructible.h>
 #include <base/sleep.h>
+#include <net/internet_checksum.h>
 
 #include <lwip_genode_init.h>
 
@@ -107,6 +108,23 @@ extern "C" {
 	void *genode_memmove(void *dst, const void *src, size_t len) {
 		return Genode::memmove(dst, src, len); }
 
+	/*
+	 * In contrast to the functions of the net library, lwIP expects the
+	 * checksum functions to return the sum without the one's complement
+	 */
+
+	genode_uint16_t genode_chksum(const void *data, int len)
+	{
+		return (genode_uint16_t)~Net::internet_checksum(
+			(Net::Packed_uint16 const *)data, (Genode::size_t)len);
+	}
+
+	genode_uint16_t genode_chksum_copy(void *dst, const void *src, genode_uint16_t len)
+	{
+		return (genode_uint16_t)~Net::copy_and_checksum(
+			dst, (Net::Packed_uint16 const *)src, len);
+	}
+
 	int memcmp(const void *b1, const void *b2, ::size_t len) {
 		return Genode::memcmp(b1, b2, len); }
 
@@ -541,6 +541,7 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		Genode::Allocator  &_alloc;
 		Genode::Entrypoint &_ep;
 		Vfs::Env::User     &_vfs_user;
+		Nic_netif          &_netif;
 
 		Genode::List<SOCKET_DIR> _socket_dirs { };
 
@@ -552,8 +553,11 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		friend class Tcp_socket_dir;
 		friend class Udp_socket_dir;
 
-		Protocol_dir_impl(Vfs::Env &env)
-		: _alloc(env.alloc()), _ep(env.env().ep()), _vfs_user(env.user()) { }
+		Protocol_dir_impl(Vfs::Env &env, Nic_netif &netif)
+		:
+			_alloc(env.alloc()), _ep(env.env().ep()), _vfs_user(env.user()),
+			_netif(netif)
+		{ }
 
 		SOCKET_DIR *lookup(char const *name)
 		{
@@ -992,8 +996,19 @@ class Lwip::Udp_socket_dir final :
 				size_t      remain  = src.num_bytes;
 
 				while (remain) {
-					pbuf * const buf = pbuf_alloc(PBUF_RAW, remain, PBUF_RAM);
-					pbuf_take(buf, src_ptr, buf->tot_len);
+					u16_t const len = (u16_t)min(remain, (size_t)0xffff);
+
+					/*
+					 * Place the payload directly into the Nic transmit buffer
+					 * if it fits into a single frame
+					 */
+					pbuf *buf = _proto_dir._netif.alloc_tx_pbuf(len);
+					if (!buf)
+						buf = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
+					if (!buf)
+						return Write_result::WRITE_ERR_WOULD_BLOCK;
+
+					pbuf_take(buf, src_ptr, len);
 
 					err_t err = udp_sendto(_pcb, buf, &_to_addr, _to_port);
 					pbuf_free(buf);
@@ -1001,8 +1016,8 @@ class Lwip::Udp_socket_dir final :
 						return Write_result::WRITE_ERR_WOULD_BLOCK;
 					else if (err != ERR_OK)
 						return Write_result::WRITE_ERR_IO;
-					remain  -= buf->tot_len;
-					src_ptr += buf->tot_len;
+					remain  -= len;
+					src_ptr += len;
 				}
 				out_count = src.num_bytes;
 				return Write_result::WRITE_OK;
@@ -1761,8 +1776,8 @@ class Lwip::File_system final : public Vfs::File_system, public Lwip::Directory,
 		{
 			Vfs::Env &_vfs_env;
 
-			Tcp_proto_dir tcp_dir { _vfs_env };
-			Udp_proto_dir udp_dir { _vfs_env };
+			Tcp_proto_dir tcp_dir { _vfs_env, *this };
+			Udp_proto_dir udp_dir { _vfs_env, *this };
 
 			Nameserver_registry nameserver_handles { };
 
@@ -0,0 +1,171 @@
+/*
+ * \brief  Test of kqueue/kevent with many pipes
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test creates a large number of pipes and repeatedly makes one of them
+ * readable by writing a byte. It measures the time until the readiness is
+ * observed via 'kevent' and via 'select' for an increasing number of
+ * watched pipes. The latency of 'kevent' should not depend on the number of
+ * pipes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/select.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+enum {
+	MAX_PIPES = 480,  /* two fds per pipe, limited by the fd allocator */
+	ROUNDS    = 2000,
+};
+
+static int read_fds[MAX_PIPES], write_fds[MAX_PIPES];
+
+
+static unsigned long now_us()
+{
+	struct timespec tp { };
+	clock_gettime(CLOCK_MONOTONIC, &tp);
+	return tp.tv_sec*1000*1000 + tp.tv_nsec/1000;
+}
+
+
+static void fail(char const *msg)
+{
+	printf("Error: %s\n", msg);
+	exit(-1);
+}
+
+
+static unsigned pipe_of_round(unsigned round, unsigned num_pipes)
+{
+	return (round*7919) % num_pipes;
+}
+
+
+static void make_readable(unsigned i)
+{
+	char const c = 'x';
+	if (write(write_fds[i], &c, 1) != 1)
+		fail("write to pipe failed");
+}
+
+
+static void consume(unsigned i)
+{
+	char c = 0;
+	if (read(read_fds[i], &c, 1) != 1)
+		fail("read from pipe failed");
+}
+
+
+static unsigned long measure_kevent(unsigned num_pipes)
+{
+	int const kq = kqueue();
+	if (kq < 0)
+		fail("kqueue failed");
+
+	for (unsigned i = 0; i < num_pipes; i++) {
+		struct kevent change;
+		EV_SET(&change, read_fds[i], EVFILT_READ, EV_ADD, 0, 0, (void *)(long)i);
+		if (kevent(kq, &change, 1, nullptr, 0, nullptr) != 0)
+			fail("registration of kevent filter failed");
+	}
+
+	unsigned long const start_us = now_us();
+
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		unsigned const i = pipe_of_round(round, num_pipes);
+
+		make_readable(i);
+
+		struct kevent event;
+		if (kevent(kq, nullptr, 0, &event, 1, nullptr) != 1)
+			fail("kevent returned no event");
+
+		if ((long)event.udata != (long)i || (int)event.ident != read_fds[i])
+			fail("kevent reported unexpected file descriptor");
+
+		consume(i);
+	}
+
+	unsigned long const duration_us = now_us() - start_us;
+
+	close(kq);
+	return duration_us;
+}
+
+
+static unsigned long measure_select(unsigned num_pipes)
+{
+	int nfds = 0;
+	for (unsigned i = 0; i < num_pipes; i++)
+		if (read_fds[i] + 1 > nfds)
+			nfds = read_fds[i] + 1;
+
+	unsigned long const start_us = now_us();
+
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		unsigned const i = pipe_of_round(round, num_pipes);
+
+		make_readable(i);
+
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		for (unsigned j = 0; j < num_pipes; j++)
+			FD_SET(read_fds[j], &readfds);
+
+		if (select(nfds, &readfds, nullptr, nullptr, nullptr) != 1)
+			fail("select returned unexpected number of ready fds");
+
+		if (!FD_ISSET(read_fds[i], &readfds))
+			fail("select reported unexpected file descriptor");
+
+		consume(i);
+	}
+
+	return now_us() - start_us;
+}
+
+
+int main(int, char **)
+{
+	for (unsigned i = 0; i < MAX_PIPES; i++) {
+		int fds[2];
+		if (pipe(fds) != 0)
+			fail("pipe creation failed");
+		read_fds[i]  = fds[0];
+		write_fds[i] = fds[1];
+	}
+
+	for (unsigned num_pipes = 15; num_pipes <= MAX_PIPES; num_pipes *= 2) {
+
+		unsigned long const kevent_us = measure_kevent(num_pipes);
+		unsigned long const select_us = measure_select(num_pipes);
+
+		printf("pipes: %3u  wakeup latency kevent: %lu us  select: %lu us\n",
+		       num_pipes, kevent_us/ROUNDS, select_us/ROUNDS);
+	}
+
+	for (unsigned i = 0; i < MAX_PIPES; i++) {
+		close(read_fds[i]);
+		close(write_fds[i]);
+	}
+
+	printf("--- kqueue test finished ---\n");
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * \brief  Benchmark of malloc and free by concurrent threads
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Each thread performs a random sequence of allocations and deallocations
+ * of small blocks. A part of the blocks is handed over to the neighbouring
+ * thread, which frees them. The duration is measured for an increasing
+ * number of threads. With scalable allocation, the duration should stay
+ * about the same as long as there are enough CPUs.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+enum {
+	MAX_THREADS = 16,
+	ROUNDS      = 200000,
+	LIVE_BLOCKS = 256,
+	HANDOVERS   = 64,
+};
+
+
+static unsigned long now_us()
+{
+	struct timespec tp { };
+	clock_gettime(CLOCK_MONOTONIC, &tp);
+	return tp.tv_sec*1000*1000 + tp.tv_nsec/1000;
+}
+
+
+struct Worker
+{
+	pthread_t     thread { };
+	unsigned      seed   { 0 };
+	unsigned long freed_remote { 0 };
+
+	/* blocks allocated by the neighbour, to be freed by this worker */
+	void * volatile handover[HANDOVERS] { };
+
+	void *live[LIVE_BLOCKS] { };
+
+	Worker *neighbour { nullptr };
+
+	unsigned random()
+	{
+		seed = seed*1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	void run()
+	{
+		for (unsigned i = 0; i < ROUNDS; i++) {
+
+			unsigned const r    = random();
+			size_t   const size = 8 + (r >> 8) % 1024;
+			void   *&slot       = live[r % LIVE_BLOCKS];
+
+			free(slot);
+			slot = malloc(size);
+			if (!slot) {
+				printf("Error: allocation of %zu bytes failed\n", size);
+				exit(-1);
+			}
+			memset(slot, 0, 8);
+
+			/* pass a block to the neighbour, free the ones passed to us */
+			if ((r & 15) == 0) {
+				void *block = malloc(size);
+				void *old   = __atomic_exchange_n(&neighbour->handover[r % HANDOVERS],
+				                                  block, __ATOMIC_ACQ_REL);
+				free(old);
+			}
+			void *passed = __atomic_exchange_n(&handover[i % HANDOVERS],
+			                                   nullptr, __ATOMIC_ACQ_REL);
+			if (passed) {
+				free(passed);
+				freed_remote++;
+			}
+		}
+
+		for (void *&block : live) {
+			free(block);
+			block = nullptr;
+		}
+	}
+
+	static void *entry(void *arg)
+	{
+		((Worker *)arg)->run();
+		return nullptr;
+	}
+};
+
+
+static Worker workers[MAX_THREADS];
+
+
+static void measure(unsigned num_threads)
+{
+	for (unsigned i = 0; i < num_threads; i++) {
+		workers[i].seed      = i + 1;
+		workers[i].neighbour = &workers[(i + 1) % num_threads];
+	}
+
+	unsigned long const start_us = now_us();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		if (pthread_create(&workers[i].thread, nullptr, Worker::entry, &workers[i])) {
+			printf("Error: pthread_create failed\n");
+			exit(-1);
+		}
+
+	unsigned long freed_remote = 0;
+	for (unsigned i = 0; i < num_threads; i++) {
+		pthread_join(workers[i].thread, nullptr);
+		freed_remote += workers[i].freed_remote;
+	}
+
+	unsigned long const duration_us = now_us() - start_us;
+
+	/* release blocks still in transit */
+	for (unsigned i = 0; i < num_threads; i++)
+		for (void * volatile &block : workers[i].handover) {
+			free(block);
+			block = nullptr;
+		}
+
+	printf("threads: %2u  rounds per thread: %u  remote frees: %lu  "
+	       "duration: %lu ms  ns per round: %lu\n",
+	       num_threads, (unsigned)ROUNDS, freed_remote, duration_us/1000,
+	       duration_us*1000/((unsigned long)ROUNDS*num_threads));
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned max_threads = (argc > 1) ? (unsigned)atoi(argv[1]) : 4;
+	if (max_threads < 1 || max_threads > MAX_THREADS)
+		max_threads = 4;
+
+	for (unsigned num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+		measure(num_threads);
+
+	printf("--- malloc benchmark finished ---\n");
+	return 0;
+}
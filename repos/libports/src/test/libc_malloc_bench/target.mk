@@ -0,0 +1,3 @@
+TARGET = test-libc_malloc_bench
+SRC_CC = main.cc
+LIBS   = posix
@@ -31,4 +31,71 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/**
+ * Mix row of RGB888 pixels with source pixels of individual alpha values
+ *
+ * \param dst    destination pixels
+ * \param src    source pixels
+ * \param alpha  alpha value of each source pixel
+ * \param n      number of pixels
+ *
+ * The result equals 'Pixel_rgb888::mix(dst, src, alpha + 1)' for each pixel.
+ * Destination pixels with a corresponding alpha value of zero stay untouched.
+ */
+extern "C" void blend_rgb888(void *dst, void const *src,
+                             unsigned char const *alpha, unsigned n);
+
+
+/**
+ * Mix row of RGB888 pixels with a uniform color
+ *
+ * \param color  RGB888 pixel value of the color
+ * \param alpha  alpha value of the color, 0...255
+ *
+ * The result equals 'Pixel_rgb888::mix(dst, color, alpha)' for each pixel.
+ */
+extern "C" void blend_rgb888_color(void *dst, unsigned color, int alpha,
+                                   unsigned n);
+
+
+/**
+ * Convert row of RGB565 pixels to RGB888 pixels
+ */
+extern "C" void convert_rgb565_to_rgb888(void *dst, void const *src,
+                                         unsigned n);
+
+
+/**
+ * Convert row of RGB888 pixels to RGB565 pixels
+ */
+extern "C" void convert_rgb888_to_rgb565(void *dst, void const *src,
+                                         unsigned n);
+
+
+/**
+ * Instruction-set variants of the blitting and blending kernels
+ *
+ * By default, the library uses the most capable variant supported by the
+ * CPU. 'BLIT_ISA_GENERIC' refers to the baseline implementation of the
+ * architecture.
+ */
+enum Blit_isa { BLIT_ISA_GENERIC, BLIT_ISA_SSE2, BLIT_ISA_AVX2, BLIT_ISA_NEON };
+
+
+/**
+ * Return instruction-set variant currently used by the kernels
+ */
+extern "C" enum Blit_isa blit_isa(void);
+
+
+/**
+ * Select instruction-set variant used by the kernels
+ *
+ * \return  false if the variant is not supported by the CPU
+ *
+ * This function is meant for benchmarking the variants against each other.
+ */
+extern "C" bool blit_select_isa(enum Blit_isa isa);
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
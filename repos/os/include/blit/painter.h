@@ -16,6 +16,8 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Blit_painter
@@ -54,6 +56,51 @@ struct Blit_painter
 
 		surface.flush_pixels(clipped);
 	}
+
+
+	static inline void _convert_row(Genode::Pixel_rgb888       *dst,
+	                                Genode::Pixel_rgb565 const *src, unsigned n)
+	{
+		convert_rgb565_to_rgb888(dst, src, n);
+	}
+
+	static inline void _convert_row(Genode::Pixel_rgb565       *dst,
+	                                Genode::Pixel_rgb888 const *src, unsigned n)
+	{
+		convert_rgb888_to_rgb565(dst, src, n);
+	}
+
+
+	/**
+	 * Paint texture of a different pixel format
+	 *
+	 * Supported are the conversions between RGB565 and RGB888.
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void paint(Genode::Surface<DST_PT>       &surface,
+	                         Genode::Texture<SRC_PT> const &texture,
+	                         Point                          position)
+	{
+		Rect const clipped = Rect::intersect(Rect(position, texture.size()),
+		                                     surface.clip());
+
+		if (!clipped.valid())
+			return;
+
+		int const src_w = texture.size().w();
+		int const dst_w = surface.size().w();
+
+		unsigned long const tex_start_offset = (clipped.y1() - position.y())*src_w
+		                                     +  clipped.x1() - position.x();
+
+		SRC_PT const *src = texture.pixel() + tex_start_offset;
+		DST_PT       *dst = surface.addr() + clipped.y1()*dst_w + clipped.x1();
+
+		for (unsigned h = clipped.h(); h--; src += src_w, dst += dst_w)
+			_convert_row(dst, src, clipped.w());
+
+		surface.flush_pixels(clipped);
+	}
 };
 
 #endif /* _INCLUDE__BLIT__PAINTER_H_ */
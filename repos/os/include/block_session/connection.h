@@ -46,6 +46,8 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 
 		typedef Genode::size_t size_t;
 
+		typedef Packet_descriptor::Payload Payload;
+
 	private:
 
 		/*
@@ -60,8 +62,6 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 
 		typedef Genode::Id_space<_JOB> Tag_id_space;
 
-		typedef Packet_descriptor::Payload Payload;
-
 	public:
 
 		class Job : Genode::Noncopyable
@@ -86,6 +86,12 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 				 */
 				Payload _payload { };
 
+				/*
+				 * Payload provided by the creator of the job, which is
+				 * neither allocated nor released by the connection
+				 */
+				bool const _payload_provided = false;
+
 				bool _completed = false;
 
 				/*
@@ -111,17 +117,38 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 					if (!Operation::has_payload(_operation.type))
 						return _operation;
 
+					block_count_t const remaining = _operation.count - _position;
+
 					return {
 						.type         = _operation.type,
 						.block_number = _operation.block_number + _position,
-						.count        = Genode::min(_connection._max_block_count,
-						                            _operation.count - _position) };
+						.count        = _payload_provided
+						              ? remaining
+						              : Genode::min(_connection._max_block_count,
+						                            remaining) };
+				}
+
+				/*
+				 * A provided payload covers the entire operation, so the
+				 * remainder of a partially acknowledged operation starts
+				 * at the current position within the payload.
+				 */
+				Payload _curr_payload() const
+				{
+					if (!_payload_provided)
+						return _payload;
+
+					size_t const skip = _position * _connection._info.block_size;
+
+					return { .offset = _payload.offset + (off_t)skip,
+					         .bytes  = _payload.bytes - Genode::min(skip, _payload.bytes) };
 				}
 
 				template <typename FN>
 				static void _with_offset_and_length(Job &job, FN const &fn)
 				{
-					if (!Operation::has_payload(job._operation.type))
+					if (!Operation::has_payload(job._operation.type)
+					 || job._payload_provided)
 						return;
 
 					Operation const operation  = job._curr_operation();
@@ -139,7 +166,7 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 
 					Request::Tag const tag { _tag->id().value };
 
-					Packet_descriptor const p(_curr_operation(), _payload, tag);
+					Packet_descriptor const p(_curr_operation(), _curr_payload(), tag);
 
 					if (_operation.type == Operation::Type::WRITE)
 						_with_offset_and_length(job, [&] (off_t offset, size_t length) {
@@ -158,6 +185,30 @@ struct Block::Connection : Genode::Connection<Session>, Session_client
 					_connection._pending.enqueue(_pending_elem);
 				}
 
+				/**
+				 * Constructor
+				 *
+				 * \param payload  location of the data within the I/O buffer
+				 *                 of the connection
+				 *
+				 * This constructor allows for forwarding data without
+				 * copying it, given that the data already resides in the
+				 * I/O buffer. The payload must be large enough to hold the
+				 * data of the entire operation, which is submitted as a
+				 * single packet. If the server acknowledges only a part
+				 * of the operation, the remainder is submitted from the
+				 * corresponding position within the payload. The
+				 * 'produce_write_content' and 'consume_read_result' hooks
+				 * of the update-jobs policy are not called for such a job.
+				 */
+				Job(Connection &connection, Operation operation, Payload payload)
+				:
+					_connection(connection), _operation(operation),
+					_payload(payload), _payload_provided(true)
+				{
+					_connection._pending.enqueue(_pending_elem);
+				}
+
 				~Job()
 				{
 					if (pending()) {
@@ -378,6 +429,10 @@ bool Block::Connection<JOB>::_try_process_ack(POLICY &policy, Tx::Source &tx)
 			/* needed to access private members of 'Job' (friend) */
 			Job &job_base = job;
 
+			/* the job may be destructed by 'policy.completed' */
+			if (job_base._payload_provided)
+				release_packet = false;
+
 			bool const partial_read_or_write =
 				p.succeeded() &&
 				Operation::has_payload(type) &&
@@ -441,6 +496,11 @@ bool Block::Connection<JOB>::_try_submit_pending_job(POLICY &policy, Tx::Source
 			if (!Operation::has_payload(job._operation.type))
 				return;
 
+			if (job._payload_provided) {
+				payload = job._payload;
+				return;
+			}
+
 			size_t const bytes = _info.block_size * job._curr_operation().count;
 
 			payload = { .offset = tx.alloc_packet(bytes, (unsigned)_info.align_log2).offset(),
@@ -45,6 +45,19 @@ namespace Net {
 	Genode::uint16_t internet_checksum(Packed_uint16 const *data_ptr,
 	                                   Genode::size_t       data_sz);
 
+	/**
+	 * Copy data and compute its internet checksum in a single pass
+	 *
+	 * \param dst   destination of the copy, must not overlap 'src'
+	 * \param src   data to copy and checksum
+	 * \param size  number of bytes
+	 *
+	 * \return  same value as 'internet_checksum(src, size)'
+	 */
+	Genode::uint16_t copy_and_checksum(void                *dst,
+	                                   Packed_uint16 const *src,
+	                                   Genode::size_t       size);
+
 	Genode::uint16_t
 	internet_checksum_pseudo_ip(Packed_uint16 const   *data_ptr,
 	                            Genode::size_t         data_sz,
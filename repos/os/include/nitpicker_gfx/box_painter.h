@@ -14,13 +14,34 @@
 #ifndef _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 #define _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 
+#include <blit/blit.h>
 #include <os/surface.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Box_painter
 {
 	typedef Genode::Surface_base::Rect Rect;
 
+	/**
+	 * Mix row of pixels with color at the ratio 'alpha'
+	 */
+	template <typename PT>
+	static inline void _mix_row(PT *dst, PT pix, int alpha, int n)
+	{
+		for (; n--; dst++)
+			*dst = PT::mix(*dst, pix, alpha);
+	}
+
+	/**
+	 * Mix row of RGB888 pixels via the vectorized kernel of the blit library
+	 */
+	static inline void _mix_row(Genode::Pixel_rgb888 *dst,
+	                            Genode::Pixel_rgb888 pix, int alpha, int n)
+	{
+		blend_rgb888_color(dst, pix.pixel, alpha, (unsigned)n);
+	}
+
 	/**
 	 * Draw filled box
 	 *
@@ -47,9 +68,8 @@ struct Box_painter
 					*dst = pix;
 
 		else if (!color.transparent())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = PT::mix(*dst, pix, alpha);
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				_mix_row(dst_line, pix, alpha, clipped.w());
 
 		surface.flush_pixels(clipped);
 	}
@@ -16,6 +16,7 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Texture_painter
@@ -43,6 +44,31 @@ struct Texture_painter
 	typedef Genode::Surface_base::Rect  Rect;
 
 
+	/**
+	 * Mix row of texture pixels with alpha values into destination pixels
+	 */
+	template <typename PT>
+	static inline void _blend_row(PT *dst, PT const *src,
+	                              unsigned char const *alpha, int n)
+	{
+		for (; n--; src++, dst++, alpha++) {
+			unsigned char const alpha_value = *alpha;
+			if (__builtin_expect(alpha_value != 0, true))
+				*dst = PT::mix(*dst, *src, alpha_value + 1);
+		}
+	}
+
+	/**
+	 * Mix row of RGB888 pixels via the vectorized kernel of the blit library
+	 */
+	static inline void _blend_row(Genode::Pixel_rgb888 *dst,
+	                              Genode::Pixel_rgb888 const *src,
+	                              unsigned char const *alpha, int n)
+	{
+		blend_rgb888(dst, src, alpha, (unsigned)n);
+	}
+
+
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT>       &surface,
 	                         Genode::Texture<PT> const &texture,
@@ -75,9 +101,8 @@ struct Texture_painter
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
 		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		PT const *s;
+		PT       *d;
 
 		switch (mode) {
 
@@ -98,11 +123,7 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++) {
-					unsigned char const alpha_value = *a;
-					if (__builtin_expect(alpha_value != 0, true))
-						*d = PT::mix(*d, *s, alpha_value + 1);
-				}
+				_blend_row(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
@@ -170,6 +170,11 @@ class Genode::Packet_descriptor_queue
 			PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
 		};
 
+		enum { MASK = QUEUE_SIZE - 1 };
+
+		static_assert(QUEUE_SIZE > 1 && (QUEUE_SIZE & MASK) == 0,
+		              "packet-descriptor queue size must be a power of two");
+
 	public:
 
 		typedef PACKET_DESCRIPTOR Packet_descriptor;
@@ -203,11 +208,31 @@ class Genode::Packet_descriptor_queue
 		{
 			if (full()) return false;
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
+			_queue[_head & MASK] = packet;
+			_head = (_head + 1) & MASK;
 			return true;
 		}
 
+		/**
+		 * Place up to 'count' packet descriptors into queue
+		 *
+		 * The head index is published only once after all descriptors
+		 * are stored.
+		 *
+		 * \return number of packet descriptors added
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned count)
+		{
+			unsigned const head = _head;
+			unsigned const n    = Genode::min(count, slots_free());
+
+			for (unsigned i = 0; i < n; i++)
+				_queue[(head + i) & MASK] = packets[i];
+
+			_head = (head + n) & MASK;
+			return n;
+		}
+
 		/**
 		 * Take packet descriptor from queue
 		 *
@@ -215,17 +240,34 @@ class Genode::Packet_descriptor_queue
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			PACKET_DESCRIPTOR packet = _queue[_tail & MASK];
+			_tail = (_tail + 1) & MASK;
 			return packet;
 		}
 
+		/**
+		 * Take up to 'max_count' packet descriptors from queue
+		 *
+		 * \return number of packet descriptors stored at 'packets'
+		 */
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned max_count)
+		{
+			unsigned const tail = _tail;
+			unsigned const n    = Genode::min(max_count, slots_used());
+
+			for (unsigned i = 0; i < n; i++)
+				packets[i] = _queue[(tail + i) & MASK];
+
+			_tail = (tail + n) & MASK;
+			return n;
+		}
+
 		/**
 		 * Return current packet descriptor
 		 */
 		PACKET_DESCRIPTOR peek() const
 		{
-			return _queue[_tail%QUEUE_SIZE];
+			return _queue[_tail & MASK];
 		}
 
 		/**
@@ -236,25 +278,28 @@ class Genode::Packet_descriptor_queue
 		/**
 		 * Return true if packet-descriptor queue is full
 		 */
-		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
+		bool full() { return ((_head + 1) & MASK) == _tail; }
 
 		/**
 		 * Return true if a single element is stored in the queue
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
+		bool single_element() { return ((_tail + 1) & MASK) == _head; }
 
 
 		/**
 		 * Return true if a single slot is left to be put into the queue
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		bool single_slot_free() { return ((_head + 2) & MASK) == _tail; }
 
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free() { return (_tail - _head - 1) & MASK; }
+
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned slots_used() { return (_head - _tail) & MASK; }
 };
 
 
@@ -340,6 +385,28 @@ class Genode::Packet_descriptor_transmitter
 			return true;
 		}
 
+		/**
+		 * Transmit up to 'count' packets at once
+		 *
+		 * A wakeup is scheduled at most once per batch, namely if the queue
+		 * holds no other packets than the batch after the operation, i.e.,
+		 * the receiver may have found the queue empty.
+		 *
+		 * \return number of packets transmitted
+		 */
+		unsigned try_tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		                unsigned count)
+		{
+			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
+
+			unsigned const n = _tx_queue->add(packets, count);
+
+			if (n && _tx_queue->slots_used() <= n)
+				_tx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool tx_wakeup()
 		{
 			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
@@ -444,6 +511,28 @@ class Genode::Packet_descriptor_receiver
 			return packet;
 		}
 
+		/**
+		 * Receive up to 'max_count' packets at once
+		 *
+		 * A wakeup is scheduled at most once per batch, namely if no other
+		 * slots than the ones of the batch are free after the operation,
+		 * i.e., the transmitter may have found the queue full.
+		 *
+		 * \return number of packets stored at 'out_packets'
+		 */
+		unsigned try_rx(typename RX_QUEUE::Packet_descriptor *out_packets,
+		                unsigned max_count)
+		{
+			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
+
+			unsigned const n = _rx_queue->get(out_packets, max_count);
+
+			if (n && _rx_queue->slots_free() <= n)
+				_rx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool rx_wakeup(bool omit_signal)
 		{
 			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
@@ -795,6 +884,20 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Submit up to 'count' packets to the server at once
+		 *
+		 * \return number of packets submitted, which is lower than 'count'
+		 *         if the submit queue became congested
+		 *
+		 * This method never blocks. As with 'try_submit_packet', the sink
+		 * is signalled not before calling 'wakeup'.
+		 */
+		unsigned try_submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _submit_transmitter.try_tx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -838,6 +941,18 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _ack_receiver.try_rx();
 		}
 
+		/**
+		 * Obtain up to 'max_count' acknowledgements from sink at once
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_acked_packets(Packet_descriptor *packets, unsigned max_count)
+		{
+			return _ack_receiver.try_rx(packets, max_count);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -954,6 +1069,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.try_rx();
 		}
 
+		/**
+		 * Obtain up to 'max_count' packets from source at once
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_packets(Packet_descriptor *packets, unsigned max_count)
+		{
+			return _submit_receiver.try_rx(packets, max_count);
+		}
+
 		/**
 		 * Wake up the packet source if needed
 		 *
@@ -1024,6 +1151,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Acknowledge up to 'count' packets to the client at once
+		 *
+		 * \return number of packets acknowledged, which is lower than
+		 *         'count' if the acknowledgement queue became congested
+		 *
+		 * This method never blocks. As with 'try_ack_packet', the source
+		 * is signalled not before calling 'wakeup'.
+		 */
+		unsigned try_ack_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _ack_transmitter.try_tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -0,0 +1,194 @@
+/*
+ * \brief  Hash index of objects by their path
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__PATH_INDEX_H_
+#define _INCLUDE__OS__PATH_INDEX_H_
+
+#include <base/allocator.h>
+#include <util/string.h>
+
+namespace Genode { template <typename> class Path_index; }
+
+
+/**
+ * Index for looking up objects by their path in constant time
+ *
+ * \param T  type of indexed objects, must be inherited from 'Element'
+ *
+ * The index is meant for static path hierarchies like the content of an
+ * archive. Elements can be inserted but not removed. The index grows with
+ * the number of elements. The path of an element is referenced, not copied.
+ */
+template <typename T>
+class Genode::Path_index
+{
+	public:
+
+		/**
+		 * Return hash value of the first 'len' characters of 'path'
+		 */
+		static uint32_t hash(char const *path, size_t len)
+		{
+			/* FNV-1a */
+			uint32_t h = 2166136261u;
+			for (size_t i = 0; i < len && path[i]; i++)
+				h = (h ^ (uint8_t)path[i]) * 16777619u;
+			return h;
+		}
+
+		class Element
+		{
+			private:
+
+				friend class Path_index;
+
+				char const * const _path;
+				size_t       const _path_len;
+				uint32_t     const _hash;
+
+				Element *_next = nullptr;
+
+				bool _matches(char const *path, size_t len, uint32_t h) const
+				{
+					return h == _hash && len == _path_len
+					    && strcmp(path, _path, len) == 0;
+				}
+
+				/*
+				 * Noncopyable
+				 */
+				Element(Element const &);
+				Element &operator = (Element const &);
+
+			public:
+
+				/**
+				 * Constructor
+				 *
+				 * \param path  path of the element, must stay valid for the
+				 *              lifetime of the element
+				 * \param len   length of path without terminating zero
+				 */
+				Element(char const *path, size_t len)
+				:
+					_path(path), _path_len(len), _hash(hash(path, len))
+				{ }
+
+				char const *path() const { return _path; }
+		};
+
+	private:
+
+		static constexpr unsigned INITIAL_BUCKETS_LOG2 = 6;
+
+		Allocator &_alloc;
+
+		unsigned  _buckets_log2 = 0;
+		Element **_buckets      = nullptr;
+		size_t    _count        = 0;
+
+		size_t _num_buckets() const { return _buckets ? (size_t)1 << _buckets_log2 : 0; }
+
+		Element *&_bucket(uint32_t h) {
+			return _buckets[h & (((size_t)1 << _buckets_log2) - 1)]; }
+
+		/**
+		 * Rehash elements into twice the number of buckets
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void _grow()
+		{
+			size_t   const old_num  = _num_buckets();
+			Element ** const old    = _buckets;
+			unsigned const new_log2 = old ? _buckets_log2 + 1 : INITIAL_BUCKETS_LOG2;
+			size_t   const new_num  = (size_t)1 << new_log2;
+
+			Element **buckets = (Element **)_alloc.alloc(new_num*sizeof(Element *));
+			for (size_t i = 0; i < new_num; i++)
+				buckets[i] = nullptr;
+
+			_buckets      = buckets;
+			_buckets_log2 = new_log2;
+
+			for (size_t i = 0; i < old_num; i++) {
+				while (Element *e = old[i]) {
+					old[i] = e->_next;
+					e->_next = _bucket(e->_hash);
+					_bucket(e->_hash) = e;
+				}
+			}
+
+			if (old)
+				_alloc.free(old, old_num*sizeof(Element *));
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Path_index(Path_index const &);
+		Path_index &operator = (Path_index const &);
+
+	public:
+
+		Path_index(Allocator &alloc) : _alloc(alloc) { }
+
+		~Path_index()
+		{
+			if (_buckets)
+				_alloc.free(_buckets, _num_buckets()*sizeof(Element *));
+		}
+
+		/**
+		 * Insert element
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void insert(T &object)
+		{
+			if (_count >= _num_buckets())
+				_grow();
+
+			Element &e = object;
+			e._next = _bucket(e._hash);
+			_bucket(e._hash) = &e;
+			_count++;
+		}
+
+		/**
+		 * Return object for the first 'len' characters of 'path'
+		 *
+		 * \return  pointer to object, or nullptr if no object matches
+		 */
+		T *lookup(char const *path, size_t len) const
+		{
+			if (!_buckets)
+				return nullptr;
+
+			uint32_t const h = hash(path, len);
+
+			for (Element *e = _buckets[h & (((size_t)1 << _buckets_log2) - 1)]; e; e = e->_next)
+				if (e->_matches(path, len, h))
+					return static_cast<T *>(e);
+
+			return nullptr;
+		}
+
+		T *lookup(char const *path) const { return lookup(path, strlen(path)); }
+
+		size_t count() const { return _count; }
+};
+
+#endif /* _INCLUDE__OS__PATH_INDEX_H_ */
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014-2017 Genode Labs GmbH
+ * Copyright (C) 2014-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -16,8 +16,12 @@
 
 /* Genode includes */
 #include <util/reconstructible.h>
+#include <util/retry.h>
 #include <os/session_policy.h>
+#include <base/allocator.h>
 #include <base/attached_ram_dataspace.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -31,13 +35,183 @@ namespace Rom {
 	class Writer;
 	class Reader;
 	class Buffer;
+	class Snapshot;
+	class Snapshot_views;
 
-	typedef Genode::List<Module> Module_list;
-	typedef Genode::List<Reader> Reader_list;
-	typedef Genode::List<Writer> Writer_list;
+	typedef Genode::List<Module>   Module_list;
+	typedef Genode::List<Reader>   Reader_list;
+	typedef Genode::List<Writer>   Writer_list;
+	typedef Genode::List<Snapshot> Snapshot_list;
 }
 
 
+/**
+ * Facility for handing out read-only views of snapshots to ROM clients
+ *
+ * Each view is a managed dataspace that contains the snapshot's backing
+ * store as read-only attachment. Hence, a ROM client cannot modify the
+ * content observed by the other clients that share the same snapshot.
+ */
+class Rom::Snapshot_views : Genode::Noncopyable
+{
+	private:
+
+		Genode::Rm_connection _rm;
+
+	public:
+
+		Snapshot_views(Genode::Env &env) : _rm(env) { }
+
+		/**
+		 * Create read-only view of dataspace
+		 */
+		Genode::Capability<Genode::Region_map>
+		create(Genode::Dataspace_capability ds, size_t size)
+		{
+			using namespace Genode;
+
+			enum { UPGRADE_ATTEMPTS = 16U };
+
+			Capability<Region_map> const view = _rm.create(size);
+
+			Region_map_client map(view);
+
+			retry<Out_of_ram>(
+				[&] () {
+					retry<Out_of_caps>(
+						[&] () {
+							map.attach(ds, size, 0, false, (void *)0, false, false); },
+						[&] () { _rm.upgrade_caps(2); },
+						UPGRADE_ATTEMPTS);
+				},
+				[&] () { _rm.upgrade_ram(8*1024); },
+				UPGRADE_ATTEMPTS);
+
+			return view;
+		}
+
+		void destroy(Genode::Capability<Genode::Region_map> view)
+		{
+			_rm.destroy(view);
+		}
+};
+
+
+/**
+ * Immutable version of the content of a ROM module
+ *
+ * A snapshot is shared by all readers that obtained the module content while
+ * the snapshot was current. It is destroyed once it got replaced by a newer
+ * version and the last reader released it.
+ */
+class Rom::Snapshot : private Snapshot_list::Element
+{
+	private:
+
+		friend class Genode::List<Snapshot>;
+		friend class Module;
+
+		Attached_ram_dataspace _ds;
+
+		size_t           _size;
+		Genode::uint32_t _hash;
+
+		unsigned _users = 0;
+
+		Snapshot_views                        *_views = nullptr;
+		Genode::Capability<Genode::Region_map> _view { };
+
+		/*
+		 * Noncopyable
+		 */
+		Snapshot(Snapshot const &);
+		Snapshot &operator = (Snapshot const &);
+
+	public:
+
+		/**
+		 * Return FNV-1a hash of content
+		 */
+		static Genode::uint32_t hash(char const *src, size_t len)
+		{
+			Genode::uint32_t h = 2166136261u;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (Genode::uint8_t)src[i])*16777619u;
+
+			return h;
+		}
+
+		/**
+		 * Constructor
+		 *
+		 * The backing store is allocated with one byte in addition to the
+		 * content, which holds a terminating zero. This way, we do not need
+		 * to trust report clients to append a zero termination to textual
+		 * reports.
+		 */
+		Snapshot(Genode::Ram_allocator &ram, Genode::Region_map &rm,
+		         char const *src, size_t len, Genode::uint32_t hash)
+		:
+			_ds(ram, rm, len + 1), _size(len), _hash(hash)
+		{
+			Genode::memcpy(_ds.local_addr<char>(), src, len);
+			_ds.local_addr<char>()[len] = 0;
+		}
+
+		~Snapshot()
+		{
+			if (_views)
+				_views->destroy(_view);
+		}
+
+		bool equals(char const *src, size_t len, Genode::uint32_t hash) const
+		{
+			return len == _size && hash == _hash
+			    && !Genode::memcmp(_ds.local_addr<char const>(), src, len);
+		}
+
+		/**
+		 * Replace content in place, reusing the backing store
+		 *
+		 * This is possible only if no reader holds the snapshot and no
+		 * view of the snapshot was handed out.
+		 *
+		 * \return  false if the snapshot is in use or if the new content
+		 *          does not fit into the backing store
+		 */
+		bool replace(char const *src, size_t len, Genode::uint32_t hash)
+		{
+			if (_users || _views || len + 1 > _ds.size())
+				return false;
+
+			Genode::memcpy(_ds.local_addr<char>(), src, len);
+			_ds.local_addr<char>()[len] = 0;
+
+			_size = len;
+			_hash = hash;
+			return true;
+		}
+
+		char const *content() const { return _ds.local_addr<char const>(); }
+
+		size_t size() const { return _size; }
+
+		/**
+		 * Return read-only dataspace with the snapshot content
+		 *
+		 * The view is created on first use and shared by all readers.
+		 */
+		Genode::Dataspace_capability view(Snapshot_views &views)
+		{
+			if (!_views) {
+				_view  = views.create(_ds.cap(), _ds.size());
+				_views = &views;
+			}
+			return Genode::Region_map_client(_view).dataspace();
+		}
+};
+
+
 struct Rom::Writer : private Writer_list::Element, Interface
 {
 	friend class Genode::List<Writer>;
@@ -76,6 +250,18 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Obtain the current snapshot of the module content
+	 *
+	 * The snapshot stays valid until it is released via 'release_snapshot'.
+	 *
+	 * \return  snapshot, or nullptr if the module has no content or if the
+	 *          reader is not permitted to read it
+	 */
+	virtual Snapshot *acquire_snapshot(Reader const &reader) = 0;
+
+	virtual void release_snapshot(Snapshot &) = 0;
 };
 
 
@@ -137,6 +323,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		Name _name;
 
+		Genode::Allocator     &_alloc;
 		Genode::Ram_allocator &_ram;
 		Genode::Region_map    &_rm;
 
@@ -152,18 +339,32 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Current content
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * The content is not allocated from the heap but kept in the
+		 * dedicated dataspace of each snapshot. This allows for the immediate
+		 * release of the underlying backing store once a snapshot is not
+		 * used anymore.
 		 */
-		Constructible<Attached_ram_dataspace> _ds { };
+		Snapshot *_current = nullptr;
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Outdated snapshots still referenced by readers
 		 */
-		size_t _size = 0;
+		Snapshot_list _retired { };
+
+		void _retire_current()
+		{
+			if (!_current)
+				return;
+
+			if (_current->_users)
+				_retired.insert(_current);
+			else
+				Genode::destroy(_alloc, _current);
+
+			_current = nullptr;
+		}
 
 
 		/********************************
@@ -175,6 +376,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		/**
 		 * Constructor
 		 *
+		 * \param alloc         allocator for the snapshot meta data
 		 * \param ram           allocator for the module's backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
@@ -184,13 +386,14 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
 		 */
-		Module(Genode::Ram_allocator &ram,
+		Module(Genode::Allocator     &alloc,
+		       Genode::Ram_allocator &ram,
 		       Genode::Region_map    &rm,
 		       Name            const &name,
 		       Read_policy     const &read_policy,
 		       Write_policy    const &write_policy)
 		:
-			_name(name), _ram(ram), _rm(rm),
+			_name(name), _alloc(alloc), _ram(ram), _rm(rm),
 			_read_policy(read_policy), _write_policy(write_policy)
 		{ }
 
@@ -223,8 +426,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_retire_current();
 				_last_writer = nullptr;
 			}
 		}
@@ -258,36 +460,46 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 	public:
 
+		~Module()
+		{
+			_retire_current();
+
+			/* snapshots are released by the readers before */
+			while (Snapshot *s = _retired.first()) {
+				_retired.remove(s);
+				Genode::destroy(_alloc, s);
+			}
+		}
+
 		/**
 		 * Assign new content to the ROM module
 		 *
-		 * Called by report service when a new report comes in.
+		 * Called by report service when a new report comes in. A report
+		 * that repeats the current content of the same writer is dropped
+		 * without notifying the readers.
 		 */
 		void write_content(Writer const &writer, char const * const src, size_t const src_len)
 		{
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
+			Genode::uint32_t const hash = Snapshot::hash(src, src_len);
 
-			_last_writer = &writer;
+			if (_current && _last_writer == &writer
+			 && _current->equals(src, src_len, hash))
+				return;
 
 			/*
-			 * Realloc backing store if needed
-			 *
-			 * Take a terminating zero into account, which we append to each
-			 * report. This way, we do not need to trust report clients to
-			 * append a zero termination to textual reports.
+			 * Readers of the previous snapshot keep accessing it until they
+			 * obtain the new version. If no reader holds it, e.g., if the
+			 * readers copy the content, its backing store is reused.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
-
-			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			if (!_current || !_current->replace(src, src_len, hash)) {
+				_retire_current();
+				_current = new (_alloc) Snapshot(_ram, _rm, src, src_len, hash);
+			}
 
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			_last_writer = &writer;
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -305,20 +517,51 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!_current || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
 				return 0;
 
-			if (dst_len < _size)
+			size_t const size = _current->size();
+
+			if (dst_len < size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			Genode::memcpy(dst, _current->content(), size);
+			return size;
 		}
 
-		virtual size_t size() const override { return _size; }
+		virtual size_t size() const override { return _current ? _current->size() : 0; }
+
+		/**
+		 * Readable_module interface
+		 */
+		Snapshot *acquire_snapshot(Reader const &reader) override
+		{
+			if (!_current || !_last_writer)
+				return nullptr;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			_current->_users++;
+			return _current;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		void release_snapshot(Snapshot &snapshot) override
+		{
+			snapshot._users--;
+
+			if (&snapshot == _current || snapshot._users)
+				return;
+
+			_retired.remove(&snapshot);
+			Genode::destroy(_alloc, &snapshot);
+		}
 
 		Name name() const { return _name; }
 };
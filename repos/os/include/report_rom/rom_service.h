@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014-2017 Genode Labs GmbH
+ * Copyright (C) 2014-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -53,6 +53,31 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
+		/**
+		 * Facility for sharing snapshots, or nullptr if each client obtains
+		 * a private copy of the content
+		 */
+		Snapshot_views * const _views;
+
+		/**
+		 * Snapshot currently handed out to the client
+		 */
+		Snapshot *_snapshot = nullptr;
+
+		void _release_snapshot()
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 		/**
 		 * Size of content delivered to the client
 		 *
@@ -80,16 +105,26 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param views  facility for sharing the module content read-only
+		 *               among clients, or nullptr to hand out a private copy
+		 *               to each client
+		 */
 		Session_component(Genode::Ram_allocator &ram, Genode::Region_map &rm,
 		                  Registry_for_reader &registry,
-		                  Genode::Session_label const &label)
+		                  Genode::Session_label const &label,
+		                  Snapshot_views *views = nullptr)
 		:
 			_ram(ram), _rm(rm),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_views(views)
 		{ }
 
 		~Session_component()
 		{
+			_release_snapshot();
 			_registry.release(*this, _module);
 		}
 
@@ -99,9 +134,32 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
-			/* replace dataspace by new one */
+			bool const had_snapshot = (_snapshot != nullptr);
+
+			_release_snapshot();
+
+			/* hand out shared read-only snapshot of the module content */
+			if (_views) {
+				_snapshot = _module.acquire_snapshot(*this);
+				if (_snapshot) {
+					_ds.destruct();
+					_content_size   = _snapshot->size();
+					_client_version = _current_version;
+
+					return static_cap_cast<Rom_dataspace>(_snapshot->view(*_views));
+				}
+			}
+
+			/*
+			 * Replace dataspace by new one
+			 *
+			 * A client that obtained a snapshot before keeps a valid but empty
+			 * ROM if the content vanished, like a private copy that is cleared
+			 * in place by 'update'.
+			 */
 			/* XXX we could keep the old dataspace if the size fits */
-			_ds.construct(_ram, _rm, _module.size());
+			_ds.construct(_ram, _rm, had_snapshot ? max(_module.size(), (size_t)1)
+			                                      : _module.size());
 
 			/* fill dataspace content with report contained in module */
 			_content_size =
@@ -116,6 +174,22 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/*
+			 * A snapshot is immutable, so a new version requires the client
+			 * to request a new dataspace.
+			 */
+			if (_snapshot) {
+				Snapshot * const current = _module.acquire_snapshot(*this);
+				if (current)
+					_module.release_snapshot(*current);
+
+				if (current != _snapshot)
+					return false;
+
+				_client_version = _current_version;
+				return true;
+			}
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
@@ -174,6 +248,13 @@ class Rom::Root : public Genode::Root_component<Session_component>
 
 		Genode::Env         &_env;
 		Registry_for_reader &_registry;
+		Snapshot_views      *_views;
+
+		/*
+		 * Noncopyable
+		 */
+		Root(Root const &);
+		Root &operator = (Root const &);
 
 	protected:
 
@@ -182,17 +263,25 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_env.ram(), _env.rm(), _registry, label_from_args(args));
+				Session_component(_env.ram(), _env.rm(), _registry,
+				                  label_from_args(args), _views);
 		}
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param views  facility for sharing module snapshots among clients,
+		 *               or nullptr to hand out a private copy to each client
+		 */
 		Root(Genode::Env          &env,
 		     Genode::Allocator    &md_alloc,
-		     Registry_for_reader  &registry)
+		     Registry_for_reader  &registry,
+		     Snapshot_views       *views = nullptr)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _registry(registry)
+			_env(env), _registry(registry), _views(views)
 		{ }
 };
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2018 Genode Labs GmbH
+ * Copyright (C) 2018-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -29,6 +29,7 @@ class Trace_buffer
 		Genode::Trace::Buffer        &_buffer;
 		Entry                         _curr { Entry::invalid() };
 		unsigned long long            _lost_count { 0 };
+		Genode::size_t                _drained_bytes { 0 };
 
 	public:
 
@@ -45,6 +46,9 @@ class Trace_buffer
 			if (!_buffer.initialized())
 				return;
 
+			/* entries committed after this point are left for the next call */
+			size_t const committed_bytes = _buffer.committed_bytes();
+
 			bool lost = _buffer.lost_entries() != _lost_count;
 			if (lost) {
 				warning("lost ", _buffer.lost_entries() - _lost_count,
@@ -78,8 +82,29 @@ class Trace_buffer
 
 			/* remember the next to be processed entry in _curr */
 			if (update) _curr = entry;
+
+			if (update && entry.head())
+				_drained_bytes = committed_bytes;
+		}
+
+		/**
+		 * Return number of bytes committed since the buffer was drained
+		 *
+		 * The value is an estimate based on the sequence number maintained
+		 * by the producer. It allows for skipping idle buffers without
+		 * walking their entries.
+		 */
+		Genode::size_t pending_bytes() const
+		{
+			if (!_buffer.initialized())
+				return 0;
+
+			return Genode::min(_buffer.committed_bytes() - _drained_bytes,
+			                   _buffer.capacity());
 		}
 
+		Genode::size_t capacity() const { return _buffer.capacity(); }
+
 		void * address() const { return &_buffer; }
 
 		bool empty() const { return _curr.head(); }
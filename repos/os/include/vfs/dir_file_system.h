@@ -7,7 +7,7 @@
  */
 
 /*
- * Copyright (C) 2011-2019 Genode Labs GmbH
+ * Copyright (C) 2011-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -135,9 +135,208 @@ class Vfs::Dir_file_system : public File_system
 		};
 
 
+		/*
+		 * Lookup index of the child file systems
+		 *
+		 * A child file system that hosts a single node with a static name
+		 * needs to be consulted only for paths that start with this name.
+		 * For each such name, the index holds the ordered list of children
+		 * to consult, which comprises the children of the name and all
+		 * children with dynamic content. A path that starts with any other
+		 * name is passed to the children with dynamic content only. If there
+		 * are none, the lookup of a path not present in the static mount
+		 * tree fails without consulting any child.
+		 *
+		 * The index is rebuilt whenever the configuration is updated.
+		 */
+		class Mount_index
+		{
+			public:
+
+				struct Candidates
+				{
+					File_system * const *first;
+					unsigned             count;
+
+					File_system * const *begin() const { return first; }
+					File_system * const *end()   const { return first + count; }
+				};
+
+			private:
+
+				struct Entry
+				{
+					Entry             *next;  /* next entry of hash bucket */
+					char const * const name;
+					size_t       const name_len;
+					File_system      **fs;
+					unsigned           count = 0;
+
+					Entry(Entry *next, char const *name, size_t name_len,
+					      File_system **fs)
+					: next(next), name(name), name_len(name_len), fs(fs) { }
+
+					Entry(Entry const &) = delete;
+					Entry &operator = (Entry const &) = delete;
+				};
+
+				Genode::Allocator &_alloc;
+
+				File_system **_all         = nullptr;  /* all children in order */
+				unsigned      _num_all     = 0;
+				File_system **_dynamic     = nullptr;  /* children without name */
+				unsigned      _num_dynamic = 0;
+				Entry       **_buckets     = nullptr;
+				unsigned      _num_buckets = 0;
+
+				static unsigned long _hash(char const *name, size_t len)
+				{
+					/* FNV-1a */
+					unsigned long h = 2166136261ul;
+					for (size_t i = 0; i < len; i++)
+						h = (h ^ (unsigned char)name[i]) * 16777619ul;
+					return h;
+				}
+
+				Entry *&_bucket(char const *name, size_t len) const {
+					return _buckets[_hash(name, len) & (_num_buckets - 1)]; }
+
+				Entry *_lookup(char const *name, size_t len) const
+				{
+					for (Entry *e = _bucket(name, len); e; e = e->next)
+						if (e->name_len == len && !strcmp(e->name, name, len))
+							return e;
+
+					return nullptr;
+				}
+
+				File_system **_alloc_array(unsigned count) {
+					return (File_system **)_alloc.alloc((count ? count : 1)*sizeof(File_system *)); }
+
+				void _free_array(File_system **array, unsigned count) {
+					_alloc.free(array, (count ? count : 1)*sizeof(File_system *)); }
+
+				void _clear()
+				{
+					for (unsigned i = 0; i < _num_buckets; i++) {
+						while (Entry *e = _buckets[i]) {
+							_buckets[i] = e->next;
+							_free_array(e->fs, e->count);
+							destroy(_alloc, e);
+						}
+					}
+
+					if (_buckets) _alloc.free(_buckets, _num_buckets*sizeof(Entry *));
+					if (_dynamic) _free_array(_dynamic, _num_dynamic);
+					if (_all)     _free_array(_all, _num_all);
+
+					_all = _dynamic = nullptr;
+					_buckets = nullptr;
+					_num_all = _num_dynamic = _num_buckets = 0;
+				}
+
+				/*
+				 * Noncopyable
+				 */
+				Mount_index(Mount_index const &);
+				Mount_index &operator = (Mount_index const &);
+
+			public:
+
+				Mount_index(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+				~Mount_index() { _clear(); }
+
+				/**
+				 * Build index over the list of child file systems
+				 *
+				 * \throw Out_of_ram
+				 * \throw Out_of_caps
+				 */
+				void build(File_system *first)
+				{
+					_clear();
+
+					unsigned num_named = 0;
+					for (File_system *fs = first; fs; fs = fs->next) {
+						_num_all++;
+						if (fs->top_level_name()) num_named++;
+						else                      _num_dynamic++;
+					}
+
+					_all     = _alloc_array(_num_all);
+					_dynamic = _alloc_array(_num_dynamic);
+
+					_num_buckets = 1;
+					while (_num_buckets < 2*num_named)
+						_num_buckets <<= 1;
+
+					_buckets = (Entry **)_alloc.alloc(_num_buckets*sizeof(Entry *));
+					for (unsigned i = 0; i < _num_buckets; i++)
+						_buckets[i] = nullptr;
+
+					unsigned all = 0, dynamic = 0;
+					for (File_system *fs = first; fs; fs = fs->next) {
+						_all[all++] = fs;
+
+						char const * const name = fs->top_level_name();
+						if (!name) {
+							_dynamic[dynamic++] = fs;
+							continue;
+						}
+
+						size_t const len = strlen(name);
+						if (_lookup(name, len))
+							continue;
+
+						/* consult all children of the name and the dynamic ones */
+						unsigned count = 0;
+						for (File_system *f = first; f; f = f->next)
+							if (!f->top_level_name() || !strcmp(f->top_level_name(), name))
+								count++;
+
+						Entry *&bucket = _bucket(name, len);
+						Entry  &e = *new (_alloc)
+							Entry(bucket, name, len, _alloc_array(count));
+
+						for (File_system *f = first; f; f = f->next)
+							if (!f->top_level_name() || !strcmp(f->top_level_name(), name))
+								e.fs[e.count++] = f;
+
+						bucket = &e;
+					}
+				}
+
+				/**
+				 * Return child file systems to consult for 'path'
+				 *
+				 * \param path  path relative to the directory
+				 */
+				Candidates candidates(char const *path) const
+				{
+					if (path[0] == '/')
+						path++;
+
+					size_t len = 0;
+					while (path[len] && path[len] != '/')
+						len++;
+
+					/* the directory itself is looked up at all children */
+					if (len == 0 || !_num_buckets)
+						return { _all, _num_all };
+
+					if (Entry const * const e = _lookup(path, len))
+						return { e->fs, e->count };
+
+					return { _dynamic, _num_dynamic };
+				}
+		};
+
 		/* pointer to first child file system */
 		File_system *_first_file_system = nullptr;
 
+		Mount_index _mount_index { _env.alloc() };
+
 		/* add new file system to the list of children */
 		void _append_file_system(File_system *fs)
 		{
@@ -209,7 +408,7 @@ class Vfs::Dir_file_system : public File_system
 			 * Propagate the request into all of our file systems. If at least
 			 * one operation succeeds, we return success.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 
 				RES const err = fn(*fs, path);
 
@@ -268,7 +467,7 @@ class Vfs::Dir_file_system : public File_system
 		file_size _sum_dirents_of_file_systems(char const *path)
 		{
 			file_size cnt = 0;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 				cnt += fs->num_dirent(path);
 			}
 			return cnt;
@@ -407,6 +606,8 @@ class Vfs::Dir_file_system : public File_system
 					}
 				} catch (Xml_node::Nonexistent_attribute) { }
 			}
+
+			_mount_index.build(_first_file_system);
 		}
 
 		/*********************************
@@ -423,8 +624,7 @@ class Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 				Dataspace_capability ds = fs->dataspace(path);
 				if (ds.valid())
 					return ds;
@@ -439,7 +639,7 @@ class Vfs::Dir_file_system : public File_system
 			if (!path)
 				return;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			for (File_system *fs : _mount_index.candidates(path))
 				fs->release(path, ds_cap);
 		}
 
@@ -471,7 +671,7 @@ class Vfs::Dir_file_system : public File_system
 			 * The given path refers to one of our sub directories.
 			 * Propagate the request into our file systems.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 
 				Stat_result const err = fs->stat(path, out);
 
@@ -528,7 +728,7 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			for (File_system *fs : _mount_index.candidates(path))
 				if (fs->directory(path))
 					return true;
 
@@ -544,7 +744,7 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 				char const *leaf_path = fs->leaf_path(path);
 				if (leaf_path)
 					return leaf_path;
@@ -595,7 +795,7 @@ class Vfs::Dir_file_system : public File_system
 			}
 
 			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(path)) {
 
 				Open_result const err = fs->open(path, mode, out_handle, alloc);
 				switch (err) {
@@ -643,7 +843,7 @@ class Vfs::Dir_file_system : public File_system
 				res = OPENDIR_OK;
 			}
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				for (File_system *fs : _mount_index.candidates(sub_path)) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
 					Opendir_result r = fs->opendir(
@@ -790,7 +990,7 @@ class Vfs::Dir_file_system : public File_system
 			char const *sub_path = _sub_path(path);
 			if (!sub_path) return res;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _mount_index.candidates(sub_path)) {
 				Vfs_watch_handle *sub_handle;
 
 				if (fs->watch(sub_path, &sub_handle, alloc) == WATCH_OK) {
@@ -850,6 +1050,10 @@ class Vfs::Dir_file_system : public File_system
 			if (!to_path)
 				return RENAME_ERR_CROSS_FS;
 
+			/*
+			 * Consult all children because a child may deny the renaming
+			 * to its node.
+			 */
 			Rename_result final = RENAME_ERR_NO_ENTRY;
 			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
 				switch (fs->rename(from_path, to_path)) {
@@ -869,6 +1073,9 @@ class Vfs::Dir_file_system : public File_system
 		char const *name() const    { return "dir"; }
 		char const *type() override { return "dir"; }
 
+		char const *top_level_name() const override {
+			return _vfs_root ? nullptr : _name.string(); }
+
 		void apply_config(Genode::Xml_node const &node) override
 		{
 			using namespace Genode;
@@ -886,6 +1093,8 @@ class Vfs::Dir_file_system : public File_system
 
 				curr->apply_config(node.sub_node(i));
 			}
+
+			_mount_index.build(_first_file_system);
 		}
 
 
@@ -49,6 +49,17 @@ class Vfs::File_system : public Directory_service, public File_io_service
 		 * Return the file-system type
 		 */
 		virtual char const *type() = 0;
+
+		/**
+		 * Return name of the only node provided at the top level
+		 *
+		 * A file system that hosts a single node named by its static
+		 * configuration, e.g., a '<dir>' or '<rom>' node, returns the name
+		 * of this node. The enclosing directory can thereby skip the file
+		 * system when resolving paths that start with another name. A file
+		 * system with dynamic content returns nullptr.
+		 */
+		virtual char const *top_level_name() const { return nullptr; }
 };
 
 #endif /* _INCLUDE__VFS__FILE_SYSTEM_H_ */
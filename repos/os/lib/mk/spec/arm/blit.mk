@@ -1,5 +1,6 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc isa.cc
 REQUIRES = arm 32bit
-INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm
+INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc $(REP_DIR)/src/lib/blit
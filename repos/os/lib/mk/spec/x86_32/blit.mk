@@ -1,6 +1,7 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc isa.cc
 REQUIRES = x86 32bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_32 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc $(REP_DIR)/src/lib/blit
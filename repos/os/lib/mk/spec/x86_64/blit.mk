@@ -1,6 +1,14 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc isa.cc
 REQUIRES = x86 64bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+#
+# The AVX2 kernels pass 256-bit vectors between always-inlined functions only,
+# which renders the ABI warning about such vectors irrelevant.
+#
+CC_OPT_isa += -Wno-psabi
+
+vpath isa.cc $(REP_DIR)/src/lib/blit/spec/x86_64
+vpath %.cc   $(REP_DIR)/src/lib/blit
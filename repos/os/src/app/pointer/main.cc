@@ -95,8 +95,9 @@ class Pointer::Main : public Rom::Reader
 			_env.ep(), *this, &Main::_handle_xray };
 
 		Genode::Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
+		Genode::Heap        _heap        { _env.ram(), _env.rm() };
 
-		Rom::Registry _rom_registry { _sliced_heap, _env.ram(), _env.rm(), *this };
+		Rom::Registry _rom_registry { _heap, _env.ram(), _env.rm(), *this };
 
 		Report::Root _report_root { _env, _sliced_heap, _rom_registry, _verbose };
 
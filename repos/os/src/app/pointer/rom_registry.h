@@ -78,7 +78,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, session_label.prefix(), _read_write_policy,
+				Module(_md_alloc, _ram, _rm, session_label.prefix(), _read_write_policy,
 				       _read_write_policy);
 
 			_modules.insert(module);
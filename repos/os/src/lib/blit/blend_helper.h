@@ -0,0 +1,64 @@
+/*
+ * \brief  Generic blending and pixel-conversion utilities
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__BLEND_HELPER_H_
+#define _LIB__BLIT__BLEND_HELPER_H_
+
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+
+/**
+ * Mix row of pixels with source pixels of individual alpha values
+ */
+static inline void blend_rgb888_generic(Genode::Pixel_rgb888       *dst,
+                                        Genode::Pixel_rgb888 const *src,
+                                        unsigned char const        *alpha,
+                                        unsigned                    n)
+{
+	for (; n--; dst++, src++, alpha++)
+		if (*alpha)
+			*dst = Genode::Pixel_rgb888::mix(*dst, *src, *alpha + 1);
+}
+
+
+/**
+ * Mix row of pixels with a uniform color
+ */
+static inline void blend_rgb888_color_generic(Genode::Pixel_rgb888 *dst,
+                                              Genode::Pixel_rgb888  color,
+                                              int alpha, unsigned n)
+{
+	for (; n--; dst++)
+		*dst = Genode::Pixel_rgb888::mix(*dst, color, alpha);
+}
+
+
+static inline void convert_rgb565_to_rgb888_generic(Genode::Pixel_rgb888       *dst,
+                                                    Genode::Pixel_rgb565 const *src,
+                                                    unsigned n)
+{
+	for (; n--; dst++, src++)
+		*dst = Genode::Pixel_rgb888(src->r(), src->g(), src->b());
+}
+
+
+static inline void convert_rgb888_to_rgb565_generic(Genode::Pixel_rgb565       *dst,
+                                                    Genode::Pixel_rgb888 const *src,
+                                                    unsigned n)
+{
+	for (; n--; dst++, src++)
+		*dst = Genode::Pixel_rgb565(src->r(), src->g(), src->b());
+}
+
+#endif /* _LIB__BLIT__BLEND_HELPER_H_ */
@@ -0,0 +1,26 @@
+/*
+ * \brief  Selection of the generic blitting and blending kernels
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <kernels.h>
+
+
+Blit_kernels const &blit_kernels()
+{
+	static Blit_kernels const generic =
+		Blit_kernels::from<Blit_generic_kernels>(BLIT_ISA_GENERIC);
+
+	return generic;
+}
+
+
+extern "C" bool blit_select_isa(Blit_isa isa) { return isa == BLIT_ISA_GENERIC; }
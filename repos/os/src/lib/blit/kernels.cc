@@ -0,0 +1,45 @@
+/*
+ * \brief  Blending and pixel-conversion functions
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <kernels.h>
+
+
+extern "C" void blend_rgb888(void *dst, void const *src,
+                             unsigned char const *alpha, unsigned n)
+{
+	blit_kernels().blend_rgb888(dst, src, alpha, n);
+}
+
+
+extern "C" void blend_rgb888_color(void *dst, unsigned color, int alpha,
+                                   unsigned n)
+{
+	blit_kernels().blend_rgb888_color(dst, color, alpha, n);
+}
+
+
+extern "C" void convert_rgb565_to_rgb888(void *dst, void const *src,
+                                         unsigned n)
+{
+	blit_kernels().convert_rgb565_to_rgb888(dst, src, n);
+}
+
+
+extern "C" void convert_rgb888_to_rgb565(void *dst, void const *src,
+                                         unsigned n)
+{
+	blit_kernels().convert_rgb888_to_rgb565(dst, src, n);
+}
+
+
+extern "C" Blit_isa blit_isa(void) { return blit_kernels().isa; }
@@ -0,0 +1,89 @@
+/*
+ * \brief  Table of the blitting and blending kernels of an instruction set
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__KERNELS_H_
+#define _LIB__BLIT__KERNELS_H_
+
+#include <blit/blit.h>
+#include <util/string.h>
+#include <blend_helper.h>
+
+
+struct Blit_kernels
+{
+	Blit_isa isa;
+
+	void (*copy_32byte_chunks)(void const *src, void *dst, int size);
+	void (*blend_rgb888)(void *dst, void const *src,
+	                     unsigned char const *alpha, unsigned n);
+	void (*blend_rgb888_color)(void *dst, unsigned color, int alpha, unsigned n);
+	void (*convert_rgb565_to_rgb888)(void *dst, void const *src, unsigned n);
+	void (*convert_rgb888_to_rgb565)(void *dst, void const *src, unsigned n);
+
+	/**
+	 * Create table from the static member functions of type 'T'
+	 */
+	template <typename T>
+	static constexpr Blit_kernels from(Blit_isa isa)
+	{
+		return { isa, T::copy_32byte_chunks, T::blend_rgb888,
+		         T::blend_rgb888_color, T::convert_rgb565_to_rgb888,
+		         T::convert_rgb888_to_rgb565 };
+	}
+};
+
+
+/**
+ * Kernels implemented in plain C++
+ */
+struct Blit_generic_kernels
+{
+	static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		Genode::memcpy(dst, src, 32*size); }
+
+	static void blend_rgb888(void *dst, void const *src,
+	                         unsigned char const *alpha, unsigned n)
+	{
+		blend_rgb888_generic((Genode::Pixel_rgb888 *)dst,
+		                     (Genode::Pixel_rgb888 const *)src, alpha, n);
+	}
+
+	static void blend_rgb888_color(void *dst, unsigned color, int alpha, unsigned n)
+	{
+		Genode::Pixel_rgb888 pixel { };
+		pixel.pixel = color;
+		blend_rgb888_color_generic((Genode::Pixel_rgb888 *)dst, pixel, alpha, n);
+	}
+
+	static void convert_rgb565_to_rgb888(void *dst, void const *src, unsigned n)
+	{
+		convert_rgb565_to_rgb888_generic((Genode::Pixel_rgb888 *)dst,
+		                                 (Genode::Pixel_rgb565 const *)src, n);
+	}
+
+	static void convert_rgb888_to_rgb565(void *dst, void const *src, unsigned n)
+	{
+		convert_rgb888_to_rgb565_generic((Genode::Pixel_rgb565 *)dst,
+		                                 (Genode::Pixel_rgb888 const *)src, n);
+	}
+};
+
+
+/**
+ * Return kernels of the selected instruction set
+ *
+ * Implemented by the architecture-specific 'isa.cc'.
+ */
+Blit_kernels const &blit_kernels();
+
+#endif /* _LIB__BLIT__KERNELS_H_ */
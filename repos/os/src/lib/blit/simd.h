@@ -0,0 +1,200 @@
+/*
+ * \brief  Vectorized blitting, blending, and pixel-conversion utilities
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The kernels are expressed via the vector extensions of the compiler and
+ * are thereby shared by all architectures with SIMD support. The functions
+ * are always inlined so that the code is generated for the instruction set
+ * of the calling function, which is selected via the 'target' attribute.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SIMD_H_
+#define _LIB__BLIT__SIMD_H_
+
+#include <blend_helper.h>
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+
+/**
+ * Vector types for N pixels
+ *
+ * The types are defined for each supported N because the compiler does not
+ * accept vector types that depend on a template argument as operands of
+ * '__builtin_convertvector'. Vectors wider than 128 bit are specific to the
+ * architecture and defined along with the corresponding kernels.
+ */
+template <unsigned N> struct Simd_types;
+
+
+template <>
+struct Simd_types<4>
+{
+	typedef Genode::uint32_t u32x1 __attribute__((vector_size(16)));
+	typedef Genode::uint16_t u16x2 __attribute__((vector_size(16)));
+	typedef Genode::uint16_t u16x1 __attribute__((vector_size(8)));
+	typedef Genode::uint8_t  u8x1  __attribute__((vector_size(4)));
+
+	static SIMD_INLINE u32x1 widen(u8x1  v) { return __builtin_convertvector(v, u32x1); }
+	static SIMD_INLINE u32x1 widen(u16x1 v) { return __builtin_convertvector(v, u32x1); }
+	static SIMD_INLINE u16x1 narrow(u32x1 v) { return __builtin_convertvector(v, u16x1); }
+};
+
+
+/**
+ * Kernels operating on vectors of N pixels
+ */
+template <unsigned N>
+struct Simd
+{
+	typedef Genode::uint64_t uint64_t;
+	typedef Genode::uint32_t uint32_t;
+	typedef Genode::uint16_t uint16_t;
+	typedef Genode::uint8_t  uint8_t;
+
+	typedef Simd_types<N> Types;
+
+	typedef typename Types::u32x1 u32x1;
+	typedef typename Types::u16x2 u16x2;
+	typedef typename Types::u16x1 u16x1;
+	typedef typename Types::u8x1  u8x1;
+
+	static_assert(N <= sizeof(uint64_t), "alpha values exceed 64 bit");
+
+	template <typename V>
+	static SIMD_INLINE V load(void const *ptr)
+	{
+		V v;
+		__builtin_memcpy(&v, ptr, sizeof(v));
+		return v;
+	}
+
+	template <typename V>
+	static SIMD_INLINE void store(void *ptr, V v) {
+		__builtin_memcpy(ptr, &v, sizeof(v)); }
+
+	/**
+	 * Return the N alpha values at 'alpha' as one integer
+	 */
+	static SIMD_INLINE uint64_t alpha_bits(uint8_t const *alpha)
+	{
+		uint64_t v = 0;
+		__builtin_memcpy(&v, alpha, N);
+		return v;
+	}
+
+	static constexpr uint64_t OPAQUE = (N == 8) ? ~0ULL : (1ULL << 8*N) - 1;
+
+	/**
+	 * Mix pixels at the ratio given per pixel as alpha value 0...256
+	 *
+	 * Each color channel is processed in a 16-bit lane, which yields the
+	 * same result as 'Pixel_rgb888::mix'.
+	 */
+	static SIMD_INLINE u32x1 mix(u32x1 p1, u32x1 p2, u32x1 alpha)
+	{
+		u16x2 const a2 = (u16x2)(alpha | (alpha << 16));
+		u16x2 const a1 = 256 - a2;
+
+		u16x2 const c1 = (u16x2)p1, c2 = (u16x2)p2;
+
+		/* blue and red channels */
+		u16x2 const lo = (u16x2)((((c1 & 0xff) * a1) >> 8) + (((c2 & 0xff) * a2) >> 8));
+
+		/* green and unused channels */
+		u16x2 const hi = (u16x2)((((c1 >> 8) * a1) >> 8) + (((c2 >> 8) * a2) >> 8));
+
+		return (u32x1)(lo | (u16x2)(hi << 8)) & 0xffffff;
+	}
+
+	static SIMD_INLINE void blend_rgb888(uint32_t *dst, uint32_t const *src,
+	                                     uint8_t const *alpha, unsigned n)
+	{
+		for (; n >= N; n -= N, dst += N, src += N, alpha += N) {
+
+			uint64_t const bits = alpha_bits(alpha);
+
+			/* fast path for fully transparent or opaque source pixels */
+			if (bits == 0)
+				continue;
+
+			if (bits == OPAQUE) {
+				store(dst, load<u32x1>(src) & 0xffffff);
+				continue;
+			}
+
+			u32x1 const a = Types::widen(load<u8x1>(alpha));
+			u32x1 const d = load<u32x1>(dst);
+			u32x1 const keep = (u32x1)(a == 0);
+
+			store(dst, (d & keep) | (mix(d, load<u32x1>(src), a + 1) & ~keep));
+		}
+
+		blend_rgb888_generic((Genode::Pixel_rgb888 *)dst,
+		                     (Genode::Pixel_rgb888 const *)src, alpha, n);
+	}
+
+	static SIMD_INLINE void blend_rgb888_color(uint32_t *dst, uint32_t color,
+	                                           int alpha, unsigned n)
+	{
+		u32x1 const c = (u32x1){ } + color;
+		u32x1 const a = (u32x1){ } + (uint32_t)alpha;
+
+		for (; n >= N; n -= N, dst += N)
+			store(dst, mix(load<u32x1>(dst), c, a));
+
+		Genode::Pixel_rgb888 pixel { };
+		pixel.pixel = color;
+		blend_rgb888_color_generic((Genode::Pixel_rgb888 *)dst, pixel, alpha, n);
+	}
+
+	static SIMD_INLINE void convert_rgb565_to_rgb888(uint32_t *dst,
+	                                                 uint16_t const *src,
+	                                                 unsigned n)
+	{
+		for (; n >= N; n -= N, dst += N, src += N) {
+			u32x1 const p = Types::widen(load<u16x1>(src));
+			store(dst, ((p << 8) & 0xf80000) | ((p << 5) & 0xfc00) | ((p << 3) & 0xf8));
+		}
+
+		convert_rgb565_to_rgb888_generic((Genode::Pixel_rgb888 *)dst,
+		                                 (Genode::Pixel_rgb565 const *)src, n);
+	}
+
+	static SIMD_INLINE void convert_rgb888_to_rgb565(uint16_t *dst,
+	                                                 uint32_t const *src,
+	                                                 unsigned n)
+	{
+		for (; n >= N; n -= N, dst += N, src += N) {
+			u32x1 const p = load<u32x1>(src);
+			u32x1 const r = ((p >> 8) & 0xf800) | ((p >> 5) & 0x7e0) | ((p >> 3) & 0x1f);
+			store(dst, Types::narrow(r));
+		}
+
+		convert_rgb888_to_rgb565_generic((Genode::Pixel_rgb565 *)dst,
+		                                 (Genode::Pixel_rgb888 const *)src, n);
+	}
+
+	/**
+	 * Copy 32byte chunks using regular vector loads and stores
+	 */
+	static SIMD_INLINE void copy_32byte_chunks(void const *src, void *dst, int size)
+	{
+		char const *s = (char const *)src;
+		char       *d = (char       *)dst;
+
+		for (; size-- > 0; s += 32, d += 32)
+			for (unsigned i = 0; i < 32; i += 4*N)
+				store(d + i, load<u32x1>(s + i));
+	}
+};
+
+#endif /* _LIB__BLIT__SIMD_H_ */
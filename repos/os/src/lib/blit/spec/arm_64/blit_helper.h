@@ -74,6 +74,14 @@ static inline void copy_block_64bit(char const *src, int src_w,
 }
 
 
+/**
+ * Copy 32byte chunks via the kernel selected for the CPU
+ *
+ * Implemented in 'isa.cc'.
+ */
+void copy_32byte_chunks(void const *src, void *dst, int size);
+
+
 /**
  * Copy block with a size of multiple of 32 bytes
  *
@@ -85,7 +93,7 @@ static inline void copy_block_32byte(char const *src, int src_w,
                                      int w, int h)
 {
 	for (; h > 0; h--) {
-			copy_block_64bit(src, src_w, dst, dst_w, w*4, 1);
+			copy_32byte_chunks(src, dst, w);
 			src += src_w;
 			dst += dst_w;
 	}
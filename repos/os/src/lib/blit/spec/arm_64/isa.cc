@@ -0,0 +1,79 @@
+/*
+ * \brief  Selection of the NEON blitting and blending kernels
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <kernels.h>
+#include <simd.h>
+#include <blit_helper.h>
+
+using Genode::uint32_t;
+using Genode::uint16_t;
+
+
+struct Generic_kernels : Blit_generic_kernels
+{
+	static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		copy_block_64bit((char const *)src, 0, (char *)dst, 0, size*4, 1); }
+};
+
+
+/*
+ * The vector extensions of the compiler are translated to Advanced SIMD
+ * (NEON) instructions, which are mandatory on AArch64.
+ */
+struct Neon_kernels
+{
+	static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		Simd<4>::copy_32byte_chunks(src, dst, size); }
+
+	static void blend_rgb888(void *dst, void const *src,
+	                         unsigned char const *alpha, unsigned n) {
+		Simd<4>::blend_rgb888((uint32_t *)dst, (uint32_t const *)src, alpha, n); }
+
+	static void blend_rgb888_color(void *dst, unsigned color, int alpha, unsigned n) {
+		Simd<4>::blend_rgb888_color((uint32_t *)dst, color, alpha, n); }
+
+	static void convert_rgb565_to_rgb888(void *dst, void const *src, unsigned n) {
+		Simd<4>::convert_rgb565_to_rgb888((uint32_t *)dst, (uint16_t const *)src, n); }
+
+	static void convert_rgb888_to_rgb565(void *dst, void const *src, unsigned n) {
+		Simd<4>::convert_rgb888_to_rgb565((uint16_t *)dst, (uint32_t const *)src, n); }
+};
+
+
+static constexpr Blit_kernels
+	generic_kernels = Blit_kernels::from<Generic_kernels>(BLIT_ISA_GENERIC),
+	neon_kernels    = Blit_kernels::from<Neon_kernels>   (BLIT_ISA_NEON);
+
+
+static Blit_kernels const *_selected_kernels = &neon_kernels;
+
+
+Blit_kernels const &blit_kernels() { return *_selected_kernels; }
+
+
+extern "C" bool blit_select_isa(Blit_isa isa)
+{
+	switch (isa) {
+	case BLIT_ISA_GENERIC: _selected_kernels = &generic_kernels; return true;
+	case BLIT_ISA_NEON:    _selected_kernels = &neon_kernels;    return true;
+	case BLIT_ISA_SSE2:
+	case BLIT_ISA_AVX2:    return false;
+	}
+	return false;
+}
+
+
+void copy_32byte_chunks(void const *src, void *dst, int size)
+{
+	blit_kernels().copy_32byte_chunks(src, dst, size);
+}
@@ -0,0 +1,202 @@
+/*
+ * \brief  Selection of the SSE2 and AVX2 blitting and blending kernels
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <kernels.h>
+#include <simd.h>
+#include <mmx.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+using Genode::uint32_t;
+using Genode::uint16_t;
+
+
+/**
+ * Copy 32byte chunks with the streaming stores of 'STREAM'
+ *
+ * Streaming stores require a destination aligned to the size of the vector.
+ * The destination is merely 32bit-aligned, so the leading and trailing
+ * 32bit words are copied with regular stores.
+ */
+template <typename STREAM>
+static SIMD_INLINE void stream_32byte_chunks(void const *src, void *dst, int size)
+{
+	typedef typename STREAM::V V;
+
+	char const   *s   = (char const *)src;
+	char         *d   = (char       *)dst;
+	unsigned long len = 32UL*size;
+
+	for (; len && ((unsigned long)d & (sizeof(V) - 1)); s += 4, d += 4, len -= 4)
+		__builtin_memcpy(d, s, 4);
+
+	for (; len >= sizeof(V); s += sizeof(V), d += sizeof(V), len -= sizeof(V)) {
+		V v;
+		__builtin_memcpy(&v, s, sizeof(V));
+		STREAM::store((V *)d, v);
+	}
+
+	for (; len; s += 4, d += 4, len -= 4)
+		__builtin_memcpy(d, s, 4);
+
+	__builtin_ia32_sfence();
+}
+
+
+struct Mmx_kernels : Blit_generic_kernels
+{
+	static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		copy_32byte_chunks_mmx(src, dst, size); }
+};
+
+
+struct Sse2_kernels
+{
+	struct Stream
+	{
+		typedef long long V __attribute__((vector_size(16)));
+
+		static SIMD_INLINE void store(V *dst, V v) {
+			__builtin_ia32_movntdq(dst, v); }
+	};
+
+	static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		stream_32byte_chunks<Stream>(src, dst, size); }
+
+	static void blend_rgb888(void *dst, void const *src,
+	                         unsigned char const *alpha, unsigned n) {
+		Simd<4>::blend_rgb888((uint32_t *)dst, (uint32_t const *)src, alpha, n); }
+
+	static void blend_rgb888_color(void *dst, unsigned color, int alpha, unsigned n) {
+		Simd<4>::blend_rgb888_color((uint32_t *)dst, color, alpha, n); }
+
+	static void convert_rgb565_to_rgb888(void *dst, void const *src, unsigned n) {
+		Simd<4>::convert_rgb565_to_rgb888((uint32_t *)dst, (uint16_t const *)src, n); }
+
+	static void convert_rgb888_to_rgb565(void *dst, void const *src, unsigned n) {
+		Simd<4>::convert_rgb888_to_rgb565((uint16_t *)dst, (uint32_t const *)src, n); }
+};
+
+
+template <>
+struct Simd_types<8>
+{
+	typedef Genode::uint32_t u32x1 __attribute__((vector_size(32)));
+	typedef Genode::uint16_t u16x2 __attribute__((vector_size(32)));
+	typedef Genode::uint16_t u16x1 __attribute__((vector_size(16)));
+	typedef Genode::uint8_t  u8x1  __attribute__((vector_size(8)));
+
+	static SIMD_INLINE u32x1 widen(u8x1  v) { return __builtin_convertvector(v, u32x1); }
+	static SIMD_INLINE u32x1 widen(u16x1 v) { return __builtin_convertvector(v, u32x1); }
+	static SIMD_INLINE u16x1 narrow(u32x1 v) { return __builtin_convertvector(v, u16x1); }
+};
+
+
+struct Avx2_kernels
+{
+	struct Stream
+	{
+		typedef long long V __attribute__((vector_size(32)));
+
+		static SIMD_INLINE void store(V *dst, V v) {
+			__builtin_ia32_movntdq256(dst, v); }
+	};
+
+	AVX2 static void copy_32byte_chunks(void const *src, void *dst, int size) {
+		stream_32byte_chunks<Stream>(src, dst, size); }
+
+	AVX2 static void blend_rgb888(void *dst, void const *src,
+	                              unsigned char const *alpha, unsigned n) {
+		Simd<8>::blend_rgb888((uint32_t *)dst, (uint32_t const *)src, alpha, n); }
+
+	AVX2 static void blend_rgb888_color(void *dst, unsigned color, int alpha, unsigned n) {
+		Simd<8>::blend_rgb888_color((uint32_t *)dst, color, alpha, n); }
+
+	AVX2 static void convert_rgb565_to_rgb888(void *dst, void const *src, unsigned n) {
+		Simd<8>::convert_rgb565_to_rgb888((uint32_t *)dst, (uint16_t const *)src, n); }
+
+	AVX2 static void convert_rgb888_to_rgb565(void *dst, void const *src, unsigned n) {
+		Simd<8>::convert_rgb888_to_rgb565((uint16_t *)dst, (uint32_t const *)src, n); }
+};
+
+
+static constexpr Blit_kernels
+	mmx_kernels  = Blit_kernels::from<Mmx_kernels> (BLIT_ISA_GENERIC),
+	sse2_kernels = Blit_kernels::from<Sse2_kernels>(BLIT_ISA_SSE2),
+	avx2_kernels = Blit_kernels::from<Avx2_kernels>(BLIT_ISA_AVX2);
+
+
+static void cpuid(unsigned leaf, unsigned &a, unsigned &b, unsigned &c, unsigned &d)
+{
+	asm volatile ("cpuid" : "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+	                      : "a" (leaf), "c" (0));
+}
+
+
+static bool avx2_supported()
+{
+	unsigned a = 0, b = 0, c = 0, d = 0;
+
+	cpuid(0, a, b, c, d);
+	if (a < 7)
+		return false;
+
+	/* AVX must be supported by the CPU and enabled via XSAVE by the kernel */
+	cpuid(1, a, b, c, d);
+	bool const osxsave = c & (1U << 27);
+	bool const avx     = c & (1U << 28);
+	if (!osxsave || !avx)
+		return false;
+
+	unsigned xcr0_lo = 0, xcr0_hi = 0;
+	asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+	if ((xcr0_lo & 0x6) != 0x6)
+		return false;
+
+	cpuid(7, a, b, c, d);
+	return b & (1U << 5);
+}
+
+
+static Blit_kernels const *_selected_kernels = nullptr;
+
+
+Blit_kernels const &blit_kernels()
+{
+	if (!_selected_kernels)
+		_selected_kernels = avx2_supported() ? &avx2_kernels : &sse2_kernels;
+
+	return *_selected_kernels;
+}
+
+
+extern "C" bool blit_select_isa(Blit_isa isa)
+{
+	switch (isa) {
+	case BLIT_ISA_GENERIC: _selected_kernels = &mmx_kernels;  return true;
+	case BLIT_ISA_SSE2:    _selected_kernels = &sse2_kernels; return true;
+	case BLIT_ISA_AVX2:
+		if (!avx2_supported())
+			return false;
+		_selected_kernels = &avx2_kernels;
+		return true;
+	case BLIT_ISA_NEON:    return false;
+	}
+	return false;
+}
+
+
+void copy_32byte_chunks(void const *src, void *dst, int size)
+{
+	blit_kernels().copy_32byte_chunks(src, dst, size);
+}
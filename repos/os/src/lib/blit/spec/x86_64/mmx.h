@@ -17,7 +17,7 @@
 /**
  * Copy 32byte chunks via MMX
  */
-static inline void copy_32byte_chunks(void const *src, void *dst, int size)
+static inline void copy_32byte_chunks_mmx(void const *src, void *dst, int size)
 {
 	asm volatile (
 		"emms                             \n\t"
@@ -43,4 +43,12 @@ static inline void copy_32byte_chunks(void const *src, void *dst, int size)
 	);
 }
 
+
+/**
+ * Copy 32byte chunks via the kernel selected for the CPU
+ *
+ * Implemented in 'isa.cc'.
+ */
+void copy_32byte_chunks(void const *src, void *dst, int size);
+
 #endif /* _LIB__BLIT__SPEC__X86_64__MMX_H_ */
@@ -22,13 +22,6 @@ using namespace Genode;
  ** Unit-local utilities **
  **************************/
 
-struct Packed_uint8
-{
-	Genode::uint8_t value;
-
-} __attribute__((packed));
-
-
 static void fold_checksum_to_16_bits(signed long &sum)
 {
 	while (addr_t const remainder = sum >> 16) {
@@ -37,19 +30,193 @@ static void fold_checksum_to_16_bits(signed long &sum)
 }
 
 
-static uint16_t checksum_of_raw_data(Packed_uint16 const *data_ptr,
-                                     size_t               data_sz,
-                                     signed long          sum)
+static uint16_t folded_to_16_bits(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff)     + (sum >> 16);
+	sum = (sum & 0xffff)     + (sum >> 16);
+	return (uint16_t)sum;
+}
+
+
+/*
+ * The helpers are always inlined so that the code generated for them
+ * matches the instruction set of the respective caller.
+ */
+#define ALWAYS_INLINE __attribute__((always_inline)) inline
+
+
+template <typename T>
+static ALWAYS_INLINE T load(uint8_t const *ptr)
+{
+	T value;
+	__builtin_memcpy(&value, ptr, sizeof(T));
+	return value;
+}
+
+
+template <typename T>
+static ALWAYS_INLINE void store(uint8_t *ptr, T value)
+{
+	__builtin_memcpy(ptr, &value, sizeof(T));
+}
+
+
+/*
+ * Vector of two 64-bit lanes, which the compiler maps to SSE2 registers on
+ * x86_64 and to NEON registers on ARM
+ */
+typedef uint64_t Vector __attribute__((vector_size(16)));
+
+
+/**
+ * Add up data, optionally copying it to 'dst' on the way
+ *
+ * The one's complement sum does not depend on the width of the words used
+ * for adding up the data (RFC 1071). Hence, the bulk of the data is added
+ * up as 32-bit words in 64-bit accumulators, which need no carry handling
+ * for any data size of practical relevance. The remainder is added up in
+ * 16-bit words followed by the left-over byte, if any.
+ *
+ * \param V  vector type with 64-bit lanes
+ *
+ * \return  sum folded to 16 bits but not complemented
+ */
+template <typename V, bool COPY>
+static ALWAYS_INLINE uint16_t sum_of_raw_data(uint8_t const *src, uint8_t *dst,
+                                              size_t size)
 {
+	V const low_words = V { } + 0xffffffff;
+
+	V acc_0 { }, acc_1 { };
+	size_t i = 0;
+
+	for (; size - i >= 2*sizeof(V); i += 2*sizeof(V)) {
+		V const v_0 = load<V>(src + i);
+		V const v_1 = load<V>(src + i + sizeof(V));
+
+		if (COPY) {
+			store(dst + i,             v_0);
+			store(dst + i + sizeof(V), v_1);
+		}
+		acc_0 += (v_0 & low_words) + (v_0 >> 32);
+		acc_1 += (v_1 & low_words) + (v_1 >> 32);
+	}
+	acc_0 += acc_1;
+
+	uint64_t sum = 0;
+	for (unsigned lane = 0; lane < sizeof(V)/sizeof(uint64_t); lane++)
+		sum += acc_0[lane];
+
+	for (; size - i >= 4; i += 4) {
+		uint32_t const w = load<uint32_t>(src + i);
+		if (COPY) store(dst + i, w);
+		sum += w;
+	}
+
 	/* add up bytes in pairs */
-	for (; data_sz > 1; data_sz -= sizeof(Packed_uint16)) {
-		sum += data_ptr->value;
-		data_ptr++;
+	for (; size - i >= 2; i += 2) {
+		uint16_t const w = load<uint16_t>(src + i);
+		if (COPY) store(dst + i, w);
+		sum += w;
 	}
+
 	/* add left-over byte, if any */
-	if (data_sz > 0) {
-		sum += ((Packed_uint8 const *)data_ptr)->value;
+	if (size - i > 0) {
+		if (COPY) dst[i] = src[i];
+		sum += src[i];
 	}
+	return folded_to_16_bits(sum);
+}
+
+
+#ifdef __x86_64__
+
+/*
+ * The AVX2 variant is selected at runtime in the same way as the blitting
+ * kernels of the blit library. The XCR0 check ensures that the kernel
+ * enabled the AVX register state, which implies that it preserves the
+ * state across context switches.
+ */
+
+typedef uint64_t Vector_256 __attribute__((vector_size(32)));
+
+
+template <bool COPY>
+__attribute__((target("avx2")))
+static uint16_t sum_of_raw_data_avx2(uint8_t const *src, uint8_t *dst, size_t size)
+{
+	return sum_of_raw_data<Vector_256, COPY>(src, dst, size);
+}
+
+
+static void cpuid(unsigned leaf, unsigned &a, unsigned &b, unsigned &c, unsigned &d)
+{
+	asm volatile ("cpuid" : "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+	                      : "a" (leaf), "c" (0));
+}
+
+
+static bool avx2_supported()
+{
+	unsigned a = 0, b = 0, c = 0, d = 0;
+
+	cpuid(0, a, b, c, d);
+	if (a < 7)
+		return false;
+
+	/* AVX must be supported by the CPU and enabled via XSAVE by the kernel */
+	cpuid(1, a, b, c, d);
+	bool const osxsave = c & (1U << 27);
+	bool const avx     = c & (1U << 28);
+	if (!osxsave || !avx)
+		return false;
+
+	unsigned xcr0_lo = 0, xcr0_hi = 0;
+	asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+	if ((xcr0_lo & 0x6) != 0x6)
+		return false;
+
+	cpuid(7, a, b, c, d);
+	return b & (1U << 5);
+}
+
+
+enum class Isa { UNKNOWN, SSE2, AVX2 };
+
+/* determined on first use, concurrent callers determine the same value */
+static Isa _isa = Isa::UNKNOWN;
+
+
+template <bool COPY>
+static uint16_t sum_of_raw_data(uint8_t const *src, uint8_t *dst, size_t size)
+{
+	if (_isa == Isa::UNKNOWN)
+		_isa = avx2_supported() ? Isa::AVX2 : Isa::SSE2;
+
+	if (_isa == Isa::AVX2)
+		return sum_of_raw_data_avx2<COPY>(src, dst, size);
+
+	return sum_of_raw_data<Vector, COPY>(src, dst, size);
+}
+
+#else
+
+template <bool COPY>
+static uint16_t sum_of_raw_data(uint8_t const *src, uint8_t *dst, size_t size)
+{
+	return sum_of_raw_data<Vector, COPY>(src, dst, size);
+}
+
+#endif /* __x86_64__ */
+
+
+static uint16_t checksum_of_raw_data(Packed_uint16 const *data_ptr,
+                                     size_t               data_sz,
+                                     signed long          sum)
+{
+	sum += sum_of_raw_data<false>((uint8_t const *)data_ptr, nullptr, data_sz);
 	fold_checksum_to_16_bits(sum);
 
 	/* return one's complement */
@@ -68,6 +235,17 @@ uint16_t Net::internet_checksum(Packed_uint16 const *data_ptr,
 }
 
 
+uint16_t Net::copy_and_checksum(void                *dst,
+                                Packed_uint16 const *src,
+                                size_t               size)
+{
+	uint16_t const sum = sum_of_raw_data<true>((uint8_t const *)src,
+	                                           (uint8_t *)dst, size);
+	/* return one's complement */
+	return (uint16_t)~sum;
+}
+
+
 uint16_t Net::internet_checksum_pseudo_ip(Packed_uint16   const *data_ptr,
                                           size_t                 data_sz,
                                           uint16_t               ip_data_sz_be,
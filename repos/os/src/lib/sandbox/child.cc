@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2017 Genode Labs GmbH
+ * Copyright (C) 2010-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -66,11 +66,17 @@ Sandbox::Child::apply_config(Xml_node start_node)
 		 * The <route> node may affect the availability or unavailability
 		 * of dependencies.
 		 */
+		bool route_changed =
+			start_node.has_sub_node("route") != _start_node->xml().has_sub_node("route");
+
 		start_node.with_optional_sub_node("route", [&] (Xml_node const &route) {
 			_start_node->xml().with_optional_sub_node("route", [&] (Xml_node const &orig) {
-				if (route.differs_from(orig)) {
-					_construct_route_model_from_start_node(start_node);
-					_uncertain_dependencies = true; } }); });
+				route_changed = route.differs_from(orig); }); });
+
+		if (route_changed) {
+			_construct_route_model_from_start_node(start_node);
+			_uncertain_dependencies = true;
+		}
 
 		/*
 		 * Determine how the inline config is affected.
@@ -609,7 +615,9 @@ Sandbox::Child::resolve_session_request(Service::Name const &service_name,
 
 	Route_model::Query const query(name(), service_name, label);
 
-	return _route_model->resolve(query, resolve_at_target);
+	return _effective_route_model().resolve(query,
+	                                        _default_route_accessor.routing_stats(),
+	                                        resolve_at_target);
 }
 
 
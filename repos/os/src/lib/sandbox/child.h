@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2017 Genode Labs GmbH
+ * Copyright (C) 2010-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -50,7 +50,18 @@ class Sandbox::Child : Child_policy, Routed_service::Wakeup
 		 */
 		struct Id { unsigned value; };
 
-		struct Default_route_accessor : Interface { virtual Xml_node default_route() = 0; };
+		struct Default_route_accessor : Interface
+		{
+			/**
+			 * Return route model shared by all children without '<route>'
+			 */
+			virtual Route_model const &default_route_model() = 0;
+
+			/**
+			 * Return statistics accumulated by routing session requests
+			 */
+			virtual Route_model::Stats &routing_stats() = 0;
+		};
 		struct Default_caps_accessor  : Interface { virtual Cap_quota default_caps() = 0; };
 
 		template <typename QUOTA>
@@ -120,17 +131,24 @@ class Sandbox::Child : Child_policy, Routed_service::Wakeup
 
 		Reconstructible<Buffered_xml> _start_node;
 
+		/*
+		 * Model of the child-specific '<route>' node, children without such
+		 * a node share the model of the '<default-route>'
+		 */
 		Constructible<Route_model> _route_model { };
 
 		void _construct_route_model_from_start_node(Xml_node const &start)
 		{
 			_route_model.destruct();
 
-			start.with_sub_node("route",
-				[&] (Xml_node const &route) {
-					_route_model.construct(_alloc, route); },
-				[&] () {
-					_route_model.construct(_alloc, _default_route_accessor.default_route()); });
+			start.with_optional_sub_node("route", [&] (Xml_node const &route) {
+				_route_model.construct(_alloc, route); });
+		}
+
+		Route_model const &_effective_route_model()
+		{
+			return _route_model.constructed()
+			     ? *_route_model : _default_route_accessor.default_route_model();
 		}
 
 		/*
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2010-2021 Genode Labs GmbH
+ * Copyright (C) 2010-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -48,6 +48,7 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 	using Cap_info       = ::Sandbox::Cap_info;
 	using Cpu_quota      = ::Sandbox::Cpu_quota;
 	using Config_model   = ::Sandbox::Config_model;
+	using Route_model    = ::Sandbox::Route_model;
 	using Start_model    = ::Sandbox::Start_model;
 	using Preservation   = ::Sandbox::Preservation;
 
@@ -65,6 +66,8 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 	Reconstructible<Verbose>       _verbose        { };
 	Config_model::Version          _version        { };
 	Constructible<Buffered_xml>    _default_route  { };
+	Constructible<Route_model>     _default_route_model { };
+	Route_model::Stats             _routing_stats  { };
 	Cap_quota                      _default_caps   { 0 };
 	Prio_levels                    _prio_levels    { };
 	Constructible<Affinity::Space> _affinity_space { };
@@ -170,6 +173,9 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 		if (detail.init_caps())
 			xml.node("caps", [&] () { Cap_info::from_pd(_env.pd()).generate(xml); });
 
+		if (detail.routing())
+			xml.node("routing", [&] () { _routing_stats.generate(xml); });
+
 		if (detail.children())
 			_children.report_state(xml, detail);
 	}
@@ -182,15 +188,45 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 		return _children.sample_state();
 	}
 
+	Xml_node _default_route_xml() const
+	{
+		return _default_route.constructed() ? _default_route->xml()
+		                                    : Xml_node("<empty/>");
+	}
+
+	/**
+	 * Update model of the default route
+	 *
+	 * \return true if the default route changed
+	 */
+	bool _update_default_route_model()
+	{
+		Xml_node const route = _default_route_xml();
+
+		if (_default_route_model.constructed()
+		 && !_default_route_model->differs_from(route))
+			return false;
+
+		_default_route_model.construct(_heap, route);
+		return true;
+	}
+
 	/**
 	 * Default_route_accessor interface
 	 */
-	Xml_node default_route() override
+	Route_model const &default_route_model() override
 	{
-		return _default_route.constructed() ? _default_route->xml()
-		                                    : Xml_node("<empty/>");
+		if (!_default_route_model.constructed())
+			_update_default_route_model();
+
+		return *_default_route_model;
 	}
 
+	/**
+	 * Default_route_accessor interface
+	 */
+	Route_model::Stats &routing_stats() override { return _routing_stats; }
+
 	/**
 	 * Default_caps_accessor interface
 	 */
@@ -413,6 +449,12 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 	                              _state_reporter,
 	                              _heartbeat);
 
+	/*
+	 * The children without '<route>' node share the model of the default
+	 * route. If the default route changed, their sessions must be re-routed.
+	 */
+	bool const default_route_changed = _update_default_route_model();
+
 	/*
 	 * After importing the new configuration, servers may have disappeared
 	 * (STATE_ABANDONED) or become new available.
@@ -442,7 +484,8 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 				return;
 			}
 
-			if (_server_appeared_or_disappeared || child.uncertain_dependencies())
+			if (_server_appeared_or_disappeared || default_route_changed
+			 || child.uncertain_dependencies())
 				child.evaluate_dependencies();
 
 			if (child.restart_scheduled())
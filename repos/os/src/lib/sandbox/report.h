@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2017 Genode Labs GmbH
+ * Copyright (C) 2017-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -40,6 +40,7 @@ class Sandbox::Report_detail : Genode::Noncopyable
 		bool _child_caps   = false;
 		bool _init_ram     = false;
 		bool _init_caps    = false;
+		bool _routing      = false;
 
 	public:
 
@@ -56,6 +57,7 @@ class Sandbox::Report_detail : Genode::Noncopyable
 			_child_caps   = report.attribute_value("child_caps",   false);
 			_init_ram     = report.attribute_value("init_ram",     false);
 			_init_caps    = report.attribute_value("init_caps",    false);
+			_routing      = report.attribute_value("routing",      false);
 		}
 
 		bool children()     const { return _children;     }
@@ -67,6 +69,7 @@ class Sandbox::Report_detail : Genode::Noncopyable
 		bool child_caps()   const { return _child_caps;   }
 		bool init_ram()     const { return _init_ram;     }
 		bool init_caps()    const { return _init_caps;    }
+		bool routing()      const { return _routing;      }
 };
 
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2021 Genode Labs GmbH
+ * Copyright (C) 2021-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -14,6 +14,9 @@
 #ifndef _ROUTE_MODEL_H_
 #define _ROUTE_MODEL_H_
 
+/* Genode includes */
+#include <trace/timestamp.h>
+
 /* local includes */
 #include <types.h>
 
@@ -63,6 +66,23 @@ class Sandbox::Route_model : Noncopyable
 {
 	public:
 
+		/**
+		 * Statistics about the routing of session requests
+		 */
+		struct Stats
+		{
+			unsigned long    requests = 0;  /* resolved session requests */
+			unsigned long    rules    = 0;  /* rules matched against requests */
+			Trace::Timestamp ticks    = 0;  /* time spent in timestamp ticks */
+
+			void generate(Xml_generator &xml) const
+			{
+				xml.attribute("requests", requests);
+				xml.attribute("rules",    rules);
+				xml.attribute("ticks",    ticks);
+			}
+		};
+
 		struct Query : Noncopyable
 		{
 			Child_policy::Name const &child;
@@ -227,6 +247,151 @@ class Sandbox::Route_model : Noncopyable
 
 		List<Rule> _rules { };
 
+		/**
+		 * Rules that may match a query, in the order of the '<route>' node
+		 */
+		struct Candidates
+		{
+			Rule const **rules;
+			unsigned     num;
+		};
+
+		/**
+		 * Index of the rules by service name
+		 *
+		 * For each service named by a rule, the index holds the rules
+		 * specific to the service merged with the wildcard rules. Queries
+		 * for other services are matched against the wildcard rules only.
+		 * Services with colliding checksums share a slot, which is
+		 * harmless because 'Rule::matches' compares the names.
+		 */
+		class Index : Noncopyable
+		{
+			private:
+
+				Allocator &_alloc;
+
+				struct Slot
+				{
+					bool          used;
+					unsigned long service_checksum;
+					Candidates    candidates;
+				};
+
+				unsigned   _num_slots = 0;  /* power of two */
+				Slot      *_slots     = nullptr;
+				Candidates _wildcard { nullptr, 0 };
+
+				unsigned _slot_index(unsigned long checksum) const
+				{
+					return (unsigned)((checksum*2654435761ul) >> 7) & (_num_slots - 1);
+				}
+
+				Slot &_slot(unsigned long checksum) const
+				{
+					unsigned i = _slot_index(checksum);
+					while (_slots[i].used && _slots[i].service_checksum != checksum)
+						i = (i + 1) & (_num_slots - 1);
+
+					return _slots[i];
+				}
+
+				Rule const **_alloc_rules(unsigned num)
+				{
+					return num ? (Rule const **)_alloc.alloc(num*sizeof(Rule const *))
+					           : nullptr;
+				}
+
+				void _free_rules(Candidates &candidates)
+				{
+					if (candidates.rules)
+						_alloc.free(candidates.rules,
+						            candidates.num*sizeof(Rule const *));
+				}
+
+				/*
+				 * Noncopyable
+				 */
+				Index(Index const &);
+				Index &operator = (Index const &);
+
+			public:
+
+				Index(Allocator &alloc, List<Rule> const &rules) : _alloc(alloc)
+				{
+					unsigned num_rules = 0, num_wildcard = 0;
+					for (Rule const *r = rules.first(); r; r = r->next()) {
+						num_rules++;
+						if (!r->_specific_service)
+							num_wildcard++;
+					}
+
+					/* keep the load factor of the table below 0.5 */
+					_num_slots = 2;
+					while (_num_slots < 2*num_rules)
+						_num_slots <<= 1;
+
+					_slots = (Slot *)_alloc.alloc(_num_slots*sizeof(Slot));
+					for (unsigned i = 0; i < _num_slots; i++)
+						_slots[i] = Slot { false, 0, { nullptr, 0 } };
+
+					/* count the rules per service */
+					for (Rule const *r = rules.first(); r; r = r->next()) {
+						if (!r->_specific_service)
+							continue;
+
+						Slot &slot = _slot(r->_service_checksum.value);
+						slot.used             = true;
+						slot.service_checksum = r->_service_checksum.value;
+						slot.candidates.num++;
+					}
+
+					for (unsigned i = 0; i < _num_slots; i++) {
+						Candidates &candidates = _slots[i].candidates;
+						if (_slots[i].used) {
+							candidates.num  += num_wildcard;
+							candidates.rules = _alloc_rules(candidates.num);
+							candidates.num   = 0;
+						}
+					}
+					_wildcard.rules = _alloc_rules(num_wildcard);
+
+					/* populate candidates in the order of the rules */
+					for (Rule const *r = rules.first(); r; r = r->next()) {
+
+						auto append = [&] (Candidates &candidates) {
+							candidates.rules[candidates.num++] = r; };
+
+						if (r->_specific_service) {
+							append(_slot(r->_service_checksum.value).candidates);
+							continue;
+						}
+
+						append(_wildcard);
+						for (unsigned i = 0; i < _num_slots; i++)
+							if (_slots[i].used)
+								append(_slots[i].candidates);
+					}
+				}
+
+				~Index()
+				{
+					for (unsigned i = 0; i < _num_slots; i++)
+						_free_rules(_slots[i].candidates);
+
+					_free_rules(_wildcard);
+					_alloc.free(_slots, _num_slots*sizeof(Slot));
+				}
+
+				Candidates candidates(Checksum const &service) const
+				{
+					Slot const &slot = _slot(service.value);
+					return slot.used ? slot.candidates : _wildcard;
+				}
+		};
+
+		Constructible<Index> _index { };
+
 	public:
 
 		Route_model(Allocator &alloc, Xml_node const &route)
@@ -239,20 +404,52 @@ class Sandbox::Route_model : Noncopyable
 				_rules.insert(&rule, at_ptr); /* append */
 				at_ptr = &rule;
 			});
+
+			_index.construct(_alloc, _rules);
 		}
 
 		~Route_model()
 		{
+			_index.destruct();
+
 			while (Rule *rule_ptr = _rules.first()) {
 				_rules.remove(rule_ptr);
 				destroy(_alloc, rule_ptr);
 			}
 		}
 
+		/**
+		 * Return true if the model was created from a different '<route>' node
+		 */
+		bool differs_from(Xml_node const &route) const
+		{
+			return route.differs_from(_route_node.xml());
+		}
+
 		template <typename FN>
-		Child_policy::Route resolve(Query const &query, FN const &fn) const
+		Child_policy::Route resolve(Query const &query, Stats &stats, FN const &fn) const
 		{
-			for (Rule const *r = _rules.first(); r; r = r->next())
+			/* account the time spent, also if the request gets denied */
+			struct Guard
+			{
+				Stats                 &stats;
+				Trace::Timestamp const start = Trace::timestamp();
+
+				~Guard()
+				{
+					stats.requests++;
+					stats.ticks += Trace::timestamp() - start;
+				}
+			} guard { stats };
+
+			Candidates const candidates = _index->candidates(query.service_checksum);
+
+			for (unsigned i = 0; i < candidates.num; i++) {
+
+				Rule const * const r = candidates.rules[i];
+
+				stats.rules++;
+
 				if (r->matches(query)) {
 					try {
 						return r->resolve(fn);
@@ -268,6 +465,7 @@ class Sandbox::Route_model : Noncopyable
 						 */
 					}
 				}
+			}
 
 			warning(query.child, ": no route to "
 			        "service \"", query.service, "\" "
@@ -7,7 +7,7 @@
  */
 
 /*
- * Copyright (C) 2012-2019 Genode Labs GmbH
+ * Copyright (C) 2012-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -62,6 +62,158 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		struct Fs_vfs_handle;
 		typedef Genode::Fifo<Fs_vfs_handle> Fs_vfs_handle_queue;
 
+		struct Fs_vfs_file_handle;
+
+		/**
+		 * Read packet of a file handle, submitted on demand or ahead of time
+		 *
+		 * The read slots are shared by all file handles and thereby limit the
+		 * amount of bulk buffer occupied by read-ahead data. A slot outlives
+		 * its owner if the owner abandons a packet still in flight. Such an
+		 * orphaned slot is freed once the server acknowledges the packet.
+		 * If the owner got closed meanwhile, the closing of the file at the
+		 * server is deferred until all its orphaned packets are acknowledged.
+		 * Otherwise, the server could drop the packets without acknowledging
+		 * them.
+		 */
+		struct Read_slot
+		{
+			enum class State { FREE, QUEUED, ACK };
+
+			State                             state     = State::FREE;
+			Fs_vfs_file_handle const         *owner     = nullptr;
+			::File_system::Packet_descriptor  packet    { };
+			file_size                         position  = 0;
+			size_t                            requested = 0;
+			bool                              pending   = false;
+			bool                              close     = false;
+
+			/* number of bytes requested, or received once acknowledged */
+			size_t length() const {
+				return state == State::ACK ? packet.length() : requested; }
+
+			bool covers(Fs_vfs_file_handle const &handle, file_size offset) const
+			{
+				return state != State::FREE && owner == &handle
+				    && offset >= position && offset < position + length();
+			}
+		};
+
+		enum { NUM_READ_SLOTS = 32 };
+
+		Read_slot _read_slots[NUM_READ_SLOTS] { };
+
+		/**
+		 * Assign acknowledged read packet to its read slot
+		 *
+		 * \return  false if the packet does not belong to any read slot
+		 */
+		bool _read_slot_acked(::File_system::Packet_descriptor const &packet)
+		{
+			for (Read_slot &slot : _read_slots) {
+
+				if (slot.state != Read_slot::State::QUEUED
+				 || slot.packet.offset() != packet.offset())
+					continue;
+
+				if (slot.owner) {
+					slot.packet = packet;
+					slot.state  = Read_slot::State::ACK;
+					return true;
+				}
+
+				_fs.tx()->release_packet(packet);
+
+				bool const close = slot.close;
+				slot = Read_slot();
+
+				if (close && !_close_deferred(packet.handle()))
+					_fs.close(packet.handle());
+
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Return true if closing 'handle' awaits the acknowledgement of a packet
+		 */
+		bool _close_deferred(::File_system::Node_handle handle) const
+		{
+			for (Read_slot const &slot : _read_slots)
+				if (slot.close && slot.packet.handle().value == handle.value)
+					return true;
+			return false;
+		}
+
+		/**
+		 * Free read slot, or mark it as orphaned if its packet is in flight
+		 */
+		void _abandon_read_slot(Read_slot &slot)
+		{
+			switch (slot.state) {
+			case Read_slot::State::FREE:
+				break;
+			case Read_slot::State::QUEUED:
+				slot.owner = nullptr;
+				break;
+			case Read_slot::State::ACK:
+				_fs.tx()->release_packet(slot.packet);
+				slot = Read_slot();
+				break;
+			}
+		}
+
+		/**
+		 * Drop read-ahead data of all handles to make room in the bulk buffer
+		 *
+		 * Slots that a handle currently waits for are retained.
+		 */
+		void _discard_read_ahead()
+		{
+			for (Read_slot &slot : _read_slots)
+				if (slot.owner && !slot.pending)
+					_abandon_read_slot(slot);
+		}
+
+		/**
+		 * Identifier of the node at a given path
+		 *
+		 * Handles of the same node are matched by the hash of the node's
+		 * path. A collision merely causes read data to be dropped in vain.
+		 */
+		struct Node_id
+		{
+			Genode::uint32_t value;
+
+			static Node_id from_path(char const *path)
+			{
+				/* FNV-1a */
+				Genode::uint32_t h = 2166136261u;
+				for (char const *p = path; *p; p++)
+					h = (h ^ (Genode::uint8_t)*p) * 16777619u;
+				return { h };
+			}
+
+			bool operator == (Node_id const &other) const {
+				return value == other.value; }
+		};
+
+		/**
+		 * Drop data read for the node 'id' or for the nodes of directory 'id'
+		 *
+		 * Called whenever the content of the node may have changed. Slots
+		 * that a handle currently waits for are retained as their read was
+		 * requested before the change.
+		 */
+		void _discard_read_data_of(Node_id id)
+		{
+			for (Read_slot &slot : _read_slots)
+				if (slot.owner && !slot.pending
+				 && (slot.owner->node_id == id || slot.owner->dir_id == id))
+					_abandon_read_slot(slot);
+		}
+
 		Remote_io::Peer _peer { _env.deferred_wakeups(), *this };
 
 		/**
@@ -239,6 +391,18 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				return READ_ERR_INVALID;
 			}
 
+			/**
+			 * Prepare the closing of the handle
+			 *
+			 * \return  true if the closing at the server must be deferred
+			 */
+			virtual bool defer_close() { return false; }
+
+			/**
+			 * Called after data was written via the handle
+			 */
+			virtual void written() { }
+
 			bool queue_sync()
 			{
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
@@ -314,18 +478,280 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			}
 		};
 
+		/**
+		 * Handle of a file with read-ahead for sequential access
+		 *
+		 * Once a handle is read sequentially, further read packets are
+		 * submitted ahead of time. The number of those packets doubles with
+		 * each sequential read up to 'MAX_READ_AHEAD' and drops to zero on a
+		 * non-sequential read. Read-ahead is limited to read-only handles of
+		 * continuous files because the content of transactional files may
+		 * depend on the sequence of requests.
+		 */
 		struct Fs_vfs_file_handle : Fs_vfs_handle
 		{
-			using Fs_vfs_handle::Fs_vfs_handle;
+			enum { MAX_READ_AHEAD = 8 };
+
+			enum class Read_ahead { UNKNOWN, ENABLED, DISABLED };
+
+			Node_id const node_id;
+			Node_id const dir_id;
+
+			Read_ahead _read_ahead  = Read_ahead::UNKNOWN;
+			unsigned   _window      = 0;
+			file_size  _next_offset = ~0ULL;
+
+			Read_slot *_pending_slot   = nullptr;
+			file_size  _pending_offset = 0;
+
+			/*
+			 * Noncopyable
+			 */
+			Fs_vfs_file_handle(Fs_vfs_file_handle const &);
+			Fs_vfs_file_handle &operator = (Fs_vfs_file_handle const &);
+
+			Fs_vfs_file_handle(File_system &fs, Allocator &alloc,
+			                   int status_flags, Handle_space &space,
+			                   ::File_system::Node_handle node_handle,
+			                   Fs_file_system &vfs_fs,
+			                   Node_id node_id, Node_id dir_id)
+			:
+				Fs_vfs_handle(fs, alloc, status_flags, space, node_handle, vfs_fs),
+				node_id(node_id), dir_id(dir_id)
+			{ }
+
+			~Fs_vfs_file_handle()
+			{
+				for (Read_slot &slot : _vfs_fs._read_slots)
+					if (slot.owner == this)
+						_vfs_fs._abandon_read_slot(slot);
+			}
+
+			bool defer_close() override
+			{
+				bool deferred = false;
+
+				for (Read_slot &slot : _vfs_fs._read_slots) {
+
+					if (slot.owner != this)
+						continue;
+
+					if (slot.state == Read_slot::State::QUEUED)
+						slot.close = deferred = true;
+
+					_vfs_fs._abandon_read_slot(slot);
+				}
+				return deferred;
+			}
+
+			void written() override { _vfs_fs._discard_read_data_of(node_id); }
+
+			bool _read_ahead_enabled()
+			{
+				if (_read_ahead != Read_ahead::UNKNOWN)
+					return _read_ahead == Read_ahead::ENABLED;
+
+				_read_ahead = Read_ahead::DISABLED;
+
+				if ((status_flags() & OPEN_MODE_ACCMODE) != OPEN_MODE_RDONLY)
+					return false;
+
+				try {
+					::File_system::Status const status =
+						_vfs_fs._fs.status(file_handle());
+
+					if (status.type == ::File_system::Node_type::CONTINUOUS_FILE)
+						_read_ahead = Read_ahead::ENABLED;
+				}
+				catch (...) { }
+
+				return _read_ahead == Read_ahead::ENABLED;
+			}
+
+			Read_slot *_slot_covering(file_size offset)
+			{
+				for (Read_slot &slot : _vfs_fs._read_slots)
+					if (slot.covers(*this, offset))
+						return &slot;
+				return nullptr;
+			}
+
+			void _abandon_read_slots()
+			{
+				for (Read_slot &slot : _vfs_fs._read_slots)
+					if (slot.owner == this && !slot.pending)
+						_vfs_fs._abandon_read_slot(slot);
+			}
+
+			/**
+			 * Submit read packet
+			 *
+			 * \return  read slot, or nullptr if the packet could not be
+			 *          submitted
+			 */
+			Read_slot *_submit_read(file_size position, size_t count)
+			{
+				Read_slot *free_slot = nullptr;
+				for (Read_slot &slot : _vfs_fs._read_slots)
+					if (slot.state == Read_slot::State::FREE)
+						free_slot = &slot;
+
+				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
+
+				if (!free_slot || !source.ready_to_submit())
+					return nullptr;
+
+				::File_system::Packet_descriptor p;
+				try {
+					p = source.alloc_packet(count);
+				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+					return nullptr;
+				}
+
+				::File_system::Packet_descriptor const
+					packet(p, file_handle(),
+					       ::File_system::Packet_descriptor::READ,
+					       count, position);
+
+				*free_slot = Read_slot { .state     = Read_slot::State::QUEUED,
+				                         .owner     = this,
+				                         .packet    = packet,
+				                         .position  = position,
+				                         .requested = count,
+				                         .pending   = false };
+
+				_vfs_fs._submit_packet(packet);
+
+				return free_slot;
+			}
+
+			/**
+			 * Submit read packets following the pending read
+			 */
+			void _submit_read_ahead(size_t chunk_size)
+			{
+				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
+
+				/* leave most of the bulk buffer to other handles and writes */
+				size_t const max_bytes = source.bulk_buffer_size() / 4;
+
+				/* skip data that is already requested */
+				file_size end      = _pending_slot->position;
+				unsigned  num_used = 0;
+				size_t    num_bytes = 0;
+				for (bool found = true; found; ) {
+					found = false;
+					for (Read_slot const &slot : _vfs_fs._read_slots) {
+						if (slot.owner != this || slot.position != end)
+							continue;
+
+						end       += slot.requested;
+						num_bytes += slot.requested;
+						num_used++;
+						found = true;
+					}
+				}
+
+				for (unsigned i = num_used; i <= _window; i++, end += chunk_size) {
+
+					num_bytes += chunk_size;
+					if (num_bytes > max_bytes || !_submit_read(end, chunk_size))
+						break;
+				}
+			}
 
 			bool queue_read(size_t count) override
 			{
-				return _queue_read(count, seek());
+				if (_pending_slot)
+					return true;
+
+				file_size const offset = seek();
+
+				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
+
+				size_t const max_packet_size = source.bulk_buffer_size() / 2;
+				size_t const clipped_count   = Genode::max(min(max_packet_size, count), (size_t)1);
+
+				if (offset != _next_offset) {
+					_abandon_read_slots();
+					_window = 0;
+				} else if (_read_ahead_enabled()) {
+					_window = _window ? min(2*_window, (unsigned)MAX_READ_AHEAD) : 1;
+				}
+
+				Read_slot *slot = _slot_covering(offset);
+				if (!slot) {
+					slot = _submit_read(offset, clipped_count);
+
+					/* make room for the next attempt */
+					if (!slot) {
+						_vfs_fs._discard_read_ahead();
+						return false;
+					}
+				}
+
+				read_ready_state = Fs_file_system::Handle_state::Read_ready_state::IDLE;
+
+				slot->pending   = true;
+				_pending_slot   = slot;
+				_pending_offset = offset;
+
+				if (_window)
+					_submit_read_ahead(clipped_count);
+
+				return true;
 			}
 
 			Read_result complete_read(Byte_range_ptr const &dst, size_t &out_count) override
 			{
-				return _complete_read(dst, out_count);
+				if (!_pending_slot)
+					return READ_ERR_INVALID;
+
+				Read_slot &slot = *_pending_slot;
+
+				if (slot.state != Read_slot::State::ACK)
+					return READ_QUEUED;
+
+				_pending_slot = nullptr;
+				slot.pending  = false;
+
+				if (!slot.packet.succeeded()) {
+					_vfs_fs._abandon_read_slot(slot);
+					_abandon_read_slots();
+					_next_offset = ~0ULL;
+					return READ_ERR_IO;
+				}
+
+				file_size const skip      = _pending_offset - slot.position;
+				file_size const available = slot.length() > skip
+				                          ? slot.length() - skip : 0;
+				size_t    const num_bytes = (size_t)min(available,
+				                                        (file_size)dst.num_bytes);
+
+				memcpy(dst.start,
+				       _vfs_fs._fs.tx()->packet_content(slot.packet) + skip,
+				       num_bytes);
+
+				out_count    = num_bytes;
+				_next_offset = _pending_offset + num_bytes;
+
+				if (skip + num_bytes < slot.length())
+					return READ_OK;
+
+				/*
+				 * A packet shorter than requested hit the end of the file.
+				 * Data read ahead beyond is void and the next read must
+				 * ask the server again as the file may have grown meanwhile.
+				 */
+				bool const end_of_file = slot.length() < slot.requested;
+
+				_vfs_fs._abandon_read_slot(slot);
+
+				if (end_of_file) {
+					_abandon_read_slots();
+					_window = 0;
+				}
+				return READ_OK;
 			}
 		};
 
@@ -434,15 +860,17 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			friend Genode::Id_space<::File_system::Node>;
 
 			::File_system::Watch_handle const  fs_handle;
+			Node_id                     const  node_id;
 
 			Fs_vfs_watch_handle(Vfs::File_system            &fs,
 			                    Allocator                   &alloc,
 			                    Handle_space                &space,
-			                    ::File_system::Watch_handle  handle)
+			                    ::File_system::Watch_handle  handle,
+			                    Node_id                      node_id)
 			:
 				Vfs_watch_handle(fs, alloc),
 				Handle_space::Element(*this, space, handle),
-				fs_handle(handle)
+				fs_handle(handle), node_id(node_id)
 			{ }
 		};
 
@@ -475,6 +903,7 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				_submit_packet(packet_in);
 			}
 			catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+				_discard_read_ahead();
 				_write_would_block = true;
 				return Write_result::WRITE_ERR_WOULD_BLOCK;
 			}
@@ -499,6 +928,12 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				_write_would_block = false;
 				_peer.schedule_wakeup();
 
+				if (packet.operation() == Packet_descriptor::READ
+				 && _read_slot_acked(packet)) {
+					any_ack_handled = true;
+					continue;
+				}
+
 				Handle_space::Id const id(packet.handle());
 
 				auto handle_fn = [&] (Fs_vfs_handle &handle)
@@ -538,6 +973,7 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				try {
 					if (packet.operation() == Packet_descriptor::CONTENT_CHANGED) {
 						_watch_handle_space.apply<Fs_vfs_watch_handle>(id, [&] (Fs_vfs_watch_handle &handle) {
+							_discard_read_data_of(handle.node_id);
 							handle.watch_response(); });
 					} else {
 						_handle_space.apply<Fs_vfs_handle>(id, handle_fn);
@@ -752,7 +1188,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				                                           mode, create);
 
 				*out_handle = new (alloc)
-					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space, file, *this);
+					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space, file, *this,
+					                   Node_id::from_path(Absolute_path(path).base()),
+					                   Node_id::from_path(dir_path.base()));
 			}
 			catch (::File_system::Lookup_failed)       { return OPEN_ERR_UNACCESSIBLE;  }
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM;       }
@@ -834,7 +1272,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		{
 			Fs_vfs_handle *fs_handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
-			_fs.close(fs_handle->file_handle());
+			if (!fs_handle->defer_close())
+				_fs.close(fs_handle->file_handle());
+
 			destroy(fs_handle->alloc(), fs_handle);
 		}
 
@@ -857,7 +1297,8 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			try {
 				*handle = new (alloc)
 					Fs_vfs_watch_handle(
-						*this, alloc, _watch_handle_space, fs_handle);
+						*this, alloc, _watch_handle_space, fs_handle,
+						Node_id::from_path(Absolute_path(path).base()));
 				return WATCH_OK;
 			}
 			catch (Out_of_ram)  { res = WATCH_ERR_OUT_OF_RAM;  }
@@ -892,7 +1333,12 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		{
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
-			return _write(handle, handle.seek(), src, out_count);
+			Write_result const result = _write(handle, handle.seek(), src, out_count);
+
+			if (result == Write_result::WRITE_OK)
+				handle.written();
+
+			return result;
 		}
 
 		bool queue_read(Vfs_handle *vfs_handle, size_t count) override
@@ -955,10 +1401,13 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
+
+				/* drop read-ahead data of the truncated file */
+				handle->written();
 			}
 			catch (::File_system::Invalid_handle)    { return FTRUNCATE_ERR_NO_PERM; }
 			catch (::File_system::Permission_denied) { return FTRUNCATE_ERR_NO_PERM; }
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2011-2017 Genode Labs GmbH
+ * Copyright (C) 2011-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -17,6 +17,7 @@
 #include <rom_session/connection.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
+#include <os/path_index.h>
 #include <base/attached_rom_dataspace.h>
 
 namespace Vfs { class Tar_file_system; }
@@ -195,6 +196,24 @@ class Vfs::Tar_file_system : public File_system
 	{
 		using Tar_vfs_handle::Tar_vfs_handle;
 
+		/* last visited directory entry, which speeds up sequential reads */
+		Node const *_cursor_node  = nullptr;
+		unsigned    _cursor_index = 0;
+
+		Node const *_lookup_child(unsigned index)
+		{
+			Node const *node = nullptr;
+
+			if (_cursor_node && index >= _cursor_index)
+				node = _cursor_node->lookup_sibling(index - _cursor_index);
+			else
+				node = _node->lookup_child(index);
+
+			_cursor_node  = node;
+			_cursor_index = index;
+			return node;
+		}
+
 		Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 		{
 			if (dst.num_bytes < sizeof(Dirent))
@@ -204,7 +223,7 @@ class Vfs::Tar_file_system : public File_system
 
 			unsigned const index = (unsigned)(seek() / sizeof(Dirent));
 
-			Node const *node_ptr = _node->lookup_child(index);
+			Node const *node_ptr = _lookup_child(index);
 
 			if (!node_ptr) {
 				dirent = Dirent { };
@@ -287,73 +306,76 @@ class Vfs::Tar_file_system : public File_system
 	typedef Genode::Token<Scanner_policy_path_element> Path_element_token;
 
 
-	struct Node : List<Node>, List<Node>::Element
+	struct Node : List<Node>, List<Node>::Element, Genode::Path_index<Node>::Element
 	{
-		char const *name;
+		char const   *name;
 		Record const *record;
+		file_size     num_dirent = 0;
+
+		/**
+		 * Constructor
+		 *
+		 * \param path  canonical absolute path of node
+		 * \param len   length of path
+		 * \param name  last path element
+		 */
+		Node(char const *path, size_t len, char const *name, Record const *record)
+		:
+			Genode::Path_index<Node>::Element(path, len), name(name), record(record)
+		{ }
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
-
-		Node *lookup(char const *name)
+		void add_child(Node &child)
 		{
-			Absolute_path lookup_path(name);
-
-			Node *parent_node = this;
-			Node *child_node;
-
-			Path_element_token t(lookup_path.base());
-
-			while (t) {
-
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
-
-				char path_element[MAX_PATH_LEN];
+			insert(&child);
+			num_dirent++;
+		}
 
-				t.string(path_element, sizeof(path_element));
+		Node const *lookup_sibling(unsigned index) const
+		{
+			Node const *node = this;
+			for (; node && index; node = node->next(), index--);
+			return node;
+		}
 
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
-					}
-				}
+		Node const *lookup_child(unsigned index) const
+		{
+			return first() ? first()->lookup_sibling(index) : nullptr;
+		}
 
-				if (!child_node)
-					return 0;
+	};
 
-				t = t.next();
-			}
+	/* index of all nodes by their canonical absolute path */
+	Genode::Path_index<Node> _node_index { _alloc };
 
-			return parent_node;
-		}
+	Node _root_node { "/", 1, "", nullptr };
 
+	/**
+	 * Return node for path
+	 */
+	Node *_lookup(char const *path)
+	{
+		/* paths passed by the VFS are usually canonical already */
+		if (Node *node = _node_index.lookup(path))
+			return node;
 
-		Node const *lookup_child(int index) const
-		{
-			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
-			}
+		Absolute_path const canonical_path(path);
 
-			return 0;
-		}
+		char const *p   = canonical_path.base();
+		size_t      len = strlen(p);
 
+		if (len > 1 && p[len - 1] == '/')
+			len--;
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
+		if (len == 0) {
+			p   = "/";
+			len = 1;
 		}
-
-	} _root_node;
+		return _node_index.lookup(p, len);
+	}
 
 
 	/*
-	 *  Create a Node for a tar record and insert it into the node list
+	 *  Create a Node for a tar record and insert it into the node tree
 	 */
 	class Add_node_action
 	{
@@ -363,11 +385,14 @@ class Vfs::Tar_file_system : public File_system
 
 			Node &_root_node;
 
+			Genode::Path_index<Node> &_node_index;
+
 		public:
 
-			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+			Add_node_action(Genode::Allocator        &alloc,
+			                Node                     &root_node,
+			                Genode::Path_index<Node> &node_index)
+			: _alloc(alloc), _root_node(root_node), _node_index(node_index) { }
 
 			void operator()(Record const *record)
 			{
@@ -386,60 +411,54 @@ class Vfs::Tar_file_system : public File_system
 					current_path.import(path_element);
 				}
 
-				Path_element_token t(current_path.base());
+				char const * const path = current_path.base();
+
+				size_t len = strlen(path);
+				if (len > 1 && path[len - 1] == '/')
+					len--;
 
 				Node *parent_node = &_root_node;
-				Node *child_node;
 
-				while(t) {
+				/* visit the node of each path element, create missing nodes */
+				for (size_t start = 1, end = 1; end <= len; end++) {
+
+					if (end < len && path[end] != '/')
+						continue;
 
-					if (t.type() != Path_element_token::IDENT) {
-							t = t.next();
-							continue;
+					/* skip empty path elements */
+					if (end == start) {
+						start = end + 1;
+						continue;
 					}
 
-					Absolute_path remaining_path(t.start());
+					bool const last = (end == len);
 
-					t.string(path_element, sizeof(path_element));
+					Node *node = _node_index.lookup(path, end);
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					if (node) {
 
-					if (child_node) {
+						/*
+						 * Found a node for the record to be inserted. This is
+						 * usually a directory node without record.
+						 */
+						if (last)
+							node->record = record;
 
-						if (remaining_path.has_single_element()) {
-							/* Found a node for the record to be inserted.
-							 * This is usually a directory node without
-							 * record. */
-							child_node->record = record;
-						}
 					} else {
-						if (remaining_path.has_single_element()) {
-
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
-						} else {
-
-							/* create a directory node without record */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
-						}
-						parent_node->insert(child_node);
+
+						char * const node_path = (char *)_alloc.alloc(end + 1);
+						copy_cstring(node_path, path, end + 1);
+
+						/* directory nodes of intermediate elements have no record */
+						node = new (_alloc)
+							Node(node_path, end, node_path + start, last ? record : 0);
+
+						parent_node->add_child(*node);
+						_node_index.insert(*node);
 					}
 
-					parent_node = child_node;
-					t = t.next();
+					parent_node = node;
+					start       = end + 1;
 				}
 			}
 	};
@@ -478,37 +497,12 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
-	{
-		Node     &root_node;
-		bool      valid;              /* true after first lookup */
-		char      key[256];           /* key used for lookup */
-		file_size cached_num_dirent;  /* cached value */
-
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
-
-		file_size num_dirent(char const *path)
-		{
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				copy_cstring(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
-			}
-			return cached_num_dirent;
-		}
-	} _cached_num_dirent;
-
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
@@ -522,9 +516,9 @@ class Vfs::Tar_file_system : public File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -539,11 +533,10 @@ class Vfs::Tar_file_system : public File_system
 		Tar_file_system(Vfs::Env &env, Genode::Xml_node config)
 		:
 			_env(env.env()), _alloc(env.alloc()),
-			_rom_name(config.attribute_value("name", Rom_name())),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_rom_name(config.attribute_value("name", Rom_name()))
 		{
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			_node_index.insert(_root_node);
+			_for_each_tar_record_do(Add_node_action(_alloc, _root_node, _node_index));
 		}
 
 		/*********************************
@@ -640,14 +633,15 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_dirent : 0;
 		}
 
 		bool directory(char const *path) override
@@ -669,7 +663,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 			return node ? path : 0;
 		}
 
@@ -0,0 +1,323 @@
+/*
+ * \brief  Cache of blocks with LRU replacement
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <block/request.h>
+#include <util/construct_at.h>
+#include <util/misc_math.h>
+
+namespace Block_cache {
+
+	using namespace Genode;
+
+	using Block::block_number_t;
+	using Block::block_count_t;
+
+	class Cache;
+}
+
+
+/**
+ * Fixed-size set of cached blocks
+ *
+ * Each entry holds one block of the back-end session. Entries are found by
+ * their block number via a hash table. Each used entry is a member of
+ * exactly one chain according to its state:
+ *
+ * - Clean entries reside in the LRU chain, most recently used first. Only
+ *   these entries are subject to replacement.
+ * - Dirty entries reside in the dirty chain, in the order they became dirty.
+ * - Entries with a back-end operation in flight are not chained at all.
+ *
+ * After changing the state of an entry, the user of the cache must call
+ * 'update' to re-file the entry into the matching chain.
+ */
+class Block_cache::Cache : Noncopyable
+{
+	public:
+
+		struct Chain;
+
+		struct Entry
+		{
+			block_number_t lba = 0;
+
+			bool used  = false;  /* entry is registered at hash table */
+			bool valid = false;  /* content corresponds to the block */
+			bool dirty = false;  /* content not yet written back */
+			bool io    = false;  /* back-end operation in flight */
+
+			bool _counted_dirty = false;  /* accounted in '_num_dirty' */
+
+			Entry *_hash_next = nullptr;
+			Entry *_prev      = nullptr;
+			Entry *_next      = nullptr;
+			Chain *_chain     = nullptr;
+
+			Entry() { }
+
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Entry(Entry const &);
+				Entry &operator = (Entry const &);
+		};
+
+		struct Chain
+		{
+			Entry *head  = nullptr;
+			Entry *tail  = nullptr;
+			size_t count = 0;
+
+			Chain() { }
+
+			Chain(Chain const &) = delete;
+			Chain &operator = (Chain const &) = delete;
+
+			void insert_head(Entry &e)
+			{
+				e._prev = nullptr;
+				e._next = head;
+				if (head) head->_prev = &e; else tail = &e;
+				head = &e;
+				e._chain = this;
+				count++;
+			}
+
+			void insert_tail(Entry &e)
+			{
+				e._next = nullptr;
+				e._prev = tail;
+				if (tail) tail->_next = &e; else head = &e;
+				tail = &e;
+				e._chain = this;
+				count++;
+			}
+
+			void remove(Entry &e)
+			{
+				if (e._prev) e._prev->_next = e._next; else head = e._next;
+				if (e._next) e._next->_prev = e._prev; else tail = e._prev;
+				e._prev = e._next = nullptr;
+				e._chain = nullptr;
+				count--;
+			}
+		};
+
+	private:
+
+		Allocator &_alloc;
+
+		size_t const _block_size;
+		size_t const _num_entries;
+
+		Attached_ram_dataspace _data_ds;
+
+		char  * const _data    = _data_ds.local_addr<char>();
+		Entry * const _entries = (Entry *)_alloc.alloc(_num_entries*sizeof(Entry));
+
+		unsigned const _buckets_log2 = (unsigned)log2(_num_entries) + 1;
+		size_t   const _num_buckets  = (size_t)1 << _buckets_log2;
+
+		Entry ** const _buckets = (Entry **)_alloc.alloc(_num_buckets*sizeof(Entry *));
+
+		Chain _free  { };
+		Chain _lru   { };
+		Chain _dirty { };
+
+		/*
+		 * Number of dirty entries including those with an operation in
+		 * flight, which are not part of the dirty chain
+		 */
+		size_t _num_dirty = 0;
+
+		void _account_dirty(Entry &e)
+		{
+			if (e.dirty == e._counted_dirty)
+				return;
+
+			if (e.dirty) _num_dirty++;
+			else         _num_dirty--;
+
+			e._counted_dirty = e.dirty;
+		}
+
+		Entry *&_bucket(block_number_t lba)
+		{
+			/* Fibonacci hashing spreads runs of consecutive block numbers */
+			uint64_t const h = lba * 0x9e3779b97f4a7c15ull;
+			return _buckets[h >> (64 - _buckets_log2)];
+		}
+
+		void _unregister(Entry &e)
+		{
+			for (Entry **p = &_bucket(e.lba); *p; p = &(*p)->_hash_next) {
+				if (*p != &e)
+					continue;
+
+				*p = e._hash_next;
+				break;
+			}
+			e._hash_next = nullptr;
+			e.used = e.valid = e.dirty = e.io = false;
+			_account_dirty(e);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Cache(Cache const &);
+		Cache &operator = (Cache const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Cache(Ram_allocator &ram, Region_map &rm, Allocator &alloc,
+		      size_t block_size, size_t num_entries)
+		:
+			_alloc(alloc), _block_size(block_size),
+			_num_entries(max(num_entries, (size_t)1)),
+			_data_ds(ram, rm, _num_entries*_block_size)
+		{
+			for (size_t i = 0; i < _num_buckets; i++)
+				_buckets[i] = nullptr;
+
+			for (size_t i = 0; i < _num_entries; i++)
+				_free.insert_tail(*construct_at<Entry>(&_entries[i]));
+		}
+
+		~Cache()
+		{
+			_alloc.free(_buckets, _num_buckets*sizeof(Entry *));
+			_alloc.free(_entries, _num_entries*sizeof(Entry));
+		}
+
+		size_t num_entries() const { return _num_entries; }
+		size_t num_used()    const { return _num_entries - _free.count; }
+		size_t num_dirty()   const { return _num_dirty; }
+
+		/**
+		 * Return number of entries that can be allocated without delay
+		 */
+		size_t num_available() const { return _free.count + _lru.count; }
+
+		/**
+		 * Return true if the entry counts as available, i.e., it may be
+		 * replaced by 'alloc'
+		 */
+		bool replaceable(Entry const &e) const { return e._chain == &_lru; }
+
+		char *data(Entry const &e) const {
+			return _data + (size_t)(&e - _entries)*_block_size; }
+
+		Entry *lookup(block_number_t lba)
+		{
+			for (Entry *e = _bucket(lba); e; e = e->_hash_next)
+				if (e->lba == lba)
+					return e;
+
+			return nullptr;
+		}
+
+		/**
+		 * Allocate entry for block 'lba', replacing the least recently used
+		 * clean entry if no entry is free
+		 *
+		 * The returned entry is not chained and holds no valid content.
+		 *
+		 * \return  entry or nullptr if all entries are dirty or busy
+		 */
+		Entry *alloc(block_number_t lba)
+		{
+			Entry *e = _free.head ? _free.head : _lru.tail;
+			if (!e)
+				return nullptr;
+
+			e->_chain->remove(*e);
+
+			if (e->used)
+				_unregister(*e);
+
+			e->lba  = lba;
+			e->used = true;
+
+			Entry *&bucket = _bucket(lba);
+			e->_hash_next = bucket;
+			bucket = e;
+
+			return e;
+		}
+
+		/**
+		 * Re-file entry according to its state
+		 *
+		 * Entries that hold no valid content and are not dirty are released.
+		 */
+		void update(Entry &e)
+		{
+			_account_dirty(e);
+
+			/* keep the position of an entry that is written to repeatedly */
+			if (e.dirty && !e.io && e._chain == &_dirty)
+				return;
+
+			if (e._chain)
+				e._chain->remove(e);
+
+			if (e.io)
+				return;
+
+			if (e.dirty) {
+				_dirty.insert_tail(e);
+				return;
+			}
+
+			if (e.used && !e.valid)
+				_unregister(e);
+
+			if (e.used)
+				_lru.insert_head(e);
+			else
+				_free.insert_head(e);
+		}
+
+		/**
+		 * Mark entry as most recently used
+		 */
+		void touch(Entry &e)
+		{
+			if (e._chain != &_lru || _lru.head == &e)
+				return;
+
+			_lru.remove(e);
+			_lru.insert_head(e);
+		}
+
+		/**
+		 * Return the entry that is dirty for the longest time
+		 */
+		Entry *oldest_dirty() { return _dirty.head; }
+};
+
+#endif /* _CACHE_H_ */
@@ -0,0 +1,1002 @@
+/*
+ * \brief  Write-back block cache
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <block/request_stream.h>
+#include <block_session/connection.h>
+#include <os/reporter.h>
+#include <root/root.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include <cache.h>
+
+namespace Block_cache {
+
+	struct Request_slot;
+	struct Job;
+	struct Statistics;
+	struct Session_buffer;
+	class  Session_component;
+	class  Main;
+
+	typedef Block::Connection<Job>          Block_connection;
+	typedef Block::Request_stream::Response Response;
+	typedef Block::Operation::Type          Type;
+}
+
+
+/**
+ * Client request that was accepted but not yet acknowledged
+ */
+struct Block_cache::Request_slot
+{
+	enum class State { FREE, PENDING, DONE, ORPHAN };
+	enum class Kind  { CACHED_READ, BYPASS, SYNC };
+
+	State          state     = State::FREE;
+	Kind           kind      = Kind::CACHED_READ;
+	Block::Request request   { };
+	addr_t         addr      = 0;      /* local address of request content */
+	bool           submitted = false;  /* back-end job was created */
+	unsigned       jobs      = 0;      /* back-end jobs not yet completed */
+	bool           failed    = false;  /* one of the back-end jobs failed */
+
+	void done(bool success)
+	{
+		request.success = success;
+		state = State::DONE;
+	}
+
+	bool overlaps(Block::Operation const &op) const
+	{
+		Block::Operation const &own = request.operation;
+
+		return op.block_number < own.block_number + own.count
+		    && own.block_number < op.block_number + op.count;
+	}
+};
+
+
+struct Block_cache::Job : Block_connection::Job
+{
+	enum class Type { FILL, WRITE_BACK, BYPASS, SYNC };
+
+	Type const type;
+
+	/* client request served by a BYPASS or SYNC job */
+	Request_slot * const slot;
+
+	Registry<Job>::Element _elem;
+
+	Job(Registry<Job> &registry, Block_connection &connection,
+	    Block::Operation operation, Type type, Request_slot *slot)
+	:
+		Block_connection::Job(connection, operation), type(type), slot(slot),
+		_elem(registry, *this)
+	{ }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Job(Job const &);
+		Job &operator = (Job const &);
+};
+
+
+struct Block_cache::Statistics
+{
+	uint64_t hits;          /* read blocks found in the cache */
+	uint64_t misses;        /* read blocks fetched from the back end */
+	uint64_t bypassed;      /* blocks of large requests passed through */
+	uint64_t written;       /* blocks written to the cache */
+	uint64_t written_back;  /* blocks written back to the back end */
+
+	unsigned hit_rate_percent() const
+	{
+		uint64_t const total = hits + misses;
+		return total ? (unsigned)((hits*100)/total) : 0;
+	}
+
+	bool operator != (Statistics const &other) const
+	{
+		return hits         != other.hits
+		    || misses       != other.misses
+		    || bypassed     != other.bypassed
+		    || written      != other.written
+		    || written_back != other.written_back;
+	}
+};
+
+
+struct Block_cache::Session_buffer
+{
+	Attached_ram_dataspace ds;
+
+	Session_buffer(Ram_allocator &ram, Region_map &rm, size_t size)
+	: ds(ram, rm, size) { }
+};
+
+
+class Block_cache::Session_component : public  Rpc_object<Block::Session>,
+                                       private Session_buffer,
+                                       public  Block::Request_stream
+{
+	private:
+
+		Entrypoint &_ep;
+
+	public:
+
+		Session_component(Env &env, size_t buffer_size, Info info,
+		                  Signal_context_capability sigh)
+		:
+			Session_buffer(env.ram(), env.rm(), buffer_size),
+			Request_stream(env.rm(), ds.cap(), env.ep(), sigh, info),
+			_ep(env.ep())
+		{
+			_ep.manage(*this);
+		}
+
+		~Session_component() { _ep.dissolve(*this); }
+
+		Info info() const override { return Request_stream::info(); }
+
+		Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
+};
+
+
+class Block_cache::Main : Rpc_object<Typed_root<Block::Session>>
+{
+	private:
+
+		Env &_env;
+
+		Attached_rom_dataspace _config { _env, "config" };
+
+		Heap _heap { _env.ram(), _env.rm() };
+
+		Number_of_bytes const _io_buffer_size =
+			_config.xml().attribute_value("io_buffer",
+			                              Number_of_bytes(4*1024*1024));
+
+		Number_of_bytes const _cache_size =
+			_config.xml().attribute_value("cache_size",
+			                              Number_of_bytes(16*1024*1024));
+
+		Allocator_avl    _block_alloc { &_heap };
+		Block_connection _block       { _env, &_block_alloc, _io_buffer_size };
+
+		Block::Session::Info const _info = _block.info();
+
+		size_t const _block_size = _info.block_size;
+
+		bool const _writeable = _info.writeable
+		                     && _config.xml().attribute_value("writeable", true);
+
+		bool const _verbose = _config.xml().attribute_value("verbose", false);
+
+		Cache _cache { _env.ram(), _env.rm(), _heap, _block_size,
+		               _cache_size / _block_size };
+
+		/*
+		 * Requests larger than a quarter of the cache are passed through to
+		 * the back end to keep sequential bulk transfers from flushing the
+		 * cache.
+		 */
+		block_count_t const _max_cached_count =
+			max(_cache.num_entries() / 4, (size_t)1);
+
+		/* number of dirty blocks that triggers the write back */
+		size_t const _dirty_limit =
+			_config.xml().attribute_value("max_dirty",
+			                              Number_of_bytes(_cache_size / 2))
+			/ _block_size;
+
+		/* maximum number of adjacent dirty blocks written back at once */
+		block_count_t const _max_write_back =
+			max(_io_buffer_size / 8 / _block_size, (size_t)1);
+
+		/*
+		 * Bypassing requests are split into jobs that fit into a single
+		 * packet each. So the content of a write is produced only when
+		 * submitting the job, and jobs not yet submitted can be dropped
+		 * when the client vanishes.
+		 */
+		block_count_t const _max_bypass_count =
+			max(_io_buffer_size / 4 / _block_size, (size_t)1);
+
+		Constructible<Session_component> _session { };
+
+		enum { MAX_REQUESTS = 128, MAX_JOBS = 64 };
+
+		Request_slot _slots[MAX_REQUESTS] { };
+
+		Registry<Job> _job_registry { };
+
+		unsigned _jobs             = 0;
+		unsigned _writes_in_flight = 0;
+
+		Request_slot *_sync_slot = nullptr;
+
+		bool _flush_all    = false;  /* write back all dirty blocks */
+		bool _need_space   = false;  /* requests wait for clean entries */
+		bool _write_failed = false;  /* write back failed since last sync */
+		bool _write_stall  = false;  /* no write back until next timeout */
+
+		Statistics _stats    { };
+		Statistics _reported { };
+
+		Constructible<Expanding_reporter> _reporter { };
+
+		Signal_handler<Main>    _request_handler { _env.ep(), *this, &Main::_handle };
+		Io_signal_handler<Main> _io_handler      { _env.ep(), *this, &Main::_handle };
+
+		Timer::Connection _timer { _env };
+
+		uint64_t const _writeback_interval_ms =
+			max(_config.xml().attribute_value("writeback_interval_ms", (uint64_t)1000),
+			    (uint64_t)10);
+
+		Timer::Periodic_timeout<Main> _writeback_timeout {
+			_timer, *this, &Main::_handle_writeback_timeout,
+			Microseconds { _writeback_interval_ms*1000 } };
+
+		Request_slot *_alloc_slot()
+		{
+			for (Request_slot &slot : _slots)
+				if (slot.state == Request_slot::State::FREE)
+					return &slot;
+
+			return nullptr;
+		}
+
+		void _submit_job(Block::Operation operation, Job::Type type,
+		                 Request_slot *slot)
+		{
+			new (_heap) Job(_job_registry, _block, operation, type, slot);
+
+			_jobs++;
+			if (operation.type == Type::WRITE)
+				_writes_in_flight++;
+
+			if (slot) {
+				slot->submitted = true;
+				slot->jobs++;
+			}
+		}
+
+		void _destroy_job(Job &job)
+		{
+			if (job.operation().type == Type::WRITE)
+				_writes_in_flight--;
+
+			if (job.slot)
+				job.slot->jobs--;
+
+			_jobs--;
+			destroy(_heap, &job);
+		}
+
+		void _submit_bypass(Request_slot &slot)
+		{
+			Block::Operation const op = slot.request.operation;
+
+			for (block_count_t i = 0; i < op.count; i += _max_bypass_count) {
+
+				Block::Operation const part {
+					.type         = op.type,
+					.block_number = op.block_number + i,
+					.count        = min(_max_bypass_count, op.count - i) };
+
+				_submit_job(part, Job::Type::BYPASS, &slot);
+			}
+
+			_stats.bypassed += op.count;
+		}
+
+		/**
+		 * Return local address of the content of a bypassing job
+		 */
+		addr_t _bypass_addr(Job const &job, off_t offset) const
+		{
+			block_number_t const first = job.slot->request.operation.block_number;
+
+			return job.slot->addr + (addr_t)offset
+			     + (addr_t)(job.operation().block_number - first)*_block_size;
+		}
+
+		template <typename FN>
+		void _for_each_entry(Block::Operation const &op, FN const &fn)
+		{
+			for (block_count_t i = 0; i < op.count; i++)
+				if (Cache::Entry *e = _cache.lookup(op.block_number + i))
+					fn(*e, i);
+		}
+
+		enum class Pass { ACCEPT, COMPLETE, FILL };
+
+		/**
+		 * Serve read request from the cache, fetching missing blocks
+		 *
+		 * \return true if progress was made
+		 */
+		bool _read_cached(Request_slot &slot, Pass pass)
+		{
+			Block::Operation const op = slot.request.operation;
+
+			bool complete = true;
+			bool progress = false;
+
+			/* consecutive blocks fetched by one back-end operation */
+			Block::Operation fill { .type = Type::READ, .block_number = 0, .count = 0 };
+
+			auto submit_fill = [&] ()
+			{
+				if (!fill.count)
+					return;
+
+				_submit_job(fill, Job::Type::FILL, nullptr);
+				fill.count = 0;
+				progress   = true;
+			};
+
+			for (block_count_t i = 0; i < op.count; i++) {
+
+				block_number_t const lba = op.block_number + i;
+
+				Cache::Entry *e = _cache.lookup(lba);
+
+				if (pass == Pass::ACCEPT) {
+					if (e && e->valid) _stats.hits++;
+					else               _stats.misses++;
+				}
+
+				if (e) {
+					complete &= e->valid;
+					submit_fill();
+					continue;
+				}
+
+				complete = false;
+
+				if (pass == Pass::COMPLETE || (!fill.count && _jobs >= MAX_JOBS))
+					continue;
+
+				e = _cache.alloc(lba);
+				if (!e) {
+					if (!_writes_in_flight)
+						_need_space = true;
+					submit_fill();
+					continue;
+				}
+
+				e->io = true;
+
+				if (!fill.count)
+					fill.block_number = lba;
+				fill.count++;
+			}
+			submit_fill();
+
+			if (!complete)
+				return progress;
+
+			for (block_count_t i = 0; i < op.count; i++) {
+				Cache::Entry &e = *_cache.lookup(op.block_number + i);
+				memcpy((void *)(slot.addr + i*_block_size), _cache.data(e), _block_size);
+				_cache.touch(e);
+			}
+
+			slot.done(true);
+			return true;
+		}
+
+		/**
+		 * Store content of write request in the cache
+		 *
+		 * The caller must ensure that enough entries are available for the
+		 * missing blocks apart from the clean entries of the request.
+		 */
+		void _write_cached(Block::Operation const &op, addr_t addr)
+		{
+			auto write = [&] (Cache::Entry &e, block_count_t i)
+			{
+				memcpy(_cache.data(e), (void *)(addr + i*_block_size), _block_size);
+				e.valid = e.dirty = true;
+				_cache.update(e);
+			};
+
+			/* turn cached blocks dirty first to protect them from replacement */
+			_for_each_entry(op, write);
+
+			for (block_count_t i = 0; i < op.count; i++) {
+
+				block_number_t const lba = op.block_number + i;
+
+				if (_cache.lookup(lba))
+					continue;
+
+				if (Cache::Entry *e = _cache.alloc(lba))
+					write(*e, i);
+			}
+
+			_stats.written += op.count;
+		}
+
+		/**
+		 * Update cached blocks overwritten by a bypassing write request
+		 */
+		void _update_cached(Block::Operation const &op, addr_t addr)
+		{
+			_for_each_entry(op, [&] (Cache::Entry &e, block_count_t i) {
+				memcpy(_cache.data(e), (void *)(addr + i*_block_size), _block_size);
+				e.valid = true;
+
+				/* repeat write back that may overtake the bypassing write */
+				if (e.io)
+					e.dirty = true;
+
+				_cache.update(e);
+			});
+		}
+
+		Response _accept(Block::Request const &request)
+		{
+			Block::Operation const &op = request.operation;
+
+			/* hold back new requests until the cache is flushed */
+			if (_sync_slot)
+				return Response::RETRY;
+
+			/* only READ/WRITE/SYNC requests, others are noops for now */
+			if (op.type == Type::TRIM || op.type == Type::INVALID)
+				return Response::REJECTED;
+
+			if (op.type == Type::WRITE && !_writeable)
+				return Response::REJECTED;
+
+			addr_t addr = 0;
+			if (Block::Operation::has_payload(op.type)) {
+
+				if (op.block_number + op.count > _info.block_count)
+					return Response::REJECTED;
+
+				_session->with_content(request, [&] (void *ptr, size_t) {
+					addr = (addr_t)ptr; });
+
+				if (!addr)
+					return Response::REJECTED;
+			}
+
+			bool const bypass = op.count > _max_cached_count;
+
+			if (op.type == Type::WRITE && !bypass) {
+
+				/*
+				 * Clean cached blocks of the request turn dirty before the
+				 * missing blocks are allocated, which removes them from the
+				 * available entries.
+				 */
+				size_t missing = 0, replaceable = 0;
+				for (block_count_t i = 0; i < op.count; i++) {
+					Cache::Entry const *e = _cache.lookup(op.block_number + i);
+					if (!e)
+						missing++;
+					else if (_cache.replaceable(*e))
+						replaceable++;
+				}
+
+				if (missing + replaceable > _cache.num_available()) {
+					if (!_writes_in_flight)
+						_need_space = true;
+					return Response::RETRY;
+				}
+			}
+
+			if ((bypass || op.type == Type::SYNC) && _jobs >= MAX_JOBS)
+				return Response::RETRY;
+
+			Request_slot * const slot_ptr = _alloc_slot();
+			if (!slot_ptr)
+				return Response::RETRY;
+
+			Request_slot &slot = *slot_ptr;
+
+			slot.state     = Request_slot::State::PENDING;
+			slot.request   = request;
+			slot.addr      = addr;
+			slot.submitted = false;
+			slot.jobs      = 0;
+			slot.failed    = false;
+
+			switch (op.type) {
+
+			case Type::SYNC:
+				slot.kind  = Request_slot::Kind::SYNC;
+				_sync_slot = &slot;
+				_flush_all = true;
+				break;
+
+			case Type::READ:
+				if (bypass) {
+					slot.kind = Request_slot::Kind::BYPASS;
+					_submit_bypass(slot);
+				} else {
+					slot.kind = Request_slot::Kind::CACHED_READ;
+					_read_cached(slot, Pass::ACCEPT);
+				}
+				break;
+
+			case Type::WRITE:
+				if (bypass) {
+					slot.kind = Request_slot::Kind::BYPASS;
+					_update_cached(op, addr);
+					_submit_bypass(slot);
+				} else {
+					_write_cached(op, addr);
+					slot.done(true);
+				}
+				break;
+
+			case Type::TRIM:
+			case Type::INVALID:
+				break;
+			}
+
+			return Response::ACCEPTED;
+		}
+
+		/**
+		 * Complete read requests waiting for blocks from the back end
+		 */
+		bool _complete_reads()
+		{
+			bool progress = false;
+
+			auto for_each_waiting_read = [&] (auto const &fn)
+			{
+				for (Request_slot &slot : _slots)
+					if (slot.state == Request_slot::State::PENDING
+					 && slot.kind  == Request_slot::Kind::CACHED_READ)
+						fn(slot);
+			};
+
+			/*
+			 * Finish all requests with complete content before allocating
+			 * entries for the others, which may replace blocks needed by
+			 * the former.
+			 */
+			for_each_waiting_read([&] (Request_slot &slot) {
+				progress |= _read_cached(slot, Pass::COMPLETE); });
+
+			for_each_waiting_read([&] (Request_slot &slot) {
+				progress |= _read_cached(slot, Pass::FILL); });
+
+			return progress;
+		}
+
+		/**
+		 * Submit acknowledgements of completed requests
+		 */
+		bool _acknowledge()
+		{
+			bool progress = false;
+
+			_session->try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+
+				for (Request_slot &slot : _slots) {
+
+					if (slot.state != Request_slot::State::DONE)
+						continue;
+
+					ack.submit(slot.request);
+					slot.state = Request_slot::State::FREE;
+					progress   = true;
+					return;
+				}
+			});
+
+			return progress;
+		}
+
+		/**
+		 * Write back dirty blocks, coalescing adjacent blocks
+		 */
+		bool _write_back()
+		{
+			bool progress = false;
+
+			if (_write_stall)
+				return false;
+
+			auto ready = [&] (block_number_t lba)
+			{
+				Cache::Entry const *e = _cache.lookup(lba);
+				return e && e->dirty && !e->io;
+			};
+
+			while (_jobs < MAX_JOBS) {
+
+				Cache::Entry * const oldest = _cache.oldest_dirty();
+
+				bool const needed = _flush_all || _need_space
+				                 || _cache.num_dirty() > _dirty_limit;
+
+				if (!oldest || !needed)
+					break;
+
+				block_number_t start = oldest->lba;
+				block_count_t  count = 1;
+
+				while (count < _max_write_back && start > 0 && ready(start - 1)) {
+					start--;
+					count++;
+				}
+
+				while (count < _max_write_back && ready(start + count))
+					count++;
+
+				Block::Operation const op { .type         = Type::WRITE,
+				                            .block_number = start,
+				                            .count        = count };
+
+				_for_each_entry(op, [&] (Cache::Entry &e, block_count_t) {
+					e.dirty = false;
+					e.io    = true;
+					_cache.update(e);
+				});
+
+				_submit_job(op, Job::Type::WRITE_BACK, nullptr);
+
+				_stats.written_back += count;
+				_need_space = false;
+				progress    = true;
+			}
+
+			if (!_cache.oldest_dirty()) {
+				_flush_all  = false;
+				_need_space = false;
+			}
+
+			return progress;
+		}
+
+		/**
+		 * Issue back-end sync once all dirty blocks are written back
+		 */
+		bool _sync()
+		{
+			if (!_sync_slot || _sync_slot->submitted)
+				return false;
+
+			/* fail the sync right away instead of waiting for a retry */
+			if (_write_failed) {
+				_sync_slot->done(false);
+				_sync_slot    = nullptr;
+				_write_failed = false;
+				return true;
+			}
+
+			/* includes dirty entries with a fill in flight */
+			if (_cache.num_dirty()) {
+				_flush_all = true;
+				return false;
+			}
+
+			if (_writes_in_flight || _jobs >= MAX_JOBS)
+				return false;
+
+			_submit_job(_sync_slot->request.operation, Job::Type::SYNC, _sync_slot);
+			return true;
+		}
+
+		void _handle()
+		{
+			for (;;) {
+
+				bool progress = _block.update_jobs(*this);
+
+				if (_session.constructed()) {
+
+					progress |= _complete_reads();
+					progress |= _acknowledge();
+
+					_session->with_requests([&] (Block::Request request) {
+
+						Response const response = _accept(request);
+
+						if (response != Response::RETRY)
+							progress = true;
+
+						return response;
+					});
+				}
+
+				progress |= _write_back();
+				progress |= _sync();
+
+				if (!progress)
+					break;
+			}
+
+			if (_session.constructed())
+				_session->wakeup_client_if_needed();
+		}
+
+		void _report_statistics()
+		{
+			if (!(_stats != _reported))
+				return;
+
+			_reported = _stats;
+
+			if (_verbose)
+				log("hits: ",       _stats.hits,
+				    " misses: ",    _stats.misses,
+				    " hit rate: ",  _stats.hit_rate_percent(), "%",
+				    " bypassed: ",  _stats.bypassed,
+				    " written: ",   _stats.written,
+				    " written back: ", _stats.written_back);
+
+			if (!_reporter.constructed())
+				return;
+
+			_reporter->generate([&] (Xml_generator &xml) {
+				xml.attribute("hits",         _stats.hits);
+				xml.attribute("misses",       _stats.misses);
+				xml.attribute("hit_rate",     _stats.hit_rate_percent());
+				xml.attribute("bypassed",     _stats.bypassed);
+				xml.attribute("written",      _stats.written);
+				xml.attribute("written_back", _stats.written_back);
+				xml.attribute("used",         _cache.num_used());
+				xml.attribute("dirty",        _cache.num_dirty());
+			});
+		}
+
+		void _handle_writeback_timeout(Duration)
+		{
+			_flush_all   = true;
+			_write_stall = false;
+			_report_statistics();
+			_handle();
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+
+	public:
+
+		Main(Env &env) : _env(env)
+		{
+			_config.xml().with_optional_sub_node("report", [&] (Xml_node const &report) {
+				if (report.attribute_value("statistics", false))
+					_reporter.construct(_env, "statistics", "statistics"); });
+
+			_block.sigh(_io_handler);
+
+			log("caching ", _cache.num_entries(), " blocks of ", _block_size,
+			    " bytes, ", _writeable ? "write back" : "read only");
+
+			/* announce at parent */
+			env.parent().announce(env.ep().manage(*this));
+		}
+
+
+		/***********************
+		 ** Session interface **
+		 ***********************/
+
+		Capability<Session> session(Root::Session_args const &args,
+		                            Affinity const &) override
+		{
+			if (_session.constructed()) {
+				error("rejecting session request, only one session is supported");
+				throw Service_denied();
+			}
+
+			Ram_quota const ram_quota = ram_quota_from_args(args.string());
+			size_t const tx_buf_size =
+				Arg_string::find_arg(args.string(), "tx_buf_size").ulong_value(0);
+
+			if (!tx_buf_size)
+				throw Service_denied();
+
+			if (tx_buf_size > ram_quota.value) {
+				error("insufficient 'ram_quota', got ", ram_quota, ", need ",
+				      tx_buf_size);
+				throw Insufficient_ram_quota();
+			}
+
+			Block::Session::Info const info {
+				.block_size  = _info.block_size,
+				.block_count = _info.block_count,
+				.align_log2  = 0,
+				.writeable   = _writeable,
+			};
+
+			_session.construct(_env, tx_buf_size, info, _request_handler);
+			return _session->cap();
+		}
+
+		void close(Capability<Session> cap) override
+		{
+			if (!_session.constructed() || !(cap == _session->cap()))
+				return;
+
+			/*
+			 * Drop bypassing jobs not yet submitted to the back end, whose
+			 * write content vanishes with the session buffer.
+			 */
+			_job_registry.for_each([&] (Job &job) {
+				if (job.type == Job::Type::BYPASS && job.pending())
+					_destroy_job(job); });
+
+			/* keep slots referenced by in-flight jobs until their completion */
+			for (Request_slot &slot : _slots) {
+				bool const in_flight = slot.jobs
+				                    && slot.state == Request_slot::State::PENDING;
+
+				slot.state = in_flight ? Request_slot::State::ORPHAN
+				                       : Request_slot::State::FREE;
+			}
+
+			if (_sync_slot && _sync_slot->state == Request_slot::State::FREE)
+				_sync_slot = nullptr;
+
+			_session.destruct();
+		}
+
+		void upgrade(Capability<Session>, Root::Upgrade_args const &) override { }
+
+
+		/************************
+		 ** Update_jobs_policy **
+		 ************************/
+
+		void produce_write_content(Job &job, off_t offset, char *dst, size_t length)
+		{
+			Block::Operation const op = job.operation();
+
+			/* the slot is never orphaned as the job is dropped on 'close' */
+			if (job.type == Job::Type::BYPASS) {
+				memcpy(dst, (void *)_bypass_addr(job, offset), length);
+				return;
+			}
+
+			block_count_t const first = offset / _block_size;
+
+			for (block_count_t i = 0; i < length / _block_size; i++) {
+				Cache::Entry &e = *_cache.lookup(op.block_number + first + i);
+				memcpy(dst + i*_block_size, _cache.data(e), _block_size);
+			}
+		}
+
+		void consume_read_result(Job &job, off_t offset, char const *src, size_t length)
+		{
+			Block::Operation const op = job.operation();
+
+			block_count_t const first = offset / _block_size;
+			block_count_t const count = length / _block_size;
+
+			if (job.type == Job::Type::BYPASS) {
+
+				if (job.slot->state == Request_slot::State::ORPHAN)
+					return;
+
+				char * const dst = (char *)_bypass_addr(job, offset);
+
+				memcpy(dst, src, length);
+
+				/* blocks present in the cache are at least as recent */
+				for (block_count_t i = 0; i < count; i++) {
+					Cache::Entry const *e = _cache.lookup(op.block_number + first + i);
+					if (e && e->valid)
+						memcpy(dst + i*_block_size, _cache.data(*e), _block_size);
+				}
+				return;
+			}
+
+			for (block_count_t i = 0; i < count; i++) {
+
+				Cache::Entry *e = _cache.lookup(op.block_number + first + i);
+
+				/* skip blocks written by the client in the meantime */
+				if (!e || e->valid)
+					continue;
+
+				memcpy(_cache.data(*e), src + i*_block_size, _block_size);
+				e->valid = true;
+			}
+		}
+
+		void completed(Job &job, bool success)
+		{
+			Block::Operation const op = job.operation();
+
+			switch (job.type) {
+
+			case Job::Type::FILL:
+			case Job::Type::WRITE_BACK:
+
+				_for_each_entry(op, [&] (Cache::Entry &e, block_count_t) {
+					if (!e.io)
+						return;
+
+					/* keep blocks that did not reach the back end */
+					if (!success && job.type == Job::Type::WRITE_BACK)
+						e.dirty = true;
+
+					e.io = false;
+					_cache.update(e);
+				});
+
+				if (success)
+					break;
+
+				error(op, " failed");
+
+				/* retry the write back not before the next timeout */
+				if (job.type == Job::Type::WRITE_BACK) {
+					_write_failed = true;
+					_write_stall  = true;
+				}
+
+				/* fail read requests waiting for the blocks */
+				if (job.type == Job::Type::FILL)
+					for (Request_slot &slot : _slots)
+						if (slot.state == Request_slot::State::PENDING
+						 && slot.kind  == Request_slot::Kind::CACHED_READ
+						 && slot.overlaps(op))
+							slot.done(false);
+				break;
+
+			case Job::Type::BYPASS:
+			case Job::Type::SYNC:
+
+				if (job.type == Job::Type::SYNC) {
+					_sync_slot = nullptr;
+					success &= !_write_failed;
+					_write_failed = false;
+				}
+
+				Request_slot &slot = *job.slot;
+
+				slot.failed |= !success;
+
+				/* complete request with its last job */
+				if (slot.jobs > 1)
+					break;
+
+				if (slot.state == Request_slot::State::ORPHAN)
+					slot.state = Request_slot::State::FREE;
+				else
+					slot.done(!slot.failed);
+				break;
+			}
+
+			_destroy_job(job);
+		}
+};
+
+
+void Component::construct(Genode::Env &env) { static Block_cache::Main main(env); }
@@ -0,0 +1,4 @@
+TARGET  = block_cache
+SRC_CC  = main.cc
+INC_DIR = $(PRG_DIR)
+LIBS    = base
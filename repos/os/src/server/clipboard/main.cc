@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2015-2017 Genode Labs GmbH
+ * Copyright (C) 2015-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -59,11 +59,12 @@ struct Rom::Registry : Rom::Registry_for_reader, Rom::Registry_for_writer
 	/**
 	 * Constructor
 	 */
-	Registry(Genode::Ram_allocator &ram, Genode::Region_map &rm,
+	Registry(Genode::Allocator &alloc,
+	         Genode::Ram_allocator &ram, Genode::Region_map &rm,
 	         Module::Read_policy  const &read_policy,
 	         Module::Write_policy const &write_policy)
 	:
-		module(ram, rm, "clipboard", read_policy, write_policy)
+		module(alloc, ram, rm, "clipboard", read_policy, write_policy)
 	{ }
 
 	void notify_reader_on_focus()
@@ -78,6 +79,7 @@ struct Clipboard::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 	Genode::Env &_env;
 
 	Genode::Sliced_heap _sliced_heap = { _env.ram(), _env.rm() };
+	Genode::Heap        _heap        = { _env.ram(), _env.rm() };
 
 	Genode::Attached_rom_dataspace _config { _env, "config" };
 
@@ -263,7 +265,7 @@ struct Clipboard::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 		return false;
 	}
 
-	Rom::Registry _rom_registry { _env.ram(), _env.rm(), *this, *this };
+	Rom::Registry _rom_registry { _heap, _env.ram(), _env.rm(), *this, *this };
 
 	Report::Root report_root = { _env, _sliced_heap, _rom_registry, _verbose };
 	Rom   ::Root    rom_root = { _env, _sliced_heap, _rom_registry };
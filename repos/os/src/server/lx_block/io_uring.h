@@ -0,0 +1,390 @@
+/*
+ * \brief  Back end executing jobs via the io_uring interface of Linux
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IO_URING_H_
+#define _IO_URING_H_
+
+/* Genode includes */
+#include <base/thread.h>
+
+/* libc includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+/* defined by 'linux/fs.h', clashes with template arguments of Genode headers */
+#undef BLOCK_SIZE
+
+/* local includes */
+#include <job.h>
+
+namespace Lx_block { class Io_uring; }
+
+
+/**
+ * Back end based on a submission and a completion ring shared with the kernel
+ *
+ * Jobs are submitted and completions are consumed by the entrypoint. A
+ * dedicated thread blocks on an eventfd, which the kernel signals for each
+ * completion, and wakes up the entrypoint.
+ */
+class Lx_block::Io_uring : public Backend
+{
+	public:
+
+		struct Unavailable : Exception { };
+
+	private:
+
+		/*
+		 * The file descriptors and mappings are released on destruction,
+		 * which also covers a constructor that throws 'Unavailable'.
+		 */
+
+		struct File_descriptor : Noncopyable
+		{
+			int const value;
+
+			File_descriptor(int value) : value(value) { }
+
+			~File_descriptor() { if (value >= 0) ::close(value); }
+		};
+
+		struct Mapping
+		{
+			void  *base = MAP_FAILED;
+			size_t size = 0;
+
+			Mapping() { }
+
+			~Mapping() { if (base != MAP_FAILED) munmap(base, size); }
+
+			Mapping(Mapping const &) = delete;
+			Mapping &operator = (Mapping const &) = delete;
+		};
+
+		struct Ring
+		{
+			void  *base = MAP_FAILED;
+			size_t size = 0;
+
+			unsigned *head = nullptr;
+			unsigned *tail = nullptr;
+			unsigned  mask = 0;
+
+			template <typename T>
+			T *at(unsigned offset) const { return (T *)((char *)base + offset); }
+
+			Ring() { }
+
+			Ring(Ring const &) = delete;
+			Ring &operator = (Ring const &) = delete;
+		};
+
+		struct Completion_thread : Thread
+		{
+			int const       _event_fd;
+			Signal_context &_sigh;
+
+			Completion_thread(Env &env, int event_fd, Signal_context &sigh)
+			:
+				Thread(env, "io_uring", 4*4096),
+				_event_fd(event_fd), _sigh(sigh)
+			{ }
+
+			void entry() override
+			{
+				for (;;) {
+					eventfd_t value = 0;
+					if (eventfd_read(_event_fd, &value) == 0)
+						_sigh.local_submit();
+				}
+			}
+		};
+
+		int const _fd;
+
+		io_uring_params _params { };
+
+		File_descriptor const _ring_fd;
+
+		Mapping _sq_mapping   { };
+		Mapping _cq_mapping   { };
+		Mapping _sqes_mapping { };
+
+		Ring _sq { };
+		Ring _cq { };
+
+		unsigned     *_sq_array = nullptr;
+		io_uring_sqe *_sqes     = nullptr;
+		size_t        _sqes_size;
+		io_uring_cqe *_cqes     = nullptr;
+
+		unsigned _submitted = 0;  /* SQEs not yet passed to the kernel */
+
+		File_descriptor const _event_fd;
+
+		Completion_thread _completion_thread;
+
+		static int _setup(unsigned entries, io_uring_params &params)
+		{
+			int const fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+
+			if (fd < 0) {
+				warning("io_uring unavailable (errno=", errno, ")");
+				throw Unavailable();
+			}
+
+			/* the plain 'READ' and 'WRITE' operations require Linux 5.6 */
+			if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+				warning("io_uring lacks support for plain read/write operations");
+				close(fd);
+				throw Unavailable();
+			}
+
+			return fd;
+		}
+
+		void *_map(Mapping &mapping, size_t size, off_t offset)
+		{
+			mapping.base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+			                    MAP_SHARED | MAP_POPULATE, _ring_fd.value, offset);
+			if (mapping.base == MAP_FAILED) {
+				error("unable to map io_uring (errno=", errno, ")");
+				throw Unavailable();
+			}
+			mapping.size = size;
+			return mapping.base;
+		}
+
+		int _init_event_fd()
+		{
+			int const event_fd = eventfd(0, EFD_CLOEXEC);
+			if (event_fd < 0) {
+				error("unable to create eventfd (errno=", errno, ")");
+				throw Unavailable();
+			}
+
+			int const ret = (int)syscall(__NR_io_uring_register, _ring_fd.value,
+			                             IORING_REGISTER_EVENTFD, &event_fd, 1);
+			if (ret < 0) {
+				error("unable to register eventfd at io_uring");
+				::close(event_fd);
+				throw Unavailable();
+			}
+			return event_fd;
+		}
+
+		/**
+		 * Enqueue SQE for the part of the job not transferred yet
+		 */
+		void _submit_remainder(Job &job)
+		{
+			using Type = Block::Operation::Type;
+
+			/* the number of jobs in flight never exceeds the ring size */
+			unsigned const tail  = *_sq.tail;
+			unsigned const index = tail & _sq.mask;
+
+			io_uring_sqe &sqe = _sqes[index];
+			sqe = io_uring_sqe { };
+
+			switch (job.request.operation.type) {
+			case Type::READ:  sqe.opcode = IORING_OP_READ;  break;
+			case Type::WRITE: sqe.opcode = IORING_OP_WRITE; break;
+			case Type::SYNC:
+				sqe.opcode      = IORING_OP_FSYNC;
+				sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+				break;
+			case Type::TRIM:
+			case Type::INVALID:
+				sqe.opcode = IORING_OP_NOP;
+				break;
+			}
+
+			sqe.fd        = _fd;
+			sqe.addr      = (__u64)(addr_t)(job.buffer + job.done);
+			sqe.len       = (__u32)(job.length - job.done);
+			sqe.off       = job.offset + job.done;
+			sqe.user_data = (__u64)(addr_t)&job;
+
+			_sq_array[index] = index;
+
+			__atomic_store_n(_sq.tail, tail + 1, __ATOMIC_RELEASE);
+			_submitted++;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Io_uring(Io_uring const &);
+		Io_uring &operator = (Io_uring const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param fd               file descriptor of the host file
+		 * \param entries          maximum number of jobs in flight
+		 * \param completion_sigh  signal context triggered on completions
+		 *
+		 * \throw Unavailable
+		 */
+		Io_uring(Env &env, int fd, unsigned entries, Signal_context &completion_sigh)
+		:
+			_fd(fd),
+			_ring_fd(_setup(entries, _params)),
+			_sqes_size(_params.sq_entries*sizeof(io_uring_sqe)),
+			_event_fd(_init_event_fd()),
+			_completion_thread(env, _event_fd.value, completion_sigh)
+		{
+			_sq.size = _params.sq_off.array + _params.sq_entries*sizeof(unsigned);
+			_cq.size = _params.cq_off.cqes  + _params.cq_entries*sizeof(io_uring_cqe);
+
+			if (_params.features & IORING_FEAT_SINGLE_MMAP)
+				_sq.size = _cq.size = max(_sq.size, _cq.size);
+
+			_sq.base = _map(_sq_mapping, _sq.size, IORING_OFF_SQ_RING);
+			_cq.base = (_params.features & IORING_FEAT_SINGLE_MMAP)
+			         ? _sq.base : _map(_cq_mapping, _cq.size, IORING_OFF_CQ_RING);
+
+			_sq.head = _sq.at<unsigned>(_params.sq_off.head);
+			_sq.tail = _sq.at<unsigned>(_params.sq_off.tail);
+			_sq.mask = *_sq.at<unsigned>(_params.sq_off.ring_mask);
+			_sq_array = _sq.at<unsigned>(_params.sq_off.array);
+
+			_cq.head = _cq.at<unsigned>(_params.cq_off.head);
+			_cq.tail = _cq.at<unsigned>(_params.cq_off.tail);
+			_cq.mask = *_cq.at<unsigned>(_params.cq_off.ring_mask);
+			_cqes    = _cq.at<io_uring_cqe>(_params.cq_off.cqes);
+
+			_sqes = (io_uring_sqe *)_map(_sqes_mapping, _sqes_size, IORING_OFF_SQES);
+
+			_completion_thread.start();
+		}
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		void submit(Job &job) override
+		{
+			job.done = 0;
+			_submit_remainder(job);
+		}
+
+		void commit() override
+		{
+			while (_submitted) {
+
+				int const ret = (int)syscall(__NR_io_uring_enter, _ring_fd.value,
+				                             _submitted, 0, 0, nullptr, 0);
+				if (ret < 0 && errno == EINTR)
+					continue;
+
+				if (ret < 0) {
+					/* retried by the next call of commit */
+					if (errno != EAGAIN && errno != EBUSY)
+						error("io_uring_enter failed (errno=", errno, ")");
+					return;
+				}
+
+				_submitted -= min((unsigned)ret, _submitted);
+			}
+		}
+
+		void wait_for_completion() override
+		{
+			/*
+			 * The eventfd is consumed by the completion thread, so wait
+			 * for the completion ring directly, passing SQEs not yet taken
+			 * by the kernel along the way.
+			 */
+			while (*_cq.head == __atomic_load_n(_cq.tail, __ATOMIC_ACQUIRE)) {
+
+				int const ret = (int)syscall(__NR_io_uring_enter, _ring_fd.value,
+				                             _submitted, 1, IORING_ENTER_GETEVENTS,
+				                             nullptr, 0);
+				if (ret < 0 && errno == EINTR)
+					continue;
+
+				if (ret < 0) {
+					error("io_uring_enter failed (errno=", errno, ")");
+					return;
+				}
+
+				_submitted -= min((unsigned)ret, _submitted);
+			}
+		}
+
+		Job *take_completed() override
+		{
+			using Type = Block::Operation::Type;
+
+			for (;;) {
+
+				unsigned const head = *_cq.head;
+
+				if (head == __atomic_load_n(_cq.tail, __ATOMIC_ACQUIRE))
+					return nullptr;
+
+				io_uring_cqe const &cqe = _cqes[head & _cq.mask];
+
+				Job &job = *(Job *)(addr_t)cqe.user_data;
+				int const res = cqe.res;
+
+				__atomic_store_n(_cq.head, head + 1, __ATOMIC_RELEASE);
+
+				Type const type = job.request.operation.type;
+
+				if (type != Type::READ && type != Type::WRITE) {
+					job.request.success = (res >= 0);
+					return &job;
+				}
+
+				/* interrupted, retry the transfer */
+				if (res == -EINTR || res == -EAGAIN) {
+					_submit_remainder(job);
+					commit();
+					continue;
+				}
+
+				/* error or end of file */
+				if (res <= 0) {
+					job.request.success = false;
+					return &job;
+				}
+
+				job.done += min((size_t)res, job.length - job.done);
+
+				if (job.done == job.length) {
+					job.request.success = true;
+					return &job;
+				}
+
+				/* short transfer, continue with the remaining bytes */
+				_submit_remainder(job);
+				commit();
+			}
+		}
+};
+
+#endif /* _IO_URING_H_ */
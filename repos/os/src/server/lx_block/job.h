@@ -0,0 +1,122 @@
+/*
+ * \brief  Block request in flight against the host file
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _JOB_H_
+#define _JOB_H_
+
+/* Genode includes */
+#include <block/request.h>
+#include <util/interface.h>
+
+namespace Lx_block {
+
+	using namespace Genode;
+
+	struct Job;
+	struct Job_queue;
+	struct Backend;
+}
+
+
+struct Lx_block::Job
+{
+	Block::Request request { };
+
+	char            *buffer = nullptr;  /* request content within the session buffer */
+	size_t           length = 0;        /* number of bytes */
+	Genode::uint64_t offset = 0;        /* byte position within the file */
+	size_t           done   = 0;        /* bytes transferred by the back end */
+
+	/*
+	 * A job is a member of at most one queue at a time, e.g., the free jobs
+	 * or the jobs pending in the back end.
+	 */
+	Job *next = nullptr;
+
+	Job() { }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Job(Job const &);
+		Job &operator = (Job const &);
+};
+
+
+struct Lx_block::Job_queue
+{
+	Job *head = nullptr;
+	Job *tail = nullptr;
+
+	void enqueue(Job &job)
+	{
+		job.next = nullptr;
+		if (tail) tail->next = &job; else head = &job;
+		tail = &job;
+	}
+
+	/**
+	 * Remove and return the oldest job, or nullptr if the queue is empty
+	 */
+	Job *dequeue()
+	{
+		Job * const job = head;
+		if (job) {
+			head = job->next;
+			if (!head) tail = nullptr;
+		}
+		return job;
+	}
+
+	Job_queue() { }
+
+	Job_queue(Job_queue const &) = delete;
+	Job_queue &operator = (Job_queue const &) = delete;
+};
+
+
+/**
+ * Interface for executing jobs asynchronously
+ *
+ * The back end sets the 'request.success' of a job before handing out the
+ * job as completed. Completions are signalled to the signal handler
+ * passed to the back end at construction time.
+ */
+struct Lx_block::Backend : Interface
+{
+	/**
+	 * Enqueue job for execution
+	 */
+	virtual void submit(Job &) = 0;
+
+	/**
+	 * Start the execution of all jobs submitted so far
+	 */
+	virtual void commit() = 0;
+
+	/**
+	 * Block until a job is completed
+	 *
+	 * The completed job is not taken from the back end.
+	 */
+	virtual void wait_for_completion() = 0;
+
+	/**
+	 * Return completed job or nullptr if no job is completed
+	 */
+	virtual Job *take_completed() = 0;
+};
+
+#endif /* _JOB_H_ */
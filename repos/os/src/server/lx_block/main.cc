@@ -5,19 +5,19 @@
  */
 
 /*
- * Copyright (C) 2017 Genode Labs GmbH
+ * Copyright (C) 2017-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU General Public License version 2.
  */
 
 /* Genode includes */
+#include <base/attached_ram_dataspace.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
-#include <base/heap.h>
 #include <base/log.h>
-#include <block/component.h>
-#include <block/driver.h>
+#include <block/request_stream.h>
+#include <root/root.h>
 #include <util/string.h>
 
 /* libc includes */
@@ -30,173 +30,361 @@
 #include <stdio.h> /* perror */
 #pragma GCC diagnostic pop  /* restore -Wconversion warnings */
 
+/* local includes */
+#include <io_uring.h>
+#include <thread_pool.h>
+
+namespace Lx_block {
+
+	struct Block_session_component;
+	struct Main;
+
+	typedef Block::Request_stream::Response Response;
+}
+
+
 static bool xml_attr_ok(Genode::Xml_node node, char const *attr)
 {
 	return node.attribute_value(attr, false);
 }
 
 
-class Lx_block_driver : public Block::Driver
+struct Lx_block::Block_session_component : Rpc_object<Block::Session>,
+                                           Block::Request_stream
+{
+	Entrypoint &_ep;
+
+	Block_session_component(Region_map               &rm,
+	                        Dataspace_capability      ds,
+	                        Entrypoint               &ep,
+	                        Signal_context_capability sigh,
+	                        Info                      info)
+	:
+		Request_stream(rm, ds, ep, sigh, info), _ep(ep)
+	{
+		_ep.manage(*this);
+	}
+
+	~Block_session_component() { _ep.dissolve(*this); }
+
+	Info info() const override { return Request_stream::info(); }
+
+	Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
+};
+
+
+struct Lx_block::Main : Rpc_object<Typed_root<Block::Session>>
 {
-	private:
+	Env &_env;
 
-		Genode::Env &_env;
+	Attached_rom_dataspace _config_rom { _env, "config" };
 
-		Block::Session::Info const _info;
+	struct Could_not_open_file : Exception { };
 
-		typedef Genode::String<256> File_name;
+	typedef String<256> File_name;
 
-		static File_name _file_name(Genode::Xml_node const &config)
-		{
-			return config.attribute_value("file", File_name());
+	static File_name _file_name(Xml_node const &config)
+	{
+		return config.attribute_value("file", File_name());
+	}
+
+	static Block::Session::Info _init_info(Xml_node const &config)
+	{
+		Number_of_bytes const default_block_size(512);
+
+		if (!config.has_attribute("file")) {
+			error("mandatory file attribute missing");
+			throw Could_not_open_file();
 		}
 
-		static Block::Session::Info _init_info(Genode::Xml_node const &config)
-		{
-			Genode::Number_of_bytes const default_block_size(512);
+		struct stat st;
+		if (stat(_file_name(config).string(), &st)) {
+			perror("stat");
+			throw Could_not_open_file();
+		}
 
-			if (!config.has_attribute("file")) {
-				Genode::error("mandatory file attribute missing");
-				throw Could_not_open_file();
-			}
+		if (!config.has_attribute("block_size"))
+			warning("block size missing, assuming ", default_block_size);
 
-			struct stat st;
-			if (stat(_file_name(config).string(), &st)) {
-				perror("stat");
-				throw Could_not_open_file();
-			}
+		size_t const block_size =
+			config.attribute_value("block_size", default_block_size);
 
-			if (!config.has_attribute("block_size"))
-				Genode::warning("block size missing, assuming ", default_block_size);
+		return {
+			.block_size  = block_size,
+			.block_count = st.st_size / block_size,
+			.align_log2  = log2(block_size),
+			.writeable   = xml_attr_ok(config, "writeable")
+		};
+	}
 
-			Genode::size_t const block_size =
-				config.attribute_value("block_size", default_block_size);
+	Block::Session::Info const _info = _init_info(_config_rom.xml());
 
-			return {
-				.block_size  = block_size,
-				.block_count = st.st_size / block_size,
-				.align_log2  = Genode::log2(block_size),
-				.writeable   = xml_attr_ok(config, "writeable")
-			};
+	int _open_file()
+	{
+		File_name const file_name = _file_name(_config_rom.xml());
+
+		/*
+		 * With 'O_DIRECT', the block size must be a multiple of the logical
+		 * block size of the host file system.
+		 */
+		int const flags = (_info.writeable ? O_RDWR : O_RDONLY)
+		                | (xml_attr_ok(_config_rom.xml(), "direct") ? O_DIRECT : 0);
+
+		int const fd = open(file_name.string(), flags);
+		if (fd == -1) {
+			error("open ", file_name.string());
+			throw Could_not_open_file();
 		}
+		return fd;
+	}
 
-		int _fd { -1 };
+	int const _fd = _open_file();
 
-	public:
+	enum { MAX_JOBS = 256 };
 
-		struct Could_not_open_file : Genode::Exception { };
+	unsigned const _queue_depth =
+		min(max(_config_rom.xml().attribute_value("queue_depth", 64U), 1U),
+		    (unsigned)MAX_JOBS);
 
-		Lx_block_driver(Genode::Env &env, Genode::Xml_node config)
-		:
-			Block::Driver(env.ram()),
-			_env(env),
-			_info(_init_info(config))
-		{
-			/* open file */
-			File_name const file_name = _file_name(config);
-			_fd = open(file_name.string(), _info.writeable ? O_RDWR : O_RDONLY);
-			if (_fd == -1) {
-				Genode::error("open ", file_name.string());
-				throw Could_not_open_file();
-			}
+	Job       _jobs[MAX_JOBS] { };
+	Job_queue _free_jobs      { };
+	Job_queue _completed_jobs { };
+
+	unsigned _in_flight = 0;
+	bool     _syncing   = false;
+
+	Io_signal_handler<Main> _completion_handler {
+		_env.ep(), *this, &Main::_handle_requests };
+
+	Signal_handler<Main> _request_handler {
+		_env.ep(), *this, &Main::_handle_requests };
+
+	Constructible<Io_uring>    _io_uring    { };
+	Constructible<Thread_pool> _thread_pool { };
+
+	Backend &_init_backend()
+	{
+		Xml_node const config = _config_rom.xml();
 
-			Genode::log("Provide '", file_name, "' as block device "
-			            "block_size:  ", _info.block_size, " "
-			            "block_count: ", _info.block_count, " "
-			            "writeable:   ", _info.writeable ? "yes" : "no");
+		typedef String<16> Name;
+		Name const backend = config.attribute_value("backend", Name("io_uring"));
+
+		if (backend == "io_uring") {
+			try {
+				_io_uring.construct(_env, _fd, _queue_depth, _completion_handler);
+				return *_io_uring;
+			}
+			catch (Io_uring::Unavailable) {
+				warning("falling back to thread-pool back end"); }
 		}
 
-		~Lx_block_driver() { close(_fd); }
+		_thread_pool.construct(_env, _fd, config.attribute_value("threads", 4U),
+		                       _completion_handler);
+		return *_thread_pool;
+	}
+
+	Backend &_backend = _init_backend();
+
+	Constructible<Attached_ram_dataspace>  _block_ds      { };
+	Constructible<Block_session_component> _block_session { };
 
+	/**
+	 * Move jobs completed by the back end to the '_completed_jobs' queue
+	 *
+	 * \return true if any job was completed
+	 */
+	bool _collect_completed_jobs()
+	{
+		bool progress = false;
+
+		while (Job * const job = _backend.take_completed()) {
+
+			if (!job->request.success)
+				error(job->request.operation, " failed");
 
-		/*****************************
-		 ** Block::Driver interface **
-		 *****************************/
+			if (job->request.operation.type == Block::Operation::Type::SYNC)
+				_syncing = false;
 
-		Dma_buffer alloc_dma_buffer(Genode::size_t size, Genode::Cache) override
-		{
-			return { .ds = _env.ram().alloc(size), .dma_addr = 0 };
+			_in_flight--;
+			_completed_jobs.enqueue(*job);
+			progress = true;
 		}
+		return progress;
+	}
 
-		Block::Session::Info info() const override { return _info; }
+	Response _accept(Block_session_component &session, Block::Request request)
+	{
+		using Type = Block::Operation::Type;
 
-		void read(Block::sector_t           block_number,
-		          Genode::size_t            block_count,
-		          char                     *buffer,
-		          Block::Packet_descriptor &packet) override
-		{
-			Block::sector_t const offset = block_number * _info.block_size;
-			size_t          const count  = block_count  * _info.block_size;
+		Block::Operation const &op = request.operation;
 
-			ssize_t const n = pread(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pread");
-				throw Io_error();
-			}
+		/* hold back requests while syncing */
+		if (_syncing)
+			return Response::RETRY;
+
+		/* a sync covers all writes accepted before */
+		if (op.type == Type::SYNC && _in_flight)
+			return Response::RETRY;
+
+		if (op.type == Type::INVALID)
+			return Response::REJECTED;
+
+		if (op.type == Type::WRITE && !session.info().writeable)
+			return Response::REJECTED;
+
+		if (Block::Operation::has_payload(op.type)
+		 && (op.block_number + op.count > _info.block_count
+		  || op.block_number + op.count < op.block_number))
+			return Response::REJECTED;
+
+		Job * const job = _free_jobs.dequeue();
+		if (!job)
+			return Response::RETRY;
 
-			ack_packet(packet);
+		job->request = request;
+		job->buffer  = nullptr;
+		job->length  = 0;
+		job->offset  = op.block_number*_info.block_size;
+
+		/* trim is a nop */
+		if (op.type == Type::TRIM) {
+			job->request.success = true;
+			_completed_jobs.enqueue(*job);
+			return Response::ACCEPTED;
 		}
 
-		void write(Block::sector_t           block_number,
-		           Genode::size_t            block_count,
-		           char const               *buffer,
-		           Block::Packet_descriptor &packet) override
-		{
-			/* range check is done by Block::Driver */
-			if (!_info.writeable) {
-				throw Io_error();
-			}
+		if (Block::Operation::has_payload(op.type)) {
 
-			Block::sector_t  const offset = block_number * _info.block_size;
-			size_t           const count  = block_count  * _info.block_size;
+			session.with_content(request, [&] (void *ptr, size_t size) {
+				job->buffer = (char *)ptr;
+				job->length = size; });
 
-			ssize_t const n = pwrite(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pwrite");
-				throw Io_error();
+			if (!job->buffer) {
+				_free_jobs.enqueue(*job);
+				return Response::REJECTED;
 			}
-
-			ack_packet(packet);
 		}
 
-		void sync() override { }
-};
+		if (op.type == Type::SYNC)
+			_syncing = true;
 
+		_in_flight++;
+		_backend.submit(*job);
 
-struct Main
-{
-	Genode::Env  &_env;
-	Genode::Heap  _heap { _env.ram(), _env.rm() };
+		return Response::ACCEPTED;
+	}
+
+	void _handle_requests()
+	{
+		_collect_completed_jobs();
+
+		if (!_block_session.constructed())
+			return;
+
+		Block_session_component &session = *_block_session;
+
+		for (;;) {
+
+			bool progress = false;
+
+			/* acknowledge in the order of completion */
+			session.try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+				if (Job * const job = _completed_jobs.dequeue()) {
+					ack.submit(job->request);
+					_free_jobs.enqueue(*job);
+					progress = true;
+				}
+			});
+
+			session.with_requests([&] (Block::Request request) {
+
+				Response const response = _accept(session, request);
 
-	Genode::Attached_rom_dataspace _config_rom { _env, "config" };
+				if (response != Response::RETRY)
+					progress = true;
 
-	struct Factory : Block::Driver_factory
+				return response;
+			});
+
+			_backend.commit();
+
+			progress |= _collect_completed_jobs();
+
+			if (!progress)
+				break;
+		}
+
+		session.wakeup_client_if_needed();
+	}
+
+
+	/*
+	 * Root interface
+	 */
+
+	Capability<Session> session(Root::Session_args const &args,
+	                            Affinity const &) override
 	{
-		Genode::Constructible<Lx_block_driver> _driver { };
+		if (_block_session.constructed()) {
+			error("rejecting session request, only one session is supported");
+			throw Service_denied();
+		}
+
+		size_t const tx_buf_size =
+			Arg_string::find_arg(args.string(), "tx_buf_size").ulong_value(0);
 
-		Factory(Genode::Env &env, Genode::Xml_node config)
-		{
-			_driver.construct(env, config);
+		Ram_quota const ram_quota = ram_quota_from_args(args.string());
+
+		if (tx_buf_size > ram_quota.value) {
+			error("insufficient 'ram_quota', got ", ram_quota, ", need ",
+			      tx_buf_size);
+			throw Insufficient_ram_quota();
 		}
 
-		~Factory() { _driver.destruct(); }
+		Block::Session::Info info = _info;
+		info.writeable = _info.writeable
+		              && Arg_string::find_arg(args.string(), "writeable").bool_value(true);
+
+		_block_ds.construct(_env.ram(), _env.rm(), tx_buf_size);
+		_block_session.construct(_env.rm(), _block_ds->cap(), _env.ep(),
+		                         _request_handler, info);
+
+		return _block_session->cap();
+	}
+
+	void upgrade(Capability<Session>, Root::Upgrade_args const &) override { }
 
-		/***********************
-		 ** Factory interface **
-		 ***********************/
+	void close(Capability<Session>) override
+	{
+		/* wait until no job accesses the session buffer anymore */
+		while (_in_flight) {
+			_backend.commit();
+			if (!_collect_completed_jobs())
+				_backend.wait_for_completion();
+		}
 
-		Block::Driver *create() override { return &*_driver; }
-		void destroy(Block::Driver *) override { }
-	} factory { _env, _config_rom.xml() };
+		while (Job * const job = _completed_jobs.dequeue())
+			_free_jobs.enqueue(*job);
 
-	Block::Root root { _env.ep(), _heap, _env.rm(), factory,
-	                   xml_attr_ok(_config_rom.xml(), "writeable") };
+		_block_session.destruct();
+		_block_ds.destruct();
+	}
 
-	Main(Genode::Env &env) : _env(env)
+	Main(Env &env) : _env(env)
 	{
-		_env.parent().announce(_env.ep().manage(root));
+		for (unsigned i = 0; i < _queue_depth; i++)
+			_free_jobs.enqueue(_jobs[i]);
+
+		log("Provide '", _file_name(_config_rom.xml()), "' as block device "
+		    "block_size:  ", _info.block_size, " "
+		    "block_count: ", _info.block_count, " "
+		    "writeable:   ", _info.writeable ? "yes" : "no", " "
+		    "queue depth: ", _queue_depth, " "
+		    "back end: ", _io_uring.constructed() ? "io_uring" : "threads");
+
+		_env.parent().announce(_env.ep().manage(*this));
 	}
 };
 
 
-void Component::construct(Genode::Env &env) { static Main main(env); }
+void Component::construct(Genode::Env &env) { static Lx_block::Main main(env); }
@@ -0,0 +1,190 @@
+/*
+ * \brief  Back end executing jobs by a pool of threads
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+/* Genode includes */
+#include <base/heap.h>
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+
+/* libc includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <errno.h>
+#include <unistd.h>
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+/* local includes */
+#include <job.h>
+
+namespace Lx_block { class Thread_pool; }
+
+
+class Lx_block::Thread_pool : public Backend
+{
+	private:
+
+		struct Worker : Thread
+		{
+			Thread_pool &_pool;
+
+			Worker(Env &env, Thread_pool &pool)
+			: Thread(env, "worker", 4*4096), _pool(pool) { start(); }
+
+			void entry() override { _pool._work(); }
+		};
+
+		int const _fd;
+
+		Signal_context &_completion_sigh;
+
+		Mutex     _mutex     { };
+		Semaphore _available { };
+
+		Job_queue _submitted { };  /* accessed by the entrypoint only */
+		Job_queue _pending   { };
+		Job_queue _completed { };
+
+		/* entrypoint waits for the next completion */
+		bool      _waiting    { false };
+		Semaphore _completion { };
+
+		Heap _heap;
+
+		/**
+		 * Execute job with blocking system calls
+		 *
+		 * Partial transfers are continued until the request is complete.
+		 */
+		static bool _execute(int fd, Job &job)
+		{
+			using Type = Block::Operation::Type;
+
+			Type const type = job.request.operation.type;
+
+			if (type == Type::SYNC)
+				return fdatasync(fd) == 0;
+
+			size_t done = 0;
+			while (done < job.length) {
+
+				char   * const ptr    = job.buffer + done;
+				size_t   const length = job.length - done;
+				off_t    const offset = (off_t)(job.offset + done);
+
+				ssize_t const n = (type == Type::READ)
+				                ? pread (fd, ptr, length, offset)
+				                : pwrite(fd, ptr, length, offset);
+
+				if (n < 0 && errno == EINTR)
+					continue;
+
+				/* error or end of file */
+				if (n <= 0)
+					return false;
+
+				done += (size_t)n;
+			}
+			return true;
+		}
+
+		void _work()
+		{
+			for (;;) {
+
+				_available.down();
+
+				Job *job = nullptr;
+				{
+					Mutex::Guard guard(_mutex);
+					job = _pending.dequeue();
+				}
+
+				if (!job)
+					continue;
+
+				job->request.success = _execute(_fd, *job);
+
+				{
+					Mutex::Guard guard(_mutex);
+					_completed.enqueue(*job);
+
+					if (_waiting) {
+						_waiting = false;
+						_completion.up();
+					}
+				}
+
+				_completion_sigh.local_submit();
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param fd               file descriptor of the host file
+		 * \param num_threads      number of worker threads
+		 * \param completion_sigh  signal context triggered on completions
+		 */
+		Thread_pool(Env &env, int fd, unsigned num_threads,
+		            Signal_context &completion_sigh)
+		:
+			_fd(fd), _completion_sigh(completion_sigh),
+			_heap(env.ram(), env.rm())
+		{
+			for (unsigned i = 0; i < max(num_threads, 1U); i++)
+				new (_heap) Worker(env, *this);
+		}
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		void submit(Job &job) override { _submitted.enqueue(job); }
+
+		void commit() override
+		{
+			while (Job * const job = _submitted.dequeue()) {
+				{
+					Mutex::Guard guard(_mutex);
+					_pending.enqueue(*job);
+				}
+				_available.up();
+			}
+		}
+
+		void wait_for_completion() override
+		{
+			{
+				Mutex::Guard guard(_mutex);
+				if (_completed.head)
+					return;
+
+				_waiting = true;
+			}
+			_completion.down();
+		}
+
+		Job *take_completed() override
+		{
+			Mutex::Guard guard(_mutex);
+			return _completed.dequeue();
+		}
+};
+
+#endif /* _THREAD_POOL_H_ */
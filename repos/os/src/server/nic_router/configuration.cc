@@ -98,7 +98,8 @@ Configuration::Configuration(Env                             &env,
                              Cached_timer                    &timer,
                              Configuration                   &old_config,
                              Quota                     const &shared_quota,
-                             Interface_list                  &interfaces)
+                             Interface_list                  &interfaces,
+                             Interface_wakeup_list           &pending_wakeups)
 :
 	_alloc                          { alloc },
 	_max_packets_per_signal         { node.attribute_value("max_packets_per_signal",    (unsigned long)150) },
@@ -228,7 +229,8 @@ Configuration::Configuration(Env                             &env,
 				{
 					new (_alloc) Nic_client {
 						label, domain, alloc, old_config._nic_clients,
-						_nic_clients, env, timer, interfaces, *this };
+						_nic_clients, env, timer, interfaces,
+						pending_wakeups, *this };
 				}
 			);
 		}
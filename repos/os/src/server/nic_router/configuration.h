@@ -73,7 +73,8 @@ class Net::Configuration
 		              Cached_timer                            &timer,
 		              Configuration                           &old_config,
 		              Quota                             const &shared_quota,
-		              Interface_list                          &interfaces);
+		              Interface_list                          &interfaces,
+		              Interface_wakeup_list                   &pending_wakeups);
 
 		~Configuration();
 
@@ -16,6 +16,7 @@
 
 /* local includes */
 #include <ipv4_address_prefix.h>
+#include <prefix_trie.h>
 #include <list.h>
 
 /* Genode includes */
@@ -69,49 +70,68 @@ struct Net::Direct_rule : Direct_rule_base,
 
 
 template <typename T>
-struct Net::Direct_rule_list : List<T>
+class Net::Direct_rule_list : public List<T>
 {
-	using Base = List<T>;
-
-	template <typename HANDLE_MATCH_FN,
-	          typename HANDLE_NO_MATCH_FN>
-	void
-	find_longest_prefix_match(Ipv4_address    const &ip,
-	                          HANDLE_MATCH_FN    &&  handle_match,
-	                          HANDLE_NO_MATCH_FN &&  handle_no_match) const
-	{
-		/*
-		 * Simply handling the first match is sufficient as the list is
-		 * sorted by the prefix size in descending order.
-		 */
-		for (T const *rule_ptr = Base::first();
-		     rule_ptr != nullptr;
-		     rule_ptr = rule_ptr->next()) {
+	private:
 
-			if (rule_ptr->dst().prefix_matches(ip)) {
+		using Base = List<T>;
 
-				handle_match(*rule_ptr);
-				return;
-			}
+		Genode::Allocator &_alloc;
+		Prefix_trie<T>     _trie;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator of the trie nodes and of the rules
+		 */
+		Direct_rule_list(Genode::Allocator &alloc) : _alloc(alloc), _trie(alloc) { }
+
+		template <typename HANDLE_MATCH_FN,
+		          typename HANDLE_NO_MATCH_FN>
+		void
+		find_longest_prefix_match(Ipv4_address    const &ip,
+		                          HANDLE_MATCH_FN    &&  handle_match,
+		                          HANDLE_NO_MATCH_FN &&  handle_no_match) const
+		{
+			_trie.find_longest_prefix_match(ip, handle_match, handle_no_match);
 		}
-		handle_no_match();
-	}
-
-	void insert(T &rule)
-	{
-		/*
-		 * Ensure that the list stays sorted by the prefix size in descending
-		 * order.
+
+		/**
+		 * Insert rule, which must have been allocated from the allocator
+		 * of the list
+		 *
+		 * If the insertion fails, the rule is destroyed.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
 		 */
-		T *behind = nullptr;
-		for (T *curr = Base::first(); curr; curr = curr->next()) {
-			if (rule.dst().prefix >= curr->dst().prefix) {
-				break; }
+		void insert(T &rule)
+		{
+			try { _trie.insert(rule.dst(), rule); }
+			catch (Genode::Out_of_ram)  { Genode::destroy(_alloc, &rule); throw; }
+			catch (Genode::Out_of_caps) { Genode::destroy(_alloc, &rule); throw; }
+
+			/*
+			 * Ensure that the list stays sorted by the prefix size in
+			 * descending order.
+			 */
+			T *behind = nullptr;
+			for (T *curr = Base::first(); curr; curr = curr->next()) {
+				if (rule.dst().prefix >= curr->dst().prefix) {
+					break; }
+
+				behind = curr;
+			}
+			Base::insert(&rule, behind);
+		}
 
-			behind = curr;
+		void destroy_each(Genode::Deallocator &dealloc)
+		{
+			_trie.clear();
+			Base::destroy_each(dealloc);
 		}
-		Base::insert(&rule, behind);
-	}
 };
 
 #endif /* _RULE_H_ */
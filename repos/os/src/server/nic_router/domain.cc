@@ -86,9 +86,10 @@ void Domain::_prepare_reconstructing_ip_config()
 		 * Destroy all link states
 		 *
 		 * Strictly speaking, it is not necessary to destroy all link states,
-		 * only those that this domain applies NAT to. However, the Genode AVL
-		 * tree is not built for removing a selection of nodes and trying to do
-		 * it anyways is complicated. So, for now, we simply destroy all links.
+		 * only those that this domain applies NAT to. However, the link table
+		 * is not built for removing a selection of entries while iterating
+		 * and trying to do it anyways is complicated. So, for now, we simply
+		 * destroy all links.
 		 */
 		while (Link_side *link_side = _icmp_links.first()) {
 			Link &link { link_side->link() };
@@ -254,7 +255,7 @@ Domain::Domain(Configuration     &config,
 }
 
 
-Link_side_tree &Domain::links(L3_protocol const protocol)
+Link_side_table &Domain::links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP:  return _tcp_links;
@@ -457,6 +458,9 @@ void Domain::report(Xml_generator &xml)
 			try { xml.node("icmp-links",       [&] () { _icmp_stats.report(xml); }); empty = false; } catch (Report::Empty) { }
 			try { xml.node("arp-waiters",      [&] () { _arp_stats.report(xml);  }); empty = false; } catch (Report::Empty) { }
 			try { xml.node("dhcp-allocations", [&] () { _dhcp_stats.report(xml); }); empty = false; } catch (Report::Empty) { }
+			try { xml.node("tcp-link-table",   [&] () { _tcp_links.report(xml);  }); empty = false; } catch (Report::Empty) { }
+			try { xml.node("udp-link-table",   [&] () { _udp_links.report(xml);  }); empty = false; } catch (Report::Empty) { }
+			try { xml.node("icmp-link-table",  [&] () { _icmp_links.report(xml); }); empty = false; } catch (Report::Empty) { }
 		}
 		if (_config.report().dropped_fragm_ipv4() && _dropped_fragm_ipv4) {
 			xml.node("dropped-fragm-ipv4", [&] () {
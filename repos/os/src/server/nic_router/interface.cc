@@ -1572,9 +1572,8 @@ void Interface::_handle_arp(Ethernet_frame &eth,
 }
 
 
-void Interface::_handle_pkt()
+void Interface::_handle_pkt(Packet_descriptor const &pkt)
 {
-	Packet_descriptor const pkt = _sink.get_packet();
 	Size_guard size_guard(pkt.size());
 	try {
 		_handle_eth(_sink.packet_content(pkt), size_guard, pkt);
@@ -1594,52 +1593,63 @@ void Interface::_handle_pkt_stream_signal()
 	 * side. Doing this first frees packet-stream memory which facilitates
 	 * sending new packets in the subsequent steps of this handler.
 	 */
-	while (_source.ack_avail()) {
-		_source.release_packet(_source.try_get_acked_packet());
+	Packet_descriptor pkts[PKT_BATCH_SIZE];
+	for (unsigned nr_of_pkts;
+	     (nr_of_pkts = _source.try_get_acked_packets(pkts, PKT_BATCH_SIZE)); ) {
+
+		for (unsigned idx = 0; idx < nr_of_pkts; idx++) {
+			_source.release_packet(pkts[idx]); }
+
+		/*
+		 * The counter side may block on its full ack queue, so our source
+		 * must be woken up even if we don't submit any packet to it.
+		 */
+		_defer_source_wakeup();
 	}
 
 	/*
 	 * Handle packets received from the counter side. If the user configured
 	 * a limit for the number of packets to be handled at once, this limit gets
 	 * applied. If there is no such limit, received packets are handled until
-	 * none is left.
+	 * none is left. Packets are dequeued in batches in order to reduce the
+	 * number of accesses to the submit queue shared with the counter side.
 	 */
 	unsigned long const max_pkts = _config().max_packets_per_signal();
-	if (max_pkts) {
-		for (unsigned long i = 0; _sink.packet_avail(); i++) {
+	for (unsigned long handled_pkts = 0; _sink.packet_avail(); ) {
 
-			if (i >= max_pkts) {
+		if (max_pkts && handled_pkts >= max_pkts) {
 
-				/*
-				 * Ensure that this handler is called again in order to handle
-				 * the packets left unhandled due to the configured limit.
-				 */
-				Signal_transmitter(_pkt_stream_signal_handler).submit();
-				break;
-			}
-			_handle_pkt();
-		}
-	} else {
-		while (_sink.packet_avail()) {
-			_handle_pkt();
+			/*
+			 * Ensure that this handler is called again in order to handle
+			 * the packets left unhandled due to the configured limit.
+			 */
+			Signal_transmitter(_pkt_stream_signal_handler).submit();
+			break;
 		}
+		unsigned const max_batch_pkts = max_pkts ?
+			(unsigned)Genode::min((unsigned long)PKT_BATCH_SIZE, max_pkts - handled_pkts) :
+			(unsigned)PKT_BATCH_SIZE;
+
+		unsigned const nr_of_pkts = _sink.try_get_packets(pkts, max_batch_pkts);
+		for (unsigned idx = 0; idx < nr_of_pkts; idx++) {
+			_handle_pkt(pkts[idx]); }
+
+		handled_pkts += nr_of_pkts;
 	}
 
 	/*
 	 * Since we use the try_*() variants of the packet-stream API, we
 	 * haven't emitted any packet_avail, ack_avail, ready_to_submit or
 	 * ready_to_ack signal up to now. We've removed packets from our sink's
-	 * submit queue and might have forwarded it to any interface. We may have
-	 * also removed acks from our sink's ack queue.
+	 * submit queue and might have forwarded it to other interfaces. We may
+	 * have also removed acks from our sink's ack queue.
 	 *
-	 * We therefore wakeup all sources and our sink. Note that the packet-stream
-	 * API takes care of emitting only the signals that are actually needed.
+	 * We therefore wakeup the sources of all interfaces that we submitted
+	 * packets to, our source if we removed acks from it, and our sink. Note
+	 * that the packet-stream API takes care of emitting only the signals that
+	 * are actually needed.
 	 */
-	_config().domains().for_each([&] (Domain &domain) {
-		domain.interfaces().for_each([&] (Interface &interface) {
-			interface.wakeup_source();
-		});
-	});
+	_pending_wakeups.wakeup_all();
 	wakeup_sink();
 }
 
@@ -1889,6 +1899,38 @@ void Interface::_send_submit_pkt(Packet_descriptor &pkt,
 		                               pkt_size);
 
 	_source.try_submit_packet(pkt);
+
+	_defer_source_wakeup();
+}
+
+
+void Interface::_defer_source_wakeup()
+{
+	if (!_wakeup_pending) {
+		_wakeup_pending = true;
+		_pending_wakeups.insert(_pending_wakeup_elem);
+	}
+}
+
+
+void Interface::wakeup_source()
+{
+	if (_wakeup_pending) {
+		_wakeup_pending = false;
+		_pending_wakeups.remove(_pending_wakeup_elem);
+	}
+	_source.wakeup();
+}
+
+
+/***************************
+ ** Interface_wakeup_list **
+ ***************************/
+
+void Interface_wakeup_list::wakeup_all()
+{
+	while (Interface_wakeup_element *elem = first()) {
+		elem->object()->wakeup_source(); }
 }
 
 
@@ -1899,6 +1941,7 @@ Interface::Interface(Genode::Entrypoint     &ep,
                      Mac_address      const  mac,
                      Configuration          &config,
                      Interface_list         &interfaces,
+                     Interface_wakeup_list  &pending_wakeups,
                      Packet_stream_sink     &sink,
                      Packet_stream_source   &source,
                      Interface_policy       &policy)
@@ -1912,7 +1955,8 @@ Interface::Interface(Genode::Entrypoint     &ep,
 	_policy                    { policy },
 	_timer                     { timer },
 	_alloc                     { alloc },
-	_interfaces                { interfaces }
+	_interfaces                { interfaces },
+	_pending_wakeups           { pending_wakeups }
 {
 	_interfaces.insert(this);
 	try { _config().report().handle_interface_link_state(); }
@@ -2340,6 +2384,8 @@ Interface::~Interface()
 	catch (Pointer<Report>::Invalid) { }
 	_detach_from_domain();
 	_interfaces.remove(this);
+	if (_wakeup_pending) {
+		_pending_wakeups.remove(_pending_wakeup_elem); }
 }
 
 
@@ -55,6 +55,8 @@ namespace Net {
 	class Interface_policy;
 	class Interface;
 	using Interface_list = List<Interface>;
+	using Interface_wakeup_element = Genode::List_element<Interface>;
+	class Interface_wakeup_list;
 	class Interface_link_stats;
 	class Interface_object_stats;
 	class Dhcp_server;
@@ -95,6 +97,30 @@ struct Net::Interface_link_stats
 };
 
 
+/**
+ * Interfaces with packet-stream submissions that still need a wakeup
+ *
+ * Instead of waking up the sources of all interfaces after handling a
+ * packet-stream signal, the router wakes up only the interfaces that
+ * actually received packets in the meantime.
+ */
+class Net::Interface_wakeup_list : private Genode::List<Interface_wakeup_element>
+{
+	public:
+
+		void insert(Interface_wakeup_element &elem) {
+			Genode::List<Interface_wakeup_element>::insert(&elem); }
+
+		void remove(Interface_wakeup_element &elem) {
+			Genode::List<Interface_wakeup_element>::remove(&elem); }
+
+		/**
+		 * Wake up and dequeue all interfaces of the list
+		 */
+		void wakeup_all();
+};
+
+
 struct Net::Interface_policy
 {
 	virtual Domain_name determine_domain_name() const = 0;
@@ -125,6 +151,7 @@ class Net::Interface : private Interface_list::Element
 
 		enum { IPV4_TIME_TO_LIVE          = 64 };
 		enum { MAX_FREE_OPS_PER_EMERGENCY = 1024 };
+		enum { PKT_BATCH_SIZE             = 32 };
 
 		struct Dismiss_link       : Genode::Exception { };
 		struct Dismiss_arp_waiter : Genode::Exception { };
@@ -163,6 +190,9 @@ class Net::Interface : private Interface_list::Element
 		Dhcp_allocation_list                  _released_dhcp_allocations { };
 		Genode::Constructible<Dhcp_client>    _dhcp_client               { };
 		Interface_list                       &_interfaces;
+		Interface_wakeup_list                &_pending_wakeups;
+		Interface_wakeup_element              _pending_wakeup_elem       { this };
+		bool                                  _wakeup_pending            { false };
 		Genode::Constructible<Update_domain>  _update_domain             { };
 		Interface_link_stats                  _udp_stats                 { };
 		Interface_link_stats                  _tcp_stats                 { };
@@ -299,7 +329,7 @@ class Net::Interface : private Interface_list::Element
 		                          void                  *const  prot_base,
 		                          Genode::size_t         const  prot_size);
 
-		void _handle_pkt();
+		void _handle_pkt(Packet_descriptor const &pkt);
 
 		void _continue_handle_eth(Domain            const &domain,
 		                          Packet_descriptor const &pkt);
@@ -363,6 +393,11 @@ class Net::Interface : private Interface_list::Element
 
 		void _handle_pkt_stream_signal();
 
+		/**
+		 * Wake up our source at the end of the current packet-stream signal
+		 */
+		void _defer_source_wakeup();
+
 		void _reset_and_refetch_domain_ready_state();
 
 		void _refetch_domain_ready_state();
@@ -390,6 +425,7 @@ class Net::Interface : private Interface_list::Element
 		          Mac_address      const  mac,
 		          Configuration          &config,
 		          Interface_list         &interfaces,
+		          Interface_wakeup_list  &pending_wakeups,
 		          Packet_stream_sink     &sink,
 		          Packet_stream_source   &source,
 		          Interface_policy       &policy);
@@ -476,7 +512,7 @@ class Net::Interface : private Interface_list::Element
 		Interface_link_stats      &icmp_stats()                      { return _icmp_stats; }
 		Interface_object_stats    &arp_stats()                       { return _arp_stats; }
 		Interface_object_stats    &dhcp_stats()                      { return _dhcp_stats; }
-		void                       wakeup_source()                   { _source.wakeup(); }
+		void                       wakeup_source();
 		void                       wakeup_sink()                     { _sink.wakeup(); }
 };
 
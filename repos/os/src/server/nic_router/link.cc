@@ -17,6 +17,7 @@
 /* local includes */
 #include <link.h>
 #include <configuration.h>
+#include <report.h>
 
 using namespace Net;
 using namespace Genode;
@@ -75,6 +76,298 @@ bool Link_side::is_client() const
 }
 
 
+/*********************
+ ** Link_side_table **
+ *********************/
+
+uint32_t Link_side_table::_hash(Link_side_id const &id)
+{
+	/* FNV-1a over the 4-tuple */
+	uint32_t hash { 2166136261u };
+	uint8_t const *byte { (uint8_t const *)id.data_base() };
+	for (size_t idx = 0; idx < Link_side_id::data_size(); idx++) {
+		hash = (hash ^ byte[idx]) * 16777619u; }
+
+	return hash ^ (hash >> 16);
+}
+
+
+Link_side *Link_side_table::_find(Array            const &array,
+                                  Link_side_id     const &id,
+                                  uint32_t         const  hash) const
+{
+	if (!array.buckets) {
+		return nullptr; }
+
+	Link_side *result { nullptr };
+	unsigned   idx    { hash & array.mask };
+	unsigned   probe  { 1 };
+	for (; probe <= array.num_buckets(); probe++) {
+
+		Bucket const &bucket { array.buckets[idx] };
+		bool empty_slot { false };
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+
+			Link_side *const side { bucket.side[slot] };
+			if (side) {
+				if (bucket.hash[slot] == hash && !(side->_id != id)) {
+					result = side;
+					break;
+				}
+			} else if (bucket.hash[slot] == EMPTY) {
+				empty_slot = true; }
+		}
+		if (result || empty_slot) {
+			break; }
+
+		idx = (idx + 1) & array.mask;
+	}
+	_stats.lookups++;
+	_stats.probes += probe;
+	_stats.max_probe = max(_stats.max_probe, probe);
+	return result;
+}
+
+
+bool Link_side_table::_insert(Array &array, Link_side &side, uint32_t const hash)
+{
+	if (!array.buckets) {
+		return false; }
+
+	unsigned idx { hash & array.mask };
+	for (unsigned probe = 0; probe < array.num_buckets(); probe++) {
+
+		Bucket &bucket { array.buckets[idx] };
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+
+			if (bucket.side[slot]) {
+				continue; }
+
+			if (bucket.hash[slot] == TOMBSTONE) {
+				array.tombstones--; }
+
+			bucket.hash[slot] = hash;
+			bucket.side[slot] = &side;
+			array.used++;
+			if (&array == &_curr && idx < _scan_hint) {
+				_scan_hint = idx; }
+
+			return true;
+		}
+		idx = (idx + 1) & array.mask;
+	}
+	return false;
+}
+
+
+bool Link_side_table::_remove(Array &array, Link_side &side, uint32_t const hash)
+{
+	if (!array.buckets) {
+		return false; }
+
+	unsigned idx { hash & array.mask };
+	for (unsigned probe = 0; probe < array.num_buckets(); probe++) {
+
+		Bucket &bucket { array.buckets[idx] };
+		bool empty_slot { false };
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+			if (!bucket.side[slot] && bucket.hash[slot] == EMPTY) {
+				empty_slot = true; }
+		}
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+
+			if (bucket.side[slot] != &side) {
+				continue; }
+
+			/*
+			 * A probe sequence that reaches this bucket already stops at
+			 * its empty slot, so the freed slot needs no tombstone then.
+			 */
+			bucket.side[slot] = nullptr;
+			if (empty_slot) {
+				bucket.hash[slot] = EMPTY;
+			} else {
+				bucket.hash[slot] = TOMBSTONE;
+				array.tombstones++;
+			}
+			array.used--;
+			return true;
+		}
+		if (empty_slot) {
+			return false; }
+
+		idx = (idx + 1) & array.mask;
+	}
+	return false;
+}
+
+
+bool Link_side_table::_alloc_array(Array &array, unsigned const num_buckets)
+{
+	size_t const raw_size { (size_t)num_buckets * sizeof(Bucket) +
+	                        CACHE_LINE_SIZE };
+
+	return _alloc.try_alloc(raw_size).convert<bool>(
+
+		[&] (void *raw) {
+
+			memset(raw, 0, raw_size);
+			array.raw      = raw;
+			array.raw_size = raw_size;
+			array.buckets  = (Bucket *)align_addr((addr_t)raw, log2((size_t)CACHE_LINE_SIZE));
+			array.mask     = num_buckets - 1;
+			return true;
+		},
+		[&] (Allocator::Alloc_error) { return false; });
+}
+
+
+void Link_side_table::_free_array(Array &array)
+{
+	if (array.raw) {
+		_alloc.free(array.raw, array.raw_size); }
+
+	array = Array { };
+}
+
+
+void Link_side_table::_migrate(unsigned max_buckets)
+{
+	for (; _prev.buckets && max_buckets; max_buckets--) {
+
+		Bucket &bucket { _prev.buckets[_migrated] };
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+
+			Link_side *const side { bucket.side[slot] };
+			if (!side) {
+				continue; }
+
+			/*
+			 * Leave a tombstone as other entries of the previous array may
+			 * still be reached only by probing across this bucket.
+			 */
+			uint32_t const hash { bucket.hash[slot] };
+			bucket.side[slot] = nullptr;
+			bucket.hash[slot] = TOMBSTONE;
+			_prev.used--;
+			_prev.tombstones++;
+
+			if (!_insert(_curr, *side, hash)) {
+				side->_in_overflow = true;
+				_overflow.insert(side);
+				_overflowed++;
+			}
+		}
+		if (++_migrated == _prev.num_buckets()) {
+			_free_array(_prev);
+			_migrated = 0;
+		}
+	}
+}
+
+
+void Link_side_table::_grow_if_needed()
+{
+	/* keep the load including tombstones below 75 percent */
+	if ((_curr.used + _curr.tombstones + 1) * 4 <= _curr.num_slots() * 3) {
+		return; }
+
+	/* finish the pending migration before starting another one */
+	_migrate(~0U);
+
+	/*
+	 * If most of the occupied slots are tombstones of expired links, it
+	 * suffices to rehash into an array of the same size.
+	 */
+	unsigned const num_buckets {
+		!_curr.buckets                ? (unsigned)MIN_BUCKETS :
+		_curr.tombstones > _curr.used ? _curr.num_buckets() :
+		                                _curr.num_buckets() * 2 };
+
+	Array array { };
+	if (!_alloc_array(array, num_buckets)) {
+		return; }
+
+	_prev      = _curr;
+	_curr      = array;
+	_migrated  = 0;
+	_scan_hint = 0;
+	_stats.resizes++;
+	if (!_prev.used) {
+		_free_array(_prev); }
+}
+
+
+Link_side_table::~Link_side_table()
+{
+	_free_array(_prev);
+	_free_array(_curr);
+}
+
+
+void Link_side_table::insert(Link_side *side)
+{
+	_migrate(MIGRATIONS_PER_OP);
+	_grow_if_needed();
+	if (_insert(_curr, *side, _hash(side->_id))) {
+		return; }
+
+	side->_in_overflow = true;
+	_overflow.insert(side);
+	_overflowed++;
+}
+
+
+void Link_side_table::remove(Link_side *side)
+{
+	if (side->_in_overflow) {
+		_overflow.remove(side);
+		side->_in_overflow = false;
+		_overflowed--;
+		return;
+	}
+	uint32_t const hash { _hash(side->_id) };
+	if (!_remove(_curr, *side, hash)) {
+		_remove(_prev, *side, hash); }
+
+	_migrate(MIGRATIONS_PER_OP);
+}
+
+
+Link_side *Link_side_table::first()
+{
+	if (Link_side *side = _overflow.first()) {
+		return side; }
+
+	_migrate(~0U);
+	for (; _scan_hint < _curr.num_buckets(); _scan_hint++) {
+
+		Bucket const &bucket { _curr.buckets[_scan_hint] };
+		for (unsigned slot = 0; slot < SLOTS_PER_BUCKET; slot++) {
+			if (bucket.side[slot]) {
+				return bucket.side[slot]; }
+		}
+	}
+	return nullptr;
+}
+
+
+void Link_side_table::report(Xml_generator &xml) const
+{
+	if (!_curr.buckets && !_overflowed) {
+		throw Report::Empty(); }
+
+	xml.attribute("slots",      _curr.num_slots() + _prev.num_slots());
+	xml.attribute("used",       _curr.used + _prev.used);
+	xml.attribute("tombstones", _curr.tombstones + _prev.tombstones);
+	xml.attribute("overflow",   _overflowed);
+	xml.attribute("lookups",    _stats.lookups);
+	xml.attribute("probes",     _stats.probes);
+	xml.attribute("max_probe",  _stats.max_probe);
+	xml.attribute("resizes",    _stats.resizes);
+}
+
+
 /**********
  ** Link **
  **********/
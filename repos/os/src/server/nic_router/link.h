@@ -34,6 +34,7 @@
 #include <timer_session/connection.h>
 #include <util/avl_tree.h>
 #include <util/list.h>
+#include <util/xml_generator.h>
 #include <net/ipv4.h>
 #include <net/port.h>
 
@@ -55,6 +56,7 @@ namespace Net {
 	class  Link_side_id;
 	class  Link_side;
 	class  Link_side_tree;
+	class  Link_side_table;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -89,12 +91,14 @@ __attribute__((__packed__));
 class Net::Link_side : public Genode::Avl_node<Link_side>
 {
 	friend class Link;
+	friend class Link_side_table;
 
 	private:
 
 		Reference<Domain>   _domain;
 		Link_side_id const  _id;
 		Link               &_link;
+		bool                _in_overflow { false };
 
 	public:
 
@@ -181,6 +185,141 @@ struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
 };
 
 
+/**
+ * Open-addressing hash table of link sides keyed by their 4-tuple
+ *
+ * Each bucket spans one cache line and holds the hashes of its slots next
+ * to the slot pointers, so most probes do not touch the link sides at all.
+ * When growing, the table migrates the entries of the previous array a few
+ * buckets per operation instead of stalling the router for a full rehash.
+ * If memory for growing cannot be obtained, link sides are put into an
+ * overflow tree instead.
+ *
+ * Entries are removed when their link is dissolved, which is driven by the
+ * lazy idle timeout of the link. Expired links thereby leave tombstones
+ * that are reused by subsequent insertions and purged on rehashing.
+ */
+class Net::Link_side_table
+{
+	private:
+
+		enum {
+			SLOTS_PER_BUCKET  = 5,
+			MIN_BUCKETS       = 16,
+			MIGRATIONS_PER_OP = 2,
+			CACHE_LINE_SIZE   = 64,
+		};
+
+		enum Slot_state : Genode::uint32_t { EMPTY = 0, TOMBSTONE = 1 };
+
+		struct alignas(CACHE_LINE_SIZE) Bucket
+		{
+			/* for unused slots, the hash denotes the 'Slot_state' */
+			Genode::uint32_t  hash[SLOTS_PER_BUCKET];
+			Link_side        *side[SLOTS_PER_BUCKET];
+		};
+
+		static_assert(sizeof(Bucket) == CACHE_LINE_SIZE,
+		              "link-side bucket does not match cache line");
+
+		struct Array
+		{
+			void           *raw        { nullptr };
+			Genode::size_t  raw_size   { 0 };
+			Bucket         *buckets    { nullptr };
+			unsigned        mask       { 0 };
+			Genode::size_t  used       { 0 };
+			Genode::size_t  tombstones { 0 };
+
+			unsigned num_buckets() const { return buckets ? mask + 1 : 0; }
+
+			Genode::size_t num_slots() const {
+				return (Genode::size_t)num_buckets() * SLOTS_PER_BUCKET; }
+		};
+
+		struct Stats
+		{
+			Genode::size_t lookups   { 0 };
+			Genode::size_t probes    { 0 };
+			unsigned       max_probe { 0 };
+			Genode::size_t resizes   { 0 };
+		};
+
+		Genode::Allocator &_alloc;
+		Array              _curr       { };
+		Array              _prev       { };
+		unsigned           _migrated   { 0 };
+		unsigned           _scan_hint  { 0 };
+		Link_side_tree     _overflow   { };
+		Genode::size_t     _overflowed { 0 };
+		Stats mutable      _stats      { };
+
+		static Genode::uint32_t _hash(Link_side_id const &id);
+
+		Link_side *_find(Array const &array, Link_side_id const &id,
+		                 Genode::uint32_t hash) const;
+
+		bool _insert(Array &array, Link_side &side, Genode::uint32_t hash);
+
+		bool _remove(Array &array, Link_side &side, Genode::uint32_t hash);
+
+		bool _alloc_array(Array &array, unsigned num_buckets);
+
+		void _free_array(Array &array);
+
+		void _migrate(unsigned max_buckets);
+
+		void _grow_if_needed();
+
+		/*
+		 * Noncopyable
+		 */
+		Link_side_table(Link_side_table const &);
+		Link_side_table &operator = (Link_side_table const &);
+
+	public:
+
+		Link_side_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Link_side_table();
+
+		void insert(Link_side *side);
+
+		void remove(Link_side *side);
+
+		/**
+		 * Return an arbitrary link side of the table or nullptr if empty
+		 */
+		Link_side *first();
+
+		template <typename HANDLE_MATCH_FN,
+		          typename HANDLE_NO_MATCH_FN>
+
+		void find_by_id(Link_side_id    const &id,
+		                HANDLE_MATCH_FN    &&  handle_match,
+		                HANDLE_NO_MATCH_FN &&  handle_no_match) const
+		{
+			Genode::uint32_t const hash { _hash(id) };
+			Link_side const *side { _find(_curr, id, hash) };
+			if (!side && _prev.buckets) {
+				side = _find(_prev, id, hash); }
+
+			if (side) {
+				handle_match(*side);
+				return;
+			}
+			_overflow.find_by_id(id, handle_match, handle_no_match);
+		}
+
+		/**
+		 * Report occupancy and probe lengths
+		 *
+		 * \throw Report::Empty
+		 */
+		void report(Genode::Xml_generator &xml) const;
+};
+
+
 class Net::Link : public Link_list::Element
 {
 	protected:
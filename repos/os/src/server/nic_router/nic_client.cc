@@ -36,15 +36,16 @@ void Nic_client::_invalid(char const *reason) const
 }
 
 
-Net::Nic_client::Nic_client(Session_label const &label_arg,
-                            Domain_name   const &domain_arg,
-                            Allocator           &alloc,
-                            Nic_client_dict     &old_nic_clients,
-                            Nic_client_dict     &new_nic_clients,
-                            Env                 &env,
-                            Cached_timer        &timer,
-                            Interface_list      &interfaces,
-                            Configuration       &config)
+Net::Nic_client::Nic_client(Session_label         const &label_arg,
+                            Domain_name           const &domain_arg,
+                            Allocator                   &alloc,
+                            Nic_client_dict             &old_nic_clients,
+                            Nic_client_dict             &new_nic_clients,
+                            Env                         &env,
+                            Cached_timer                &timer,
+                            Interface_list              &interfaces,
+                            Interface_wakeup_list       &pending_wakeups,
+                            Configuration               &config)
 :
 	Nic_client_dict::Element { new_nic_clients, label_arg },
 	_alloc                   { alloc },
@@ -70,8 +71,8 @@ Net::Nic_client::Nic_client(Session_label const &label_arg,
 			try {
 				_interface = *new (_alloc)
 					Nic_client_interface {
-						env, timer, alloc, interfaces, config, domain(),
-						label() };
+						env, timer, alloc, interfaces, pending_wakeups,
+						config, domain(), label() };
 			}
 			catch (Insufficient_ram_quota) { _invalid("NIC session RAM quota"); }
 			catch (Insufficient_cap_quota) { _invalid("NIC session CAP quota"); }
@@ -126,13 +127,14 @@ bool Net::Nic_client_interface_base::interface_link_state() const
  ** Nic_client_interface **
  **************************/
 
-Net::Nic_client_interface::Nic_client_interface(Env                 &env,
-                                                Cached_timer        &timer,
-                                                Genode::Allocator   &alloc,
-                                                Interface_list      &interfaces,
-                                                Configuration       &config,
-                                                Domain_name   const &domain_name,
-                                                Session_label const &label)
+Net::Nic_client_interface::Nic_client_interface(Env                         &env,
+                                                Cached_timer                &timer,
+                                                Genode::Allocator           &alloc,
+                                                Interface_list              &interfaces,
+                                                Interface_wakeup_list       &pending_wakeups,
+                                                Configuration               &config,
+                                                Domain_name           const &domain_name,
+                                                Session_label         const &label)
 :
 	Nic_client_interface_base   { domain_name, label, _session_link_state },
 	Nic::Packet_allocator       { &alloc },
@@ -140,8 +142,8 @@ Net::Nic_client_interface::Nic_client_interface(Env                 &env,
 	_session_link_state_handler { env.ep(), *this,
 	                              &Nic_client_interface::_handle_session_link_state },
 	_interface                  { env.ep(), timer, mac_address(), alloc,
-	                              Mac_address(), config, interfaces, *rx(), *tx(),
-	                              *this }
+	                              Mac_address(), config, interfaces,
+	                              pending_wakeups, *rx(), *tx(), *this }
 {
 	/* install packet stream signal handlers */
 	rx_channel()->sigh_packet_avail(_interface.pkt_stream_signal_handler());
@@ -60,6 +60,7 @@ class Net::Nic_client : private Nic_client_dict::Element
 		           Genode::Env                 &env,
 		           Cached_timer                &timer,
 		           Interface_list              &interfaces,
+		           Interface_wakeup_list       &pending_wakeups,
 		           Configuration               &config);
 
 		~Nic_client();
@@ -136,6 +137,7 @@ class Net::Nic_client_interface : public Nic_client_interface_base,
 		                     Cached_timer                &timer,
 		                     Genode::Allocator           &alloc,
 		                     Interface_list              &interfaces,
+		                     Interface_wakeup_list       &pending_wakeups,
 		                     Configuration               &config,
 		                     Domain_name           const &domain_name,
 		                     Genode::Session_label const &label);
@@ -241,6 +241,7 @@ Nic_session_component(Session_env                    &session_env,
                       Mac_address              const &router_mac,
                       Session_label            const &label,
                       Interface_list                 &interfaces,
+                      Interface_wakeup_list          &pending_wakeups,
                       Configuration                  &config,
                       Ram_dataspace_capability const  ram_ds)
 :
@@ -249,8 +250,8 @@ Nic_session_component(Session_env                    &session_env,
 	                             &_packet_alloc, _session_env.ep().rpc_ep() },
 	_interface_policy          { label, _session_env, config },
 	_interface                 { _session_env.ep(), timer, router_mac, _alloc,
-	                             mac, config, interfaces, *_tx.sink(),
-	                             *_rx.source(), _interface_policy },
+	                             mac, config, interfaces, pending_wakeups,
+	                             *_tx.sink(), *_rx.source(), _interface_policy },
 	_ram_ds                    { ram_ds }
 {
 	_interface.attach_to_domain();
@@ -284,12 +285,13 @@ Nic_session_component::link_state_sigh(Signal_context_capability sigh)
  ** Nic_session_root **
  **********************/
 
-Net::Nic_session_root::Nic_session_root(Env               &env,
-                                        Cached_timer      &timer,
-                                        Allocator         &alloc,
-                                        Configuration     &config,
-                                        Quota             &shared_quota,
-                                        Interface_list    &interfaces)
+Net::Nic_session_root::Nic_session_root(Env                   &env,
+                                        Cached_timer          &timer,
+                                        Allocator             &alloc,
+                                        Configuration         &config,
+                                        Quota                 &shared_quota,
+                                        Interface_list        &interfaces,
+                                        Interface_wakeup_list &pending_wakeups)
 :
 	Root_component<Nic_session_component> { &env.ep().rpc_ep(), &alloc },
 	_env                                  { env },
@@ -298,7 +300,8 @@ Net::Nic_session_root::Nic_session_root(Env               &env,
 	_router_mac                           { _mac_alloc.alloc() },
 	_config                               { config },
 	_shared_quota                         { shared_quota },
-	_interfaces                           { interfaces }
+	_interfaces                           { interfaces },
+	_pending_wakeups                      { pending_wakeups }
 { }
 
 
@@ -330,7 +333,7 @@ Nic_session_component *Net::Nic_session_root::_create_session(char const *args)
 						Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 						Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 						_timer, mac, _router_mac, label, _interfaces,
-						_config(), ram_ds);
+						_pending_wakeups, _config(), ram_ds);
 				}
 				catch (Out_of_ram) {
 					_mac_alloc.free(mac);
@@ -136,6 +136,7 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		                      Mac_address                      const &router_mac,
 		                      Genode::Session_label            const &label,
 		                      Interface_list                         &interfaces,
+		                      Interface_wakeup_list                  &pending_wakeups,
 		                      Configuration                          &config,
 		                      Genode::Ram_dataspace_capability const  ram_ds);
 
@@ -174,6 +175,7 @@ class Net::Nic_session_root
 		Reference<Configuration>  _config;
 		Quota                    &_shared_quota;
 		Interface_list           &_interfaces;
+		Interface_wakeup_list    &_pending_wakeups;
 
 		void _invalid_downlink(char const *reason);
 
@@ -187,12 +189,13 @@ class Net::Nic_session_root
 
 	public:
 
-		Nic_session_root(Genode::Env       &env,
-		                 Cached_timer      &timer,
-		                 Genode::Allocator &alloc,
-		                 Configuration     &config,
-		                 Quota             &shared_quota,
-		                 Interface_list    &interfaces);
+		Nic_session_root(Genode::Env           &env,
+		                 Cached_timer          &timer,
+		                 Genode::Allocator     &alloc,
+		                 Configuration         &config,
+		                 Quota                 &shared_quota,
+		                 Interface_list        &interfaces,
+		                 Interface_wakeup_list &pending_wakeups);
 
 		void handle_config(Configuration &config) { _config = Reference<Configuration>(config); }
 };
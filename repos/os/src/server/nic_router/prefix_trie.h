@@ -0,0 +1,161 @@
+/*
+ * \brief  Multibit trie for longest-prefix matching of IPv4 addresses
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PREFIX_TRIE_H_
+#define _PREFIX_TRIE_H_
+
+/* local includes */
+#include <ipv4_address_prefix.h>
+
+/* Genode includes */
+#include <base/allocator.h>
+
+namespace Net { template <typename> class Prefix_trie; }
+
+
+/**
+ * Multibit trie with a stride of 4 bits and controlled prefix expansion
+ *
+ * Each trie level consumes one nibble of the IPv4 address. A prefix whose
+ * length is not a multiple of the stride is expanded to all entries of its
+ * last level that it covers. Thereby, a lookup takes at most 8 steps
+ * independent from the number of inserted prefixes.
+ */
+template <typename T>
+class Net::Prefix_trie
+{
+	private:
+
+		enum {
+			STRIDE     = 4,
+			FAN_OUT    = 1 << STRIDE,
+			MAX_LEVELS = 32 / STRIDE,
+		};
+
+		struct Node
+		{
+			Node            *child[FAN_OUT]       { };
+			T         const *rule[FAN_OUT]        { };
+			Genode::uint8_t  rule_prefix[FAN_OUT] { };
+		};
+
+		Genode::Allocator &_alloc;
+		Node              *_root         { nullptr };
+		T           const *_default_rule { nullptr };
+
+		static unsigned _nibble(Ipv4_address const &ip, unsigned level)
+		{
+			Genode::uint8_t const byte = ip.addr[level / 2];
+			return (level & 1) ? (byte & 0xf) : (byte >> 4);
+		}
+
+		void _destroy(Node *node)
+		{
+			if (!node) {
+				return; }
+
+			for (Node *child : node->child) {
+				_destroy(child); }
+
+			Genode::destroy(_alloc, node);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Prefix_trie(Prefix_trie const &);
+		Prefix_trie &operator = (Prefix_trie const &);
+
+	public:
+
+		Prefix_trie(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Prefix_trie() { clear(); }
+
+		void clear()
+		{
+			_destroy(_root);
+			_root         = nullptr;
+			_default_rule = nullptr;
+		}
+
+		/**
+		 * Insert rule for the given prefix
+		 *
+		 * If a rule for the same prefix was inserted before, the new rule
+		 * takes precedence.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void insert(Ipv4_address_prefix const &dst, T const &rule)
+		{
+			unsigned const prefix = Genode::min(dst.prefix, (Genode::uint8_t)32);
+			if (prefix == 0) {
+				_default_rule = &rule;
+				return;
+			}
+			unsigned const last_level = (prefix - 1) / STRIDE;
+
+			if (!_root) {
+				_root = new (_alloc) Node; }
+
+			Node *node = _root;
+			for (unsigned level = 0; level < last_level; level++) {
+
+				Node *&child = node->child[_nibble(dst.address, level)];
+				if (!child) {
+					child = new (_alloc) Node; }
+
+				node = child;
+			}
+			/* expand prefix to all entries of the last level it covers */
+			unsigned const rest  = prefix - last_level * STRIDE;
+			unsigned const width = 1 << (STRIDE - rest);
+			unsigned const first = _nibble(dst.address, last_level) & ~(width - 1);
+
+			for (unsigned idx = first; idx < first + width; idx++) {
+				if (node->rule_prefix[idx] > prefix) {
+					continue; }
+
+				node->rule[idx]        = &rule;
+				node->rule_prefix[idx] = (Genode::uint8_t)prefix;
+			}
+		}
+
+		template <typename HANDLE_MATCH_FN,
+		          typename HANDLE_NO_MATCH_FN>
+		void
+		find_longest_prefix_match(Ipv4_address    const &ip,
+		                          HANDLE_MATCH_FN    &&  handle_match,
+		                          HANDLE_NO_MATCH_FN &&  handle_no_match) const
+		{
+			T const *best = _default_rule;
+			Node const *node = _root;
+			for (unsigned level = 0; node && level < MAX_LEVELS; level++) {
+
+				unsigned const idx = _nibble(ip, level);
+				if (node->rule[idx]) {
+					best = node->rule[idx]; }
+
+				node = node->child[idx];
+			}
+			if (best) {
+				handle_match(*best);
+			} else {
+				handle_no_match();
+			}
+		}
+};
+
+#endif /* _PREFIX_TRIE_H_ */
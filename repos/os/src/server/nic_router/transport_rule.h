@@ -77,6 +77,8 @@ class Net::Transport_rule_list : public Direct_rule_list<Transport_rule>
 {
 	public:
 
+		using Direct_rule_list<Transport_rule>::Direct_rule_list;
+
 		template <typename HANDLE_MATCH_FN,
 		          typename HANDLE_NO_MATCH_FN>
 
@@ -87,6 +87,7 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
                                                         Mac_address              const  mac,
                                                         Session_label            const &label,
                                                         Interface_list                 &interfaces,
+                                                        Interface_wakeup_list          &pending_wakeups,
                                                         Configuration                  &config,
                                                         Ram_dataspace_capability const  ram_ds)
 :
@@ -95,7 +96,8 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
 	                                &_packet_alloc, _session_env.ep().rpc_ep() },
 	_interface_policy             { label, _session_env, config },
 	_interface                    { _session_env.ep(), timer, mac, _alloc,
-	                                Mac_address(), config, interfaces, *_tx.sink(),
+	                                Mac_address(), config, interfaces,
+	                                pending_wakeups, *_tx.sink(),
 	                                *_rx.source(), _interface_policy },
 	_ram_ds                       { ram_ds }
 {
@@ -117,19 +119,21 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
  ** Uplink_session_root **
  *************************/
 
-Net::Uplink_session_root::Uplink_session_root(Env               &env,
-                                              Cached_timer      &timer,
-                                              Allocator         &alloc,
-                                              Configuration     &config,
-                                              Quota             &shared_quota,
-                                              Interface_list    &interfaces)
+Net::Uplink_session_root::Uplink_session_root(Env                   &env,
+                                              Cached_timer          &timer,
+                                              Allocator             &alloc,
+                                              Configuration         &config,
+                                              Quota                 &shared_quota,
+                                              Interface_list        &interfaces,
+                                              Interface_wakeup_list &pending_wakeups)
 :
 	Root_component<Uplink_session_component> { &env.ep().rpc_ep(), &alloc },
 	_env                                     { env },
 	_timer                                   { timer },
 	_config                                  { config },
 	_shared_quota                            { shared_quota },
-	_interfaces                              { interfaces }
+	_interfaces                              { interfaces },
+	_pending_wakeups                         { pending_wakeups }
 { }
 
 
@@ -181,7 +185,8 @@ Net::Uplink_session_root::_create_session(char const *args)
 					session_env,
 					Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 					Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
-					_timer, mac, label, _interfaces, _config(), ram_ds);
+					_timer, mac, label, _interfaces, _pending_wakeups,
+					_config(), ram_ds);
 			}
 			catch (Out_of_ram) {
 				Session_env session_env_stack { session_env };
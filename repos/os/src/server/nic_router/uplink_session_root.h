@@ -99,6 +99,7 @@ class Net::Uplink_session_component : private Uplink_session_component_base,
 		                         Mac_address                      const  mac,
 		                         Genode::Session_label            const &label,
 		                         Interface_list                         &interfaces,
+		                         Interface_wakeup_list                  &pending_wakeups,
 		                         Configuration                          &config,
 		                         Genode::Ram_dataspace_capability const  ram_ds);
 
@@ -126,6 +127,7 @@ class Net::Uplink_session_root
 		Reference<Configuration>  _config;
 		Quota                    &_shared_quota;
 		Interface_list           &_interfaces;
+		Interface_wakeup_list    &_pending_wakeups;
 
 		void _invalid_downlink(char const *reason);
 
@@ -139,12 +141,13 @@ class Net::Uplink_session_root
 
 	public:
 
-		Uplink_session_root(Genode::Env       &env,
-		                    Cached_timer      &timer,
-		                    Genode::Allocator &alloc,
-		                    Configuration     &config,
-		                    Quota             &shared_quota,
-		                    Interface_list    &interfaces);
+		Uplink_session_root(Genode::Env           &env,
+		                    Cached_timer          &timer,
+		                    Genode::Allocator     &alloc,
+		                    Configuration         &config,
+		                    Quota                 &shared_quota,
+		                    Interface_list        &interfaces,
+		                    Interface_wakeup_list &pending_wakeups);
 
 		void handle_config(Configuration &config) { _config = Reference<Configuration>(config); }
 };
@@ -7,7 +7,7 @@
  */
 
 /*
- * Copyright (C) 2011-2020 Genode Labs GmbH
+ * Copyright (C) 2011-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -20,7 +20,9 @@
 #include <block_session/rpc_object.h>
 #include <block/request_stream.h>
 #include <os/session_policy.h>
-#include <util/bit_allocator.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <util/construct_at.h>
 
 #include "gpt.h"
 #include "mbr.h"
@@ -29,46 +31,167 @@ namespace Block {
 	class  Session_component;
 	struct Session_handler;
 	struct Dispatch;
+	class  Shared_buffer;
 	class  Main;
 
-	template <unsigned ITEMS> struct Job_queue;
+	class Job_queue;
 
 	typedef Constructible<Job> Job_object;
 	using   Response = Request_stream::Response;
 };
 
 
-template <unsigned ITEMS>
-struct Block::Job_queue
+class Block::Job_queue
 {
-	Job_object           _jobs[ITEMS];
-	Bit_allocator<ITEMS> _alloc;
+	public:
 
-	addr_t alloc()
-	{
-		addr_t index = _alloc.alloc();
-		return index;
-	}
+		struct Full : Exception { };
 
-	void free(addr_t index)
-	{
-		if (_jobs[index].constructed())
-			_jobs[index].destruct();
+	private:
 
-		_alloc.free(index);
-	}
+		Allocator &_alloc;
 
-	template<typename FN>
-	void with_job(addr_t index, FN const &fn)
-	{
-		fn(_jobs[index]);
-	}
+		unsigned const _num_items;
+
+		Job_object * const _jobs  = (Job_object *)_alloc.alloc(_num_items*sizeof(Job_object));
+		addr_t     * const _free  = (addr_t *)_alloc.alloc(_num_items*sizeof(addr_t));
+
+		unsigned _num_free = 0;
+
+		/*
+		 * Noncopyable
+		 */
+		Job_queue(Job_queue const &);
+		Job_queue &operator = (Job_queue const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_items  maximum number of jobs in flight
+		 */
+		Job_queue(Allocator &alloc, unsigned num_items)
+		: _alloc(alloc), _num_items(max(num_items, 1U))
+		{
+			/* hand out the lowest indices first */
+			for (unsigned i = 0; i < _num_items; i++) {
+				construct_at<Job_object>(&_jobs[i]);
+				_free[_num_free++] = _num_items - 1 - i;
+			}
+		}
+
+		~Job_queue()
+		{
+			for (unsigned i = 0; i < _num_items; i++)
+				_jobs[i].~Job_object();
+
+			_alloc.free(_free, _num_items*sizeof(addr_t));
+			_alloc.free(_jobs, _num_items*sizeof(Job_object));
+		}
+
+		unsigned num_items() const { return _num_items; }
+
+		/**
+		 * \throw Full
+		 */
+		addr_t alloc()
+		{
+			if (!_num_free)
+				throw Full();
+
+			return _free[--_num_free];
+		}
+
+		void free(addr_t index)
+		{
+			if (_jobs[index].constructed())
+				_jobs[index].destruct();
+
+			_free[_num_free++] = index;
+		}
+
+		template<typename FN>
+		void with_job(addr_t index, FN const &fn)
+		{
+			fn(_jobs[index]);
+		}
+};
+
+
+/**
+ * Client I/O buffer located within the I/O buffer of the back-end session
+ *
+ * The buffer is handed out to the client as managed dataspace. Payload
+ * offsets of client requests thereby translate to offsets within the
+ * back-end I/O buffer, which allows for forwarding requests without copying
+ * their payload.
+ */
+class Block::Shared_buffer : Interface, Noncopyable
+{
+	private:
+
+		/*
+		 * Page-aligned range allocated from the back-end packet stream
+		 */
+		struct Range : Noncopyable
+		{
+			Block_connection::Tx::Source &tx;
+			Packet_descriptor const       packet;
+
+			Range(Block_connection::Tx::Source &tx, size_t size)
+			: tx(tx), packet(tx.alloc_packet(align_addr(size, 12), 12)) { }
+
+			~Range() { tx.release_packet(packet); }
+		};
+
+		Range             _range;
+		Rm_connection     _rm;
+		Region_map_client _region_map { _rm.create(_range.packet.size()) };
+
+	public:
+
+		long const number;
+
+		/* set once the session is closed while jobs are still in flight */
+		bool retired = false;
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Block_connection::Tx::Source::Packet_alloc_failed
+		 */
+		Shared_buffer(Env &env, Block_connection &block, size_t size, long number)
+		: _range(*block.tx(), size), _rm(env), number(number)
+		{
+			_region_map.attach(block.tx()->dataspace(), _range.packet.size(),
+			                   _range.packet.offset());
+		}
+
+		Dataspace_capability ds() { return _region_map.dataspace(); }
+
+		/**
+		 * Return payload within the back-end I/O buffer for 'request'
+		 */
+		Block_connection::Payload payload(Request const &request, size_t size) const
+		{
+			return { .offset = _range.packet.offset() + request.offset,
+			         .bytes  = size };
+		}
+
+		bool contains(Block_connection::Payload const &payload) const
+		{
+			off_t const base = _range.packet.offset();
+			return payload.offset >= base
+			    && payload.offset <  base + (off_t)_range.packet.size();
+		}
 };
 
 
 struct Block::Dispatch : Interface
 {
-	virtual Response submit(long number, Request const &request, addr_t addr) = 0;
+	virtual Response submit(long number, Request const &request,
+	                        addr_t addr, size_t size) = 0;
 	virtual void     update() = 0;
 	virtual void     acknowledge_completed(bool all = true, long number = -1) = 0;
 	virtual Response sync(long number, Request const &request) = 0;
@@ -77,14 +200,26 @@ struct Block::Dispatch : Interface
 
 struct Block::Session_handler : Interface
 {
-	Env                   &env;
-	Attached_ram_dataspace ds;
+	Env &env;
+
+	Constructible<Attached_ram_dataspace> _ram_ds { };
+
+	Dataspace_capability _init_ds(size_t buffer_size, Shared_buffer *shared)
+	{
+		if (shared)
+			return shared->ds();
+
+		_ram_ds.construct(env.ram(), env.rm(), buffer_size);
+		return _ram_ds->cap();
+	}
+
+	Dataspace_capability const ds;
 
 	Signal_handler<Session_handler> request_handler
 	  { env.ep(), *this, &Session_handler::handle };
 
-	Session_handler(Env &env, size_t buffer_size)
-	: env(env), ds(env.ram(), env.rm(), buffer_size)
+	Session_handler(Env &env, size_t buffer_size, Shared_buffer *shared)
+	: env(env), ds(_init_ds(buffer_size, shared))
 	{ }
 
 	virtual void handle_requests()= 0;
@@ -102,18 +237,33 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 {
 	private:
 
-		long      _number;
-		Dispatch &_dispatcher;
+		long           _number;
+		Dispatch      &_dispatcher;
+		Shared_buffer *_shared;
+
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
 
 	public:
 
 		bool syncing { false };
 
+		/**
+		 * Constructor
+		 *
+		 * \param shared  buffer within the back-end I/O buffer used as
+		 *                I/O buffer of the session, or nullptr if the
+		 *                payload is copied
+		 */
 		Session_component(Env &env, long number, size_t buffer_size,
-		                  Session::Info info, Dispatch &dispatcher)
-		: Session_handler(env, buffer_size),
-		  Request_stream(env.rm(), ds.cap(), env.ep(), request_handler, info),
-		  _number(number), _dispatcher(dispatcher)
+		                  Session::Info info, Dispatch &dispatcher,
+		                  Shared_buffer *shared)
+		: Session_handler(env, buffer_size, shared),
+		  Request_stream(env.rm(), ds, env.ep(), request_handler, info),
+		  _number(number), _dispatcher(dispatcher), _shared(shared)
 		{
 			env.ep().manage(*this);
 		}
@@ -129,6 +279,8 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 
 		long number() const { return _number; }
 
+		Shared_buffer *shared() { return _shared; }
+
 		bool acknowledge(Request &request)
 		{
 			bool progress = false;
@@ -179,8 +331,9 @@ class Block::Session_component : public Rpc_object<Block::Session>,
 					}
 
 					with_payload([&] (Request_stream::Payload const &payload) {
-						payload.with_content(request, [&] (void *addr, size_t) {
-							response = _dispatcher.submit(_number, request, addr_t(addr));
+						payload.with_content(request, [&] (void *addr, size_t size) {
+							response = _dispatcher.submit(_number, request,
+							                              addr_t(addr), size);
 						});
 					});
 
@@ -219,6 +372,19 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 			_config.xml().attribute_value("io_buffer",
 			                              Number_of_bytes(4*1024*1024));
 
+		/*
+		 * Number of jobs in flight, which is the maximum queue depth seen by
+		 * the back-end driver
+		 */
+		unsigned const _queue_depth =
+			_config.xml().attribute_value("queue_depth", 128U);
+
+		/*
+		 * In zero-copy mode, the I/O buffer of each client is located within
+		 * the I/O buffer of the back-end session
+		 */
+		bool const _zero_copy = _config.xml().attribute_value("zero_copy", false);
+
 		Allocator_avl           _block_alloc { &_heap };
 		Block_connection        _block    { _env, &_block_alloc, _io_buffer_size };
 		Io_signal_handler<Main> _io_sigh  { _env.ep(), *this, &Main::_handle_io };
@@ -228,9 +394,55 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 		enum { MAX_SESSIONS = 128 };
 		Session_component   *_sessions[MAX_SESSIONS] { };
-		Job_queue<128>       _job_queue { };
+		Job_queue            _job_queue { _heap, _queue_depth };
 		Registry<Block::Job> _job_registry { };
 
+		Registry<Registered<Shared_buffer>> _shared_buffers { };
+
+		Shared_buffer *_alloc_shared_buffer(size_t size, long number)
+		{
+			if (!_zero_copy)
+				return nullptr;
+
+			try {
+				Registered<Shared_buffer> &buffer = *new (_heap)
+					Registered<Shared_buffer>(_shared_buffers, _env, _block,
+					                          size, number);
+
+				/* kernels like base-linux lack support for managed dataspaces */
+				if (buffer.ds().valid())
+					return &buffer;
+
+				destroy(_heap, &buffer);
+				warning("managed dataspace unavailable, falling back to "
+				        "copying the payload of partition ", number);
+			}
+			catch (Block_connection::Tx::Source::Packet_alloc_failed) {
+				warning("I/O buffer exhausted, falling back to copying the "
+				        "payload of partition ", number); }
+
+			return nullptr;
+		}
+
+		/**
+		 * Release buffers of closed sessions once no job refers to them
+		 */
+		void _release_retired_shared_buffers()
+		{
+			_shared_buffers.for_each([&] (Registered<Shared_buffer> &buffer) {
+
+				if (!buffer.retired)
+					return;
+
+				bool in_use = false;
+				_job_registry.for_each([&] (Job &job) {
+					in_use |= !job.completed && buffer.contains(job.payload); });
+
+				if (!in_use)
+					destroy(_heap, &buffer);
+			});
+		}
+
 		unsigned _wake_up_index { 0 };
 
 		void _wakeup_clients()
@@ -274,6 +486,7 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		{
 			update();
 			acknowledge_completed();
+			_release_retired_shared_buffers();
 			_wakeup_clients();
 		}
 
@@ -291,6 +504,9 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 		{
 			_block.sigh(_io_sigh);
 
+			log("queue depth: ", _job_queue.num_items(), " "
+			    "zero copy: ", _zero_copy ? "yes" : "no");
+
 			/* announce at parent */
 			env.parent().announce(env.ep().manage(*this));
 		}
@@ -358,15 +574,21 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				throw Insufficient_ram_quota();
 			}
 
+			Shared_buffer * const shared = _alloc_shared_buffer(tx_buf_size, num);
+
+			/*
+			 * Forwarded payloads must satisfy the alignment constraints of
+			 * the back end. The shared buffer is page-aligned.
+			 */
 			Session::Info info {
 				.block_size  = _block.info().block_size,
 				.block_count = _partition_table.partition(num).sectors,
-				.align_log2  = 0,
+				.align_log2  = shared ? _block.info().align_log2 : 0,
 				.writeable   = writeable,
 			};
 
 			_sessions[num] = new (_heap) Session_component(_env, num, tx_buf_size,
-			                                               info, *this);
+			                                               info, *this, shared);
 			return _sessions[num]->cap();
 		}
 
@@ -376,9 +598,17 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				if (!_sessions[number] || !(cap == _sessions[number]->cap()))
 					continue;
 
+				Shared_buffer * const shared = _sessions[number]->shared();
+
 				destroy(_heap, _sessions[number]);
 				_sessions[number] = nullptr;
 
+				/* jobs in flight may still access the shared buffer */
+				if (shared) {
+					shared->retired = true;
+					_release_retired_shared_buffers();
+				}
+
 				break;
 			}
 		}
@@ -415,7 +645,8 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 
 		void update() override { _block.update_jobs(*this); }
 
-		Response submit(long number, Request const &request, addr_t addr) override
+		Response submit(long number, Request const &request,
+		                addr_t addr, size_t size) override
 		{
 			Partition &partition = _partition_table.partition(number);
 			block_number_t last  = request.operation.block_number + request.operation.count;
@@ -428,12 +659,19 @@ class Block::Main : Rpc_object<Typed_root<Session>>,
 				index  = _job_queue.alloc();
 			} catch (...) { return Response::RETRY; }
 
+			Shared_buffer * const shared = _sessions[number]->shared();
+
 			_job_queue.with_job(index, [&](Job_object &job) {
 
 				Operation op     = request.operation;
 				op.block_number += partition.lba;
 
-				job.construct(_block, op, _job_registry, index, number, request, addr);
+				if (shared)
+					job.construct(_block, op, _job_registry, index, number,
+					              request, shared->payload(request, size));
+				else
+					job.construct(_block, op, _job_registry, index, number,
+					              request, addr);
 			});
 
 			return Response::ACCEPTED;
@@ -50,6 +50,9 @@ struct Block::Job : public Block_connection::Job
 	addr_t  const addr;                 /* target payload address */
 	bool          completed { false };
 
+	/* payload within the back-end I/O buffer, used in zero-copy mode */
+	Block_connection::Payload const payload { };
+
 	Job(Block_connection &connection,
 	    Operation         operation,
 	    Registry<Job>    &registry,
@@ -60,6 +63,21 @@ struct Block::Job : public Block_connection::Job
 	: Block_connection::Job(connection, operation),
 	  registry_element(registry, *this),
 	  index(index), number(number), request(request), addr(addr) { }
+
+	/**
+	 * Constructor for a job operating directly on the back-end I/O buffer
+	 */
+	Job(Block_connection          &connection,
+	    Operation                  operation,
+	    Registry<Job>             &registry,
+	    addr_t const               index,
+	    addr_t const               number,
+	    Request                    request,
+	    Block_connection::Payload  payload)
+	: Block_connection::Job(connection, operation, payload),
+	  registry_element(registry, *this),
+	  index(index), number(number), request(request), addr(0),
+	  payload(payload) { }
 };
 
 
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2014-2017 Genode Labs GmbH
+ * Copyright (C) 2014-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -31,15 +31,28 @@ struct Report_rom::Main
 	Genode::Env &env;
 
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
+	Genode::Heap        heap        { env.ram(), env.rm() };
 
-	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
+	Rom::Registry rom_registry { heap, env.ram(), env.rm(), config_rom };
 
 	Genode::Attached_rom_dataspace config_rom { env, "config" };
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	Genode::Constructible<Rom::Snapshot_views> snapshot_views { };
+
+	Rom::Snapshot_views *_init_snapshot_views()
+	{
+		if (!config_rom.xml().attribute_value("zero_copy", false))
+			return nullptr;
+
+		snapshot_views.construct(env);
+		return &*snapshot_views;
+	}
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
-	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
+	Rom   ::Root    rom_root { env, sliced_heap, rom_registry,
+	                           _init_snapshot_views() };
 
 	Main(Genode::Env &env) : env(env)
 	{
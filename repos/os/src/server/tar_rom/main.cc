@@ -6,7 +6,7 @@
  */
 
 /*
- * Copyright (C) 2010-2017 Genode Labs GmbH
+ * Copyright (C) 2010-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -19,10 +19,13 @@
 #include <base/log.h>
 #include <base/session_label.h>
 #include <root/component.h>
+#include <os/path_index.h>
 
 namespace Tar_rom {
 
 	using namespace Genode;
+	struct Archive_entry;
+	class Archive_index;
 	class Rom_session_component;
 	class Rom_root;
 	struct Main;
@@ -30,80 +33,87 @@ namespace Tar_rom {
 
 
 /**
- * A 'Rom_session_component' exports a single file of the tar archive
+ * File within the tar archive
  */
-class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
+struct Tar_rom::Archive_entry : Path_index<Archive_entry>::Element
 {
-	private:
+	char const * const content;
+	size_t       const size;
+
+	Archive_entry(char const *name, size_t name_len,
+	              char const *content, size_t size)
+	:
+		Path_index<Archive_entry>::Element(name, name_len),
+		content(content), size(size)
+	{ }
+};
 
-		/*
-		 * Noncopyable
-		 */
-		Rom_session_component(Rom_session_component const &);
-		Rom_session_component &operator = (Rom_session_component const &);
 
-		Ram_allocator &_ram;
+/**
+ * Index of the files of a tar archive by their name
+ *
+ * The index is built once at startup so that each session request is
+ * served without scanning the archive.
+ */
+class Tar_rom::Archive_index
+{
+	private:
 
-		char const * const _tar_addr;
-		size_t       const _tar_size;
+		Allocator &_alloc;
 
-		Ram_dataspace_capability _file_ds;
+		Path_index<Archive_entry> _index { _alloc };
 
 		enum {
 			/* length of on data block in tar */
 			_BLOCK_LEN = 512,
 
+			/* length of the header field "file-name" in tar */
+			_FIELD_NAME_LEN = 100,
+
 			/* length of the header field "file-size" in tar */
 			_FIELD_SIZE_LEN = 124
 		};
 
-		/**
-		 * Copy file content into dataspace
-		 *
-		 * \param dst  destination dataspace
+		/*
+		 * Noncopyable
 		 */
-		void _copy_content_to_dataspace(Region_map &rm, Dataspace_capability dst,
-		                                char const *src, size_t len)
-		{
-			/* temporarily map dataspace */
-			Attached_dataspace ds(rm, dst);
+		Archive_index(Archive_index const &);
+		Archive_index &operator = (Archive_index const &);
 
-			/* copy content */
-			size_t bytes_to_copy = min(len, ds.size());
-			memcpy(ds.local_addr<char>(), src, bytes_to_copy);
-		}
+	public:
 
-		/**
-		 * Initialize dataspace containing the content of the archived file
-		 */
-		Ram_dataspace_capability _init_file_ds(Ram_allocator &ram, Region_map &rm,
-		                                       Session_label const &name)
+		Archive_index(Allocator &alloc, char const *tar_addr, size_t tar_size)
+		:
+			_alloc(alloc)
 		{
 			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
-
-			char   const *file_content = nullptr;
-			unsigned long file_size    = 0;
+			size_t block_id = 0, block_cnt = tar_size/_BLOCK_LEN;
 
 			/* scan metablocks of archive */
 			while (block_id < block_cnt) {
 
-				ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
+				unsigned long file_size = 0;
+				ascii_to_unsigned(tar_addr + block_id*_BLOCK_LEN +
 				                  _FIELD_SIZE_LEN, file_size, 8);
 
 				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
+				char const *record_filename = tar_addr + block_id*_BLOCK_LEN;
+				size_t      name_len        = 0;
+				for (; name_len < _FIELD_NAME_LEN && record_filename[name_len]; name_len++);
 
 				/* skip leading dot of path if present */
-				if (record_filename[0] == '.' && record_filename[1] == '/')
+				if (record_filename[0] == '.' && record_filename[1] == '/') {
 					record_filename++;
-
-				/* get infos about current file */
-				if (name == record_filename) {
-					file_content = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					break;
+					name_len--;
 				}
 
+				/* the first record of a name takes precedence */
+				if (!_index.lookup(record_filename, name_len))
+					_index.insert(*new (_alloc)
+						Archive_entry(record_filename, name_len,
+						              tar_addr + (block_id+1)*_BLOCK_LEN,
+						              file_size));
+
 				/* some datablocks */       /* one metablock */
 				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
 
@@ -111,16 +121,66 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 				if (file_size % _BLOCK_LEN != 0) block_id++;
 
 				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
+				if (block_id*_BLOCK_LEN >= tar_size)
 					break;
 
 				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
+				if (*(tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
+					if (*(tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
 						break;
 			}
+		}
 
-			if (!file_content) {
+		Archive_entry const *lookup(Session_label const &name) const {
+			return _index.lookup(name.string()); }
+
+		size_t count() const { return _index.count(); }
+};
+
+
+/**
+ * A 'Rom_session_component' exports a single file of the tar archive
+ */
+class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Rom_session_component(Rom_session_component const &);
+		Rom_session_component &operator = (Rom_session_component const &);
+
+		Ram_allocator &_ram;
+
+		Ram_dataspace_capability _file_ds;
+
+		/**
+		 * Copy file content into dataspace
+		 *
+		 * \param dst  destination dataspace
+		 */
+		void _copy_content_to_dataspace(Region_map &rm, Dataspace_capability dst,
+		                                char const *src, size_t len)
+		{
+			/* temporarily map dataspace */
+			Attached_dataspace ds(rm, dst);
+
+			/* copy content */
+			size_t bytes_to_copy = min(len, ds.size());
+			memcpy(ds.local_addr<char>(), src, bytes_to_copy);
+		}
+
+		/**
+		 * Initialize dataspace containing the content of the archived file
+		 */
+		Ram_dataspace_capability _init_file_ds(Ram_allocator &ram, Region_map &rm,
+		                                       Archive_index const &index,
+		                                       Session_label const &name)
+		{
+			Archive_entry const *entry = index.lookup(name);
+
+			if (!entry) {
 				error("couldn't find file '", name, "', empty result");
 				return Ram_dataspace_capability();
 			}
@@ -128,10 +188,10 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 			/* try to allocate memory for file */
 			Ram_dataspace_capability file_ds;
 			try {
-				file_ds = ram.alloc(file_size);
+				file_ds = ram.alloc(entry->size);
 
 				/* get content of file copied into dataspace and return */
-				_copy_content_to_dataspace(rm, file_ds, file_content, file_size);
+				_copy_content_to_dataspace(rm, file_ds, entry->content, entry->size);
 			} catch (...) {
 				error("couldn't allocate memory for file, empty result");
 				return file_ds;
@@ -143,20 +203,18 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
-		 * \param  label     name of the requested ROM module
+		 * \param  index  index of the files within the tar archive
+		 * \param  label  name of the requested ROM module
 		 *
 		 * \throw Service_denied
 		 */
 		Rom_session_component(Ram_allocator &ram, Region_map &rm,
-		                      char const *tar_addr, unsigned tar_size,
+		                      Archive_index const &index,
 		                      Session_label const &label)
 		:
-			_ram(ram), _tar_addr(tar_addr), _tar_size(tar_size),
-			_file_ds(_init_file_ds(ram, rm, label))
+			_ram(ram), _file_ds(_init_file_ds(ram, rm, index, label))
 		{
 			if (!_file_ds.valid())
 				throw Service_denied();
@@ -192,8 +250,7 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 
 		Env &_env;
 
-		char const * const _tar_addr;
-		unsigned     const _tar_size;
+		Archive_index const &_index;
 
 		Rom_session_component *_create_session(const char *args) override
 		{
@@ -203,7 +260,7 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 
 			/* create new session for the requested file */
 			return new (md_alloc()) Rom_session_component(_env.ram(), _env.rm(),
-			                                              _tar_addr, _tar_size,
+			                                              _index,
 			                                              module_name.string());
 		}
 
@@ -212,14 +269,12 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 		/**
 		 * Constructor
 		 *
-		 * \param tar_base  local address of tar archive
-		 * \param tar_size  size of tar archive in bytes
+		 * \param index  index of the files within the tar archive
 		 */
-		Rom_root(Env &env, Allocator &md_alloc,
-		         char const *tar_addr, size_t tar_size)
+		Rom_root(Env &env, Allocator &md_alloc, Archive_index const &index)
 		:
 			Root_component<Rom_session_component>(env.ep(), md_alloc),
-			_env(env), _tar_addr(tar_addr), _tar_size(tar_size)
+			_env(env), _index(index)
 		{ }
 };
 
@@ -249,11 +304,16 @@ struct Tar_rom::Main
 
 	Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-	Rom_root _root { _env, _sliced_heap, _tar_ds.local_addr<char>(), _tar_ds.size() };
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Archive_index _index { _heap, _tar_ds.local_addr<char>(), _tar_ds.size() };
+
+	Rom_root _root { _env, _sliced_heap, _index };
 
 	Main(Env &env) : _env(env)
 	{
-		log("using tar archive '", _tar_name(), "' with size ", _tar_ds.size());
+		log("using tar archive '", _tar_name(), "' with size ", _tar_ds.size(),
+		    ", ", _index.count(), " files");
 
 		env.parent().announce(env.ep().manage(_root));
 	}
@@ -0,0 +1,204 @@
+/*
+ * \brief  Test of the data integrity of the block cache
+ * \author agent
+ * \date   2026-10-18
+ *
+ * The test writes and reads back distinct patterns in a sequence of
+ * requests that exercises corner cases of the cache, in particular writes
+ * to a range that overlaps clean cached blocks while most of the cache is
+ * dirty. The sequence assumes a cache of 128 blocks that does not write
+ * back blocks by itself.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Step;
+	struct Job;
+	struct Main;
+
+	typedef Block::Connection<Job> Block_connection;
+	typedef Block::Operation::Type Type;
+}
+
+
+struct Test::Step
+{
+	Type                  type;
+	Block::block_number_t lba;
+	Block::block_count_t  count;
+	unsigned              generation;  /* of written or expected content */
+};
+
+
+struct Test::Job : Block_connection::Job
+{
+	Step const &step;
+
+	Job(Block_connection &connection, Step const &step)
+	:
+		Block_connection::Job(connection, { .type         = step.type,
+		                                    .block_number = step.lba,
+		                                    .count        = step.count }),
+		step(step)
+	{ }
+};
+
+
+struct Test::Main
+{
+	enum { CACHE_BLOCKS = 128 };
+
+	/*
+	 * Fill most of the cache with dirty blocks, fill the remainder with
+	 * clean blocks, and write a range that overlaps the clean blocks with
+	 * as many missing blocks as entries are available.
+	 */
+	static constexpr Step _steps[] = {
+		{ Type::WRITE,    0, 32, 1 },
+		{ Type::WRITE,   32, 32, 1 },
+		{ Type::WRITE,   64, 32, 1 },
+		{ Type::WRITE,   96,  4, 1 },
+		{ Type::READ,  1000, 24, 0 },
+		{ Type::WRITE, 1008, 32, 2 },
+		{ Type::READ,  1000, 24, 2 },
+		{ Type::READ,  1024, 16, 2 },
+		{ Type::READ,     0, 32, 1 },
+		{ Type::READ,    32, 32, 1 },
+		{ Type::READ,    64, 32, 1 },
+		{ Type::READ,    96,  4, 1 },
+		{ Type::SYNC,     0,  0, 0 },
+	};
+
+	Env &_env;
+
+	Heap          _heap        { _env.ram(), _env.rm() };
+	Allocator_avl _block_alloc { &_heap };
+
+	Block_connection _block { _env, &_block_alloc, 128*1024 };
+
+	size_t const _block_size = _block.info().block_size;
+
+	Io_signal_handler<Main> _handler { _env.ep(), *this, &Main::_handle };
+
+	unsigned _step  = 0;
+	bool     _error = false;
+
+	/**
+	 * Return expected content of a word of block 'lba'
+	 *
+	 * The blocks of generation 0 were never written, i.e., they hold zeros
+	 * and, in the case of the blocks written in generation 2, are overlaid
+	 * by the newer content.
+	 */
+	static uint32_t _pattern(Block::block_number_t lba, unsigned generation)
+	{
+		if (!generation)
+			return 0;
+
+		return (uint32_t)(generation << 24) ^ (uint32_t)lba;
+	}
+
+	unsigned _expected_generation(Step const &step, Block::block_number_t lba) const
+	{
+		/* the third write covers blocks 1008..1039 */
+		if (step.generation == 2 && (lba < 1008 || lba >= 1040))
+			return 0;
+
+		return step.generation;
+	}
+
+	void _submit_next_step()
+	{
+		if (_step == sizeof(_steps)/sizeof(_steps[0])) {
+			log("--- block cache test finished ---");
+			_env.parent().exit(0);
+			return;
+		}
+
+		new (_heap) Job(_block, _steps[_step++]);
+		_handle();
+	}
+
+	void _handle() { _block.update_jobs(*this); }
+
+
+	/************************
+	 ** Update_jobs_policy **
+	 ************************/
+
+	void produce_write_content(Job &job, off_t offset, char *dst, size_t length)
+	{
+		Block::block_number_t const first = job.step.lba + offset/_block_size;
+
+		for (size_t i = 0; i < length/sizeof(uint32_t); i++)
+			((uint32_t *)dst)[i] = _pattern(first + (i*sizeof(uint32_t))/_block_size,
+			                                job.step.generation);
+	}
+
+	void consume_read_result(Job &job, off_t offset, char const *src, size_t length)
+	{
+		Block::block_number_t const first = job.step.lba + offset/_block_size;
+
+		for (size_t i = 0; i < length/sizeof(uint32_t); i++) {
+
+			Block::block_number_t const lba = first + (i*sizeof(uint32_t))/_block_size;
+
+			uint32_t const expected = _pattern(lba, _expected_generation(job.step, lba));
+			uint32_t const value    = ((uint32_t const *)src)[i];
+
+			if (value == expected)
+				continue;
+
+			error("block ", lba, " holds ", Hex(value), ", expected ", Hex(expected));
+			_error = true;
+			return;
+		}
+	}
+
+	void completed(Job &job, bool success)
+	{
+		Block::Operation const op = job.operation();
+
+		destroy(_heap, &job);
+
+		if (!success || _error) {
+			error(op, " failed");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		_submit_next_step();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_block.sigh(_handler);
+
+		if (_block.info().block_count < 1040) {
+			error("block device too small");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		_submit_next_step();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -135,12 +135,92 @@ struct Unaligned_blit_test : Test
 	}
 };
 
+struct Kernel_test : Test
+{
+	static constexpr char const *brief = "blitting and blending kernels from RAM to FB";
+
+	enum { KERNEL_DURATION_MS = DURATION_MS / 2 };
+
+	unsigned const w = fb_mode.area.w();
+	unsigned const h = fb_mode.area.h();
+
+	template <typename FN>
+	void measure(char const *kernel, FN const &fn)
+	{
+		size_t         kib      = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		for (unsigned i = 0; timer.elapsed_ms() - start_ms < KERNEL_DURATION_MS; i++)
+			kib += fn(i) / 1024;
+
+		log(kernel, " throughput: ",
+		    kib / (timer.elapsed_ms() - start_ms), " MiB/sec");
+	}
+
+	void measure_kernels()
+	{
+		char          *fb    = fb_ds.local_addr<char>();
+		unsigned char *alpha = (unsigned char *)buf[0];
+
+		measure("blit              ", [&] (unsigned i) {
+			blit(buf[i % 2], 4*w, fb, 4*w, 4*w, h);
+			return 4*w*h; });
+
+		measure("blend_rgb888      ", [&] (unsigned) {
+			for (unsigned y = 0; y < h; y++)
+				blend_rgb888(fb + 4*w*y, buf[1] + 4*w*y, alpha + w*y, w);
+			return 4*w*h; });
+
+		measure("blend_rgb888_color", [&] (unsigned i) {
+			for (unsigned y = 0; y < h; y++)
+				blend_rgb888_color(fb + 4*w*y, 0x336699, (int)(i % 256), w);
+			return 4*w*h; });
+
+		measure("rgb565_to_rgb888  ", [&] (unsigned) {
+			convert_rgb565_to_rgb888(fb, buf[1], w*h);
+			return 4*w*h; });
+
+		measure("rgb888_to_rgb565  ", [&] (unsigned) {
+			convert_rgb888_to_rgb565(fb, buf[1], w*h);
+			return 2*w*h; });
+	}
+
+	Kernel_test(Env &env, int id) : Test(env, id, brief)
+	{
+		if (fb_mode.bytes_per_pixel() != 4) {
+			warning("skipping test, framebuffer is not in RGB888 format");
+			return;
+		}
+
+		/* alpha values covering transparent, opaque, and translucent pixels */
+		for (size_t i = 0; i < w*h; i++)
+			buf[0][i] = (char)(i*7);
+
+		struct { Blit_isa isa; char const *name; } const variants[] = {
+			{ BLIT_ISA_GENERIC, "generic" }, { BLIT_ISA_SSE2, "SSE2" },
+			{ BLIT_ISA_AVX2,    "AVX2"    }, { BLIT_ISA_NEON, "NEON" } };
+
+		Blit_isa const selected_isa = blit_isa();
+
+		for (auto const &variant : variants) {
+			if (!blit_select_isa(variant.isa))
+				continue;
+
+			log("kernels: ", variant.name,
+			    variant.isa == selected_isa ? " (default)" : "");
+			measure_kernels();
+		}
+
+		blit_select_isa(selected_isa);
+	}
+};
+
 struct Main
 {
 	Constructible<Bytewise_ram_test>   test_1 { };
 	Constructible<Bytewise_fb_test>    test_2 { };
 	Constructible<Blit_test>           test_3 { };
 	Constructible<Unaligned_blit_test> test_4 { };
+	Constructible<Kernel_test>         test_5 { };
 
 	Main(Env &env)
 	{
@@ -149,6 +229,7 @@ struct Main
 		test_2.construct(env, 2); test_2.destruct();
 		test_3.construct(env, 3); test_3.destruct();
 		test_4.construct(env, 4); test_4.destruct();
+		test_5.construct(env, 5); test_5.destruct();
 		log("--- Framebuffer benchmark finished ---");
 	}
 };
@@ -0,0 +1,165 @@
+/*
+ * \brief  Test and benchmark of the internet-checksum functions
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <net/internet_checksum.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+using namespace Net;
+
+
+/**
+ * Straight-forward implementation according to RFC 1071 used as reference
+ */
+static uint16_t reference_checksum(uint8_t const *data, size_t size)
+{
+	uint64_t sum = 0;
+	for (; size > 1; size -= 2, data += 2)
+		sum += (uint16_t)(data[0] | data[1] << 8);
+
+	if (size)
+		sum += data[0];
+
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+
+struct Main
+{
+	enum { BUF_SIZE = 64*1024, DURATION_US = 500*1000 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _src_ds { _env.ram(), _env.rm(), BUF_SIZE };
+	Attached_ram_dataspace _dst_ds { _env.ram(), _env.rm(), BUF_SIZE };
+
+	uint8_t *_src() { return _src_ds.local_addr<uint8_t>(); }
+	uint8_t *_dst() { return _dst_ds.local_addr<uint8_t>(); }
+
+	void _fill(uint8_t value)
+	{
+		for (size_t i = 0; i < BUF_SIZE; i++)
+			_src()[i] = value;
+	}
+
+	void _fill_pseudo_random()
+	{
+		uint32_t state = 0x1234567;
+		for (size_t i = 0; i < BUF_SIZE; i++) {
+			state = state*1103515245 + 12345;
+			_src()[i] = (uint8_t)(state >> 16);
+		}
+	}
+
+	/**
+	 * Compare results with the reference for all sizes and alignments
+	 */
+	bool _check(char const *pattern)
+	{
+		for (size_t size = 0; size < 2048; size++) {
+			for (size_t offset = 0; offset < 8; offset++) {
+
+				uint8_t const * const data = _src() + offset;
+				uint16_t const expected = reference_checksum(data, size);
+
+				uint16_t const checksum =
+					internet_checksum((Packed_uint16 const *)data, size);
+
+				uint16_t const copy_checksum =
+					copy_and_checksum(_dst() + 1, (Packed_uint16 const *)data, size);
+
+				if (checksum != expected || copy_checksum != expected
+				 || memcmp(_dst() + 1, data, size) != 0) {
+					error("checksum mismatch for ", pattern, " data,"
+					      " size=", size, " offset=", offset);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	template <typename FN>
+	void _measure(char const *name, size_t size, FN const &fn)
+	{
+		uint64_t       bytes = 0;
+		uint16_t       sum   = 0;
+		uint64_t const start = _timer.elapsed_us();
+		uint64_t       now   = start;
+
+		/* amortize timer requests over many iterations */
+		for (; now - start < DURATION_US; now = _timer.elapsed_us()) {
+			for (unsigned i = 0; i < 1024; i++)
+				sum = (uint16_t)(sum + fn(size));
+			bytes += 1024*size;
+		}
+
+		uint64_t const mbit_per_s = (bytes*8)/(now - start);
+
+		log(name, " size=", size, ": ",
+		    mbit_per_s/1000, ".", (mbit_per_s % 1000)/100, " Gbit/s",
+		    " (sum ", Hex(sum), ")");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_fill(0);
+		bool ok = _check("zero");
+
+		_fill(0xff);
+		ok = ok && _check("0xff");
+
+		_fill_pseudo_random();
+		ok = ok && _check("random");
+
+		if (!ok) {
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("checksums match reference");
+
+		size_t const sizes[] = { 64, 576, 1500, 9000, 65535 };
+
+		for (size_t size : sizes) {
+
+			_measure("reference        ", size, [&] (size_t n) {
+				return reference_checksum(_src(), n); });
+
+			_measure("internet_checksum", size, [&] (size_t n) {
+				return internet_checksum((Packed_uint16 const *)_src(), n); });
+
+			_measure("memcpy+checksum  ", size, [&] (size_t n) {
+				memcpy(_dst(), _src(), n);
+				return internet_checksum((Packed_uint16 const *)_dst(), n); });
+
+			_measure("copy_and_checksum", size, [&] (size_t n) {
+				return copy_and_checksum(_dst(), (Packed_uint16 const *)_src(), n); });
+		}
+
+		log("--- internet-checksum benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
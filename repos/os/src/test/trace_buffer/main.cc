@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2022 Genode Labs GmbH
+ * Copyright (C) 2022-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -348,10 +348,106 @@ class Test_tracing
 };
 
 
+/**
+ * Fill level reported by 'Trace_buffer::pending_bytes'
+ *
+ * Entries are produced and consumed by the same thread so that the
+ * expected fill level is known exactly at each step.
+ */
+class Test_fill_level
+{
+	private:
+
+		enum { ENTRY_SIZE = sizeof(size_t) + sizeof(Generator1::Entry) };
+
+		Attached_ram_dataspace  _buffer_ds;
+		Trace::Buffer          &_buffer { *_buffer_ds.local_addr<Trace::Buffer>() };
+		Trace_buffer            _reader { _buffer };
+		Generator1              _generator { };
+
+		void _produce(unsigned count)
+		{
+			for (; count; count--) {
+				char *dst = _buffer.reserve(_generator.max_len());
+				_buffer.commit(_generator.generate(dst));
+			}
+		}
+
+		unsigned _drain()
+		{
+			unsigned count = 0;
+			_reader.for_each_new_entry([&] (Trace::Buffer::Entry const &) {
+				count++;
+				return true; });
+
+			return count;
+		}
+
+		void _expect(char const *step, size_t expected)
+		{
+			size_t const pending = _reader.pending_bytes();
+			if (pending == expected)
+				return;
+
+			error("Inconsistent fill level ", step, ", expected: ", expected,
+			      ", pending: ", pending);
+			throw Fill_level();
+		}
+
+	public:
+
+		struct Fill_level : Genode::Exception { };
+
+		Test_fill_level(Env &env, size_t buffer_sz)
+		: _buffer_ds(env.ram(), env.rm(), buffer_sz)
+		{
+			_buffer.init(buffer_sz);
+
+			log("running fill level test");
+
+			_expect("of empty buffer", 0);
+
+			_produce(5);
+			_expect("after producing", 5*ENTRY_SIZE);
+
+			if (_drain() != 5) {
+				error("Unexpected number of entries in buffer");
+				throw Fill_level();
+			}
+			_expect("after draining", 0);
+
+			/* let the producer fill the remainder of both partitions */
+			unsigned const count = (unsigned)(_buffer.capacity() / ENTRY_SIZE) - 5;
+			_produce(count);
+			_expect("up to the end of the buffer", count*ENTRY_SIZE);
+			_drain();
+
+			/* continue at the start of the buffer */
+			_produce(3);
+			if (!_buffer.wrapped()) {
+				error("Buffer did not wrap");
+				throw Fill_level();
+			}
+			_expect("across a wrap", 3*ENTRY_SIZE);
+			_drain();
+			_expect("after draining a wrapped buffer", 0);
+
+			/* the fill level is limited to the capacity if entries were lost */
+			_produce(3*count);
+			_expect("after overwriting entries", _buffer.capacity());
+			_drain();
+			_expect("after draining an overwritten buffer", 0);
+
+			log("fill level test succeeded\n");
+		}
+};
+
+
 struct Main
 {
 	Constructible<Test_tracing<Generator1>> test_1 { };
 	Constructible<Test_tracing<Generator2>> test_2 { };
+	Constructible<Test_fill_level>          test_3 { };
 
 	Main(Env &env)
 	{
@@ -371,6 +467,10 @@ struct Main
 		test_2.construct(env, BUFFER_SIZE, 10000, 0);
 		test_2.destruct();
 
+		/* fill level with a consumer that keeps pace with the producer */
+		test_3.construct(env, BUFFER_SIZE);
+		test_3.destruct();
+
 		env.parent().exit(0);
 	}
 };
@@ -5,7 +5,7 @@
  */
 
 /*
- * Copyright (C) 2015-2017 Genode Labs GmbH
+ * Copyright (C) 2015-2023 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -40,6 +40,7 @@
 #include <base/component.h>
 #include <base/log.h>
 #include <base/exception.h>
+#include <util/list.h>
 
 using namespace Genode;
 
@@ -513,6 +514,88 @@ struct Unlink_test : public Stress_test
 	}
 };
 
+/**
+ * Micro-benchmark of path lookups within the static mount tree
+ *
+ * Each round looks up each node declared in the '<vfs>' configuration and
+ * a non-existing node within each declared directory.
+ */
+struct Lookup_test
+{
+	struct Lookup_path : List<Lookup_path>::Element
+	{
+		::Path const path;
+
+		Lookup_path(::Path const &path) : path(path) { }
+	};
+
+	Vfs::File_system  &vfs;
+	Genode::Allocator &alloc;
+
+	List<Lookup_path> paths { };
+
+	Vfs::file_size count  = 0;
+	Vfs::file_size misses = 0;
+
+	void _add(::Path const &path)
+	{
+		paths.insert(new (alloc) Lookup_path(path));
+	}
+
+	void _collect(Xml_node node, ::Path const &path)
+	{
+		typedef String<Vfs::MAX_PATH_LEN> Name;
+
+		::Path missing(path);
+		missing.append_element("nonexistent");
+		_add(missing);
+
+		node.for_each_sub_node([&] (Xml_node const &sub_node) {
+
+			if (!sub_node.has_attribute("name"))
+				return;
+
+			::Path sub_path(path);
+			sub_path.append_element(sub_node.attribute_value("name", Name()).string());
+			_add(sub_path);
+
+			if (sub_node.has_type("dir"))
+				_collect(sub_node, sub_path);
+		});
+	}
+
+	Lookup_test(Vfs::File_system &vfs, Genode::Allocator &alloc,
+	            Xml_node vfs_config, unsigned rounds)
+	:
+		vfs(vfs), alloc(alloc)
+	{
+		_collect(vfs_config, ::Path("/"));
+
+		for (unsigned i = 0; i < rounds; i++) {
+			for (Lookup_path *p = paths.first(); p; p = p->next()) {
+				Vfs::Directory_service::Stat stat { };
+				if (vfs.stat(p->path.base(), stat) != Vfs::Directory_service::STAT_OK)
+					++misses;
+				++count;
+			}
+		}
+	}
+
+	~Lookup_test()
+	{
+		while (Lookup_path *p = paths.first()) {
+			paths.remove(p);
+			destroy(alloc, p);
+		}
+	}
+
+	Vfs::file_size wait()
+	{
+		return count;
+	}
+};
+
+
 void die(Genode::Env &env, int code) { env.parent().exit(code); }
 
 void Component::construct(Genode::Env &env)
@@ -553,6 +636,24 @@ void Component::construct(Genode::Env &env)
 
 	size_t initial_consumption = env.pd().used_ram().value;
 
+	/******************
+	 ** Lookup paths **
+	 ******************/
+
+	if (unsigned const rounds = config_xml.attribute_value("lookups", 0U)) {
+		log("looking up paths...");
+		uint64_t elapsed_us = timer.elapsed_us();
+
+		Lookup_test test(vfs_root, heap, config_xml.sub_node("vfs"), rounds);
+		Vfs::file_size const count = test.wait();
+
+		elapsed_us = timer.elapsed_us() - elapsed_us;
+
+		if (count > 0)
+			log("looked up ",count," paths (",test.misses," misses), ",
+			    (elapsed_us*1000)/count,"ns/op");
+	}
+
 	/**************************
 	 ** Generate directories **
 	 **************************/